@@ -13,6 +13,45 @@
 /*Definition of Macros & other variables*/
 #include "define.h"
 #include <filesystem>
+#include <limits.h>
+/*Fixed-point GaussianBlur for the CPU fallback*/
+#include "gaussian_fixed.h"
+/*Batched small-image mode*/
+#include "oca_batch.h"
+/*Shared-memory frame ring*/
+#include "oca_frame_ring.h"
+/*Accelerator-arbitration server client*/
+#include "oca_server.h"
+/*Simulated OCA backend hooks*/
+#include "oca_sim.h"
+/*Machine-readable results*/
+#include "oca_report.h"
+/*Performance counters*/
+#include "oca_perf.h"
+/*Timeline tracing*/
+#include "oca_trace.h"
+/*Measurement conditions*/
+#include "oca_stable.h"
+/*Memory bandwidth reference*/
+#include "oca_roofline.h"
+/*Startup profiler*/
+#include "oca_coldstart.h"
+/*Deadline-paced mode*/
+#include "oca_paced.h"
+/*Parameter sweep*/
+#include "oca_sweep.h"
+/*Dirty-region incremental mode*/
+#include "oca_incremental.h"
+/*Planar layout path*/
+#include "oca_planar.h"
+/*Input corpus benchmark*/
+#include "oca_corpus.h"
+/*Case descriptor table*/
+#include "oca_op_table.h"
+/*Buffer reuse mode*/
+#include "oca_reuse.h"
+/*Energy per frame*/
+#include "oca_energy.h"
 /*OpenCV*/
 #include <opencv2/opencv.hpp>
 
@@ -25,50 +64,11 @@
 #define C_DELAY         (0)
 
 static uint8_t out_data[SRC_WIDTH * SRC_HEIGHT * 4];
-static int src_size;
-static int dst_size;
+static_assert(oca_case_max_out_bytes() <= sizeof(out_data), "out_data is smaller than a case output");
 
 /* for suppress optimization */
 volatile int oca_s;
 
-/* for time count */
-struct timespec start_time;
-struct timespec end_time;
-
-/* OpenCVA Circuit Number */
-#define DRP_FUNC_NUM            (16)
-#define DRP_FUNC_RESIZE         (0)
-#define DRP_FUNC_CVT_YUV2BGR    (2)
-#define DRP_FUNC_CVT_NV2BGR     (2)
-#define DRP_FUNC_GAUSSIAN       (4)
-#define DRP_FUNC_DILATE         (5)
-#define DRP_FUNC_ERODE          (6)
-#define DRP_FUNC_FILTER2D       (7)
-#define DRP_FUNC_SOBEL          (8)
-#define DRP_FUNC_A_THRESHOLD    (9)
-#define DRP_FUNC_TMPLEATMATCH   (10)
-#define DRP_FUNC_AFFINE         (11)
-#define DRP_FUNC_PYR_DOWN       (12)
-#define DRP_FUNC_PYR_UP         (13)
-#define DRP_FUNC_PERSPECTIVE    (14)
-
-/* OpenCVA Activate */
-#define OPENCVA_FUNC_DISABLE    (0)
-#define OPENCVA_FUNC_ENABLE     (1)
-#define OPENCVA_FUNC_NOCHANGE   (2)
-
-
-/*****************************************
-* Function Name : timedifference_msec
-* Description   : compute the time diffences in ms between two moments
-* Arguments     : t0 = start time
-*                 t1 = stop time
-* Return value  : the time diffence in ms
-******************************************/
-double timedifference_msec(struct timespec t0, struct timespec t1) {
-	return ((t1.tv_sec - t0.tv_sec) * 1E3 + (t1.tv_nsec - t0.tv_nsec) / 1E6);
-}
-
 static void saveMatNPY(const cv::Mat &mat, const std::string &filename) {
 	std::ofstream file(filename, std::ios::binary);
 	if (!file.is_open()) {
@@ -86,15 +86,75 @@ static void saveMatNPY(const cv::Mat &mat, const std::string &filename) {
 	file.close();
 }
 
+/*****************************************
+* Function Name : sample_finish
+* Description   : stop the energy sampler and write the trace; every exit after start-up goes through here
+* Arguments     : results = results directory
+*                 ret = exit status, returned unchanged
+*                 trace = trace file name in results
+******************************************/
+static int sample_finish(const std::filesystem::path &results, int ret, const char *trace = OCA_TRACE_FILE) {
+	(void)results;
+	(void)trace;
+	oca_energy_close();
+	OCA_TRACE_DUMP((results / trace).c_str());
+	return ret;
+}
+
 /* main */
 int32_t main(int32_t argc, char *argv[]) {
+	uint64_t main_ns = oca_coldstart_now_ns();
 	double cpu_time, oca_time;
+	int iterations = 1;
+	int fix_inexact = 0;                        /* kernel sizes where the fixed-point GaussianBlur is not bit-exact */
+	bool perf = false;
+	bool fifo = false;
+	bool roofline = false;
+	const char *energy = nullptr;
+	int pin_cpu = -1;
 	unsigned long OCA_f[16];
 	std::string input_data = "image.png";
 	std::filesystem::path resources("resources");
 	std::filesystem::path results("results");
 	std::filesystem::path in_file = resources / input_data;
 
+	/* Global options, removed from argv so the mode switches below still see the mode in argv[1] */
+	for (int i = 1; i < argc;) {
+		if (strcmp(argv[i], "--iterations") == 0 && i + 1 < argc) {
+			iterations = std::max(1, atoi(argv[i + 1]));
+			memmove(&argv[i], &argv[i + 2], (argc - i - 1) * sizeof(char *));
+			argc -= 2;
+		} else if (strcmp(argv[i], "--cpu") == 0 && i + 1 < argc) {
+			pin_cpu = atoi(argv[i + 1]);
+			memmove(&argv[i], &argv[i + 2], (argc - i - 1) * sizeof(char *));
+			argc -= 2;
+		} else if (strcmp(argv[i], "--roofline") == 0) {
+			roofline = true;
+			memmove(&argv[i], &argv[i + 1], (argc - i) * sizeof(char *));
+			argc -= 1;
+		} else if (strcmp(argv[i], "--fifo") == 0) {
+			fifo = true;
+			memmove(&argv[i], &argv[i + 1], (argc - i) * sizeof(char *));
+			argc -= 1;
+		} else if (strcmp(argv[i], "--mem") == 0) {
+			oca_memory_count(true);
+			memmove(&argv[i], &argv[i + 1], (argc - i) * sizeof(char *));
+			argc -= 1;
+		} else if (strcmp(argv[i], "--perf") == 0) {
+			perf = true;
+			memmove(&argv[i], &argv[i + 1], (argc - i) * sizeof(char *));
+			argc -= 1;
+		} else if (strcmp(argv[i], "--energy") == 0) {
+			/* Optional source, anything but another option */
+			int n = (i + 1 < argc && argv[i + 1][0] != '-') ? 2 : 1;
+			energy = (n == 2) ? argv[i + 1] : "auto";
+			memmove(&argv[i], &argv[i + n], (argc - i - n + 1) * sizeof(char *));
+			argc -= n;
+		} else {
+			i++;
+		}
+	}
+
 	if (!std::filesystem::exists(in_file)) {
 		std::cerr << "Error: " << in_file << " does not exist!" << std::endl;
 		return -1;
@@ -102,6 +162,31 @@ int32_t main(int32_t argc, char *argv[]) {
 	if (!std::filesystem::exists(results)) {
 		std::filesystem::create_directory(results);
 	}
+	oca_report_set_heatmap_dir(results);
+
+	for (unsigned long & i : OCA_f) {
+		i = OPENCVA_FUNC_NOCHANGE;
+	}
+
+	/********************/
+	/* Cold start       */
+	/********************/
+	/* Before the banner and the warm-up, which would hide the first-call costs */
+	if (argc > 1 && strcmp(argv[1], "--cold-start") == 0) {
+		/* Resolved here: the shell started by popen would resolve /proc/self/exe to itself */
+		char exe[PATH_MAX];
+		ssize_t len = readlink("/proc/self/exe", exe, sizeof(exe) - 1);
+		if (len < 0) {
+			std::cerr << "Error: Cannot resolve /proc/self/exe: " << strerror(errno) << std::endl;
+			return -1;
+		}
+		exe[len] = '\0';
+		return oca_coldstart_compare(exe);
+	}
+	if (argc > 1 && strcmp(argv[1], "--cold-start-run") == 0) {
+		int ret = oca_coldstart_profile(main_ns, in_file, &OCA_f[0], argc > 2 && strcmp(argv[2], "--prewarm") == 0);
+		return sample_finish(results, ret);
+	}
 
 	printf("RZ/V2MA OPENCV SAMPLE\n");
 	printf("[1] resize              FHD(BGR) -> XGA(BGR)     \n");
@@ -121,10 +206,6 @@ int32_t main(int32_t argc, char *argv[]) {
 	printf("[15] pyrUp              QFHD(BGR) -> FHD(BGR)    \n");
 	printf("\n\n");
 
-	for (unsigned long & i : OCA_f) {
-		i = OPENCVA_FUNC_NOCHANGE;
-	}
-
 	/********************/
 	/* Dummy(filter2D)  */
 	/********************/
@@ -133,30 +214,212 @@ int32_t main(int32_t argc, char *argv[]) {
 		cv::Mat unsharp(3, 3, CV_32FC1, kernel);
 		cv::Mat src_image(SRC_HEIGHT,SRC_WIDTH, CV_8UC3);
 		cv::Mat dst_image(SRC_HEIGHT,SRC_WIDTH, CV_8UC3, out_data);
-		src_size = SRC_WIDTH * SRC_HEIGHT * 3;
-		dst_size = SRC_WIDTH * SRC_HEIGHT * 3;
 
 		/* Read image data */
+		OCA_TRACE_BEGIN("imread", OCA_TRACE_CAT_IO);
 		src_image = imread(in_file, cv::IMREAD_COLOR);
+		OCA_TRACE_END("imread", OCA_TRACE_CAT_IO);
 		sync();
 		/* Disable Opencv Accelerator */
-		OCA_f[DRP_FUNC_FILTER2D] = OPENCVA_FUNC_DISABLE;
-		OCA_Activate(&OCA_f[0]);
+		oca_case_activate<OCA_CASE_FILTER2D>(&OCA_f[0], OPENCVA_FUNC_DISABLE);
 
 		/* [CPU]Opencv start */
 		cv::filter2D(src_image, dst_image, -1, unsharp);
 		oca_s = out_data[0]; //for suppress optimization
 
 		/* Enable Opencv Accelerator */
-		OCA_f[DRP_FUNC_FILTER2D] = OPENCVA_FUNC_ENABLE;
-		OCA_Activate(&OCA_f[0]);
+		oca_case_activate<OCA_CASE_FILTER2D>(&OCA_f[0], OPENCVA_FUNC_ENABLE);
 
 		/* [OCA]Opencv start */
 		cv::filter2D(src_image, dst_image, -1, unsharp);
 		oca_s = out_data[0]; //for suppress optimization
-		OCA_f[DRP_FUNC_FILTER2D] = OPENCVA_FUNC_NOCHANGE;
 	}
 
+	/* Energy sampler before pinning and SCHED_FIFO, so it keeps the original CPUs and a normal policy */
+	if (energy != nullptr) {
+		int ret = oca_energy_open(energy);
+		if (ret < 0) {
+			printf("[ENERGY] source %s unavailable (%s), timing only\n\n", energy, strerror(-ret));
+		} else {
+			printf("[ENERGY] source %s\n\n", oca_energy_source_name());
+		}
+	}
+
+	/* Bandwidth probe before pinning, its multi-threaded kernels need all CPUs */
+	if (roofline) {
+		oca_roofline roof;
+		if (oca_roofline_probe(roof) < 0) {
+			printf("[ROOF] not enough memory for the bandwidth probe\n\n");
+		} else {
+			printf("[ROOF] GB/s         copy    scale    triad\n");
+			printf("[ROOF] 1 thread  %8.2f %8.2f %8.2f\n", roof.single[OCA_ROOFLINE_COPY],
+				   roof.single[OCA_ROOFLINE_SCALE], roof.single[OCA_ROOFLINE_TRIAD]);
+			printf("[ROOF] %d threads %8.2f %8.2f %8.2f\n\n", roof.threads, roof.multi[OCA_ROOFLINE_COPY],
+				   roof.multi[OCA_ROOFLINE_SCALE], roof.multi[OCA_ROOFLINE_TRIAD]);
+			oca_report_set_roofline(roof);
+		}
+	}
+
+	/* Pinning and counters come after the warm-up so the OpenCV worker threads already exist */
+	if (pin_cpu >= 0) {
+		int ret = oca_stable_pin(pin_cpu);
+		printf("[STABLE] pin to CPU%d: %s\n", pin_cpu, ret < 0 ? strerror(-ret) : "ok");
+	}
+	if (fifo) {
+		int ret = oca_stable_fifo(OCA_STABLE_FIFO_PRIORITY);
+		printf("[STABLE] SCHED_FIFO %d: %s\n", OCA_STABLE_FIFO_PRIORITY, ret < 0 ? strerror(-ret) : "ok");
+	}
+	if (perf) {
+		int ret = oca_perf_open();
+		if (ret < 0) {
+			printf("[PERF] counters unavailable (%s), timing only\n\n", strerror(-ret));
+		} else {
+			printf("[PERF] counters:");
+			for (int k = 0; k < OCA_PERF_NUM; k++) {
+				printf(" %s%s", oca_perf_name(k), oca_perf_valid(k) ? "" : "(n/a)");
+			}
+			printf("\n\n");
+		}
+	}
+
+	/********************/
+	/* Batch mode       */
+	/********************/
+	if (argc > 1 && strcmp(argv[1], "--batch") == 0) {
+		OCA_TRACE_BEGIN("imread", OCA_TRACE_CAT_IO);
+		cv::Mat src_image = imread(in_file, cv::IMREAD_COLOR);
+		OCA_TRACE_END("imread", OCA_TRACE_CAT_IO);
+		oca_batch_benchmark(src_image, &OCA_f[0]);
+		printf("[END] Complete!!\n");
+		return sample_finish(results, 0);
+	}
+
+	/********************/
+	/* Frame ring mode  */
+	/********************/
+	if (argc > 1 && strcmp(argv[1], "--ring") == 0) {
+		OCA_TRACE_BEGIN("imread", OCA_TRACE_CAT_IO);
+		cv::Mat src_image = imread(in_file, cv::IMREAD_COLOR);
+		OCA_TRACE_END("imread", OCA_TRACE_CAT_IO);
+		oca_ring_benchmark(src_image);
+		printf("[END] Complete!!\n");
+		return sample_finish(results, 0);
+	}
+	if (argc > 1 && strcmp(argv[1], "--ring-produce") == 0) {
+		int ret = oca_ring_produce(argc > 2 ? argv[2] : nullptr, in_file, SRC_WIDTH, SRC_HEIGHT, 30);
+		return sample_finish(results, ret, OCA_TRACE_PRODUCE_FILE);
+	}
+	if (argc > 1 && strcmp(argv[1], "--ring-consume") == 0) {
+		return sample_finish(results, oca_ring_consume(), OCA_TRACE_CONSUME_FILE);
+	}
+
+	/********************/
+	/* Server client    */
+	/********************/
+	if (argc > 1 && strcmp(argv[1], "--client") == 0) {
+		OCA_TRACE_BEGIN("imread", OCA_TRACE_CAT_IO);
+		cv::Mat src_image = imread(in_file, cv::IMREAD_COLOR);
+		OCA_TRACE_END("imread", OCA_TRACE_CAT_IO);
+		return sample_finish(results, oca_client_benchmark(src_image));
+	}
+
+	/********************/
+	/* Paced mode       */
+	/********************/
+	if (argc > 1 && strcmp(argv[1], "--paced") == 0) {
+		OCA_TRACE_BEGIN("imread", OCA_TRACE_CAT_IO);
+		cv::Mat src_image = imread(in_file, cv::IMREAD_COLOR);
+		OCA_TRACE_END("imread", OCA_TRACE_CAT_IO);
+		int ret = oca_paced_benchmark(src_image, &OCA_f[0], argc > 2 ? atof(argv[2]) : OCA_PACED_FPS,
+									  argc > 3 ? argv[3] : OCA_PACED_OPS, argc > 4 ? atoi(argv[4]) : OCA_PACED_FRAMES,
+									  results);
+		if (ret == 0) {
+			printf("[END] Complete!!\n");
+		}
+		return sample_finish(results, ret);
+	}
+
+	/********************/
+	/* Parameter sweep  */
+	/********************/
+	if (argc > 1 && strcmp(argv[1], "--sweep") == 0) {
+		OCA_TRACE_BEGIN("imread", OCA_TRACE_CAT_IO);
+		cv::Mat src_image = imread(in_file, cv::IMREAD_COLOR);
+		OCA_TRACE_END("imread", OCA_TRACE_CAT_IO);
+		int ret = oca_sweep_benchmark(src_image, &OCA_f[0], argc > 2 ? argv[2] : nullptr, iterations, results);
+		if (ret == 0) {
+			printf("[END] Complete!!\n");
+		}
+		return sample_finish(results, ret);
+	}
+
+	/********************/
+	/* Incremental mode */
+	/********************/
+	if (argc > 1 && strcmp(argv[1], "--incremental") == 0) {
+		OCA_TRACE_BEGIN("imread", OCA_TRACE_CAT_IO);
+		cv::Mat src_image = imread(in_file, cv::IMREAD_COLOR);
+		OCA_TRACE_END("imread", OCA_TRACE_CAT_IO);
+		if (oca_incremental_benchmark(src_image, &OCA_f[0], argc > 2 ? std::max(2, atoi(argv[2])) : OCA_INC_FRAMES) < 0) {
+			return sample_finish(results, -1);
+		}
+		printf("[END] Complete!!\n");
+		return sample_finish(results, 0);
+	}
+
+	/********************/
+	/* Planar layout    */
+	/********************/
+	if (argc > 1 && strcmp(argv[1], "--planar") == 0) {
+		OCA_TRACE_BEGIN("imread", OCA_TRACE_CAT_IO);
+		cv::Mat src_image = imread(in_file, cv::IMREAD_COLOR);
+		OCA_TRACE_END("imread", OCA_TRACE_CAT_IO);
+		oca_planar_benchmark(src_image, &OCA_f[0], iterations);
+		printf("[END] Complete!!\n");
+		return sample_finish(results, 0);
+	}
+
+	/********************/
+	/* Input corpus     */
+	/********************/
+	if (argc > 1 && strcmp(argv[1], "--corpus") == 0) {
+		std::vector<oca_corpus_image> corpus;
+		const char *dir = argc > 2 ? argv[2] : OCA_CORPUS_DIR;
+		if (oca_corpus_load(dir, corpus) == 0) {
+			printf("[CORPUS] no images in %s, generating the procedural corpus\n", dir);
+			OCA_TRACE_BEGIN("imread", OCA_TRACE_CAT_IO);
+			cv::Mat src_image = imread(in_file, cv::IMREAD_COLOR);
+			OCA_TRACE_END("imread", OCA_TRACE_CAT_IO);
+			oca_corpus_generate(src_image, corpus);
+		}
+		int ret = oca_corpus_benchmark(corpus, &OCA_f[0], iterations, results);
+		if (ret == 0) {
+			printf("[END] Complete!!\n");
+		}
+		return sample_finish(results, ret);
+	}
+
+	/********************/
+	/* Buffer reuse     */
+	/********************/
+	if (argc > 1 && strcmp(argv[1], "--reuse") == 0) {
+		OCA_TRACE_BEGIN("imread", OCA_TRACE_CAT_IO);
+		cv::Mat src_image = imread(in_file, cv::IMREAD_COLOR);
+		OCA_TRACE_END("imread", OCA_TRACE_CAT_IO);
+		oca_reuse_benchmark(src_image, &OCA_f[0], iterations);
+		printf("[END] Complete!!\n");
+		return sample_finish(results, 0);
+	}
+
+	/********************/
+	/* Simulator profile */
+	/********************/
+	if (argc > 1 && strcmp(argv[1], "--sim-record") == 0) {
+		OCA_TRACE_BEGIN("imread", OCA_TRACE_CAT_IO);
+		cv::Mat src_image = imread(in_file, cv::IMREAD_COLOR);
+		OCA_TRACE_END("imread", OCA_TRACE_CAT_IO);
+		return sample_finish(results, oca_sim_record(src_image, &OCA_f[0], argc > 2 ? argv[2] : OCA_SIM_PROFILE_FILE));
+	}
 
 	/**************************************/
 	/* [1]  resize   FHD(BGR) -> XGA(BGR) */
@@ -165,27 +428,32 @@ int32_t main(int32_t argc, char *argv[]) {
 		printf("[1] resize             FHD(BGR) -> XGA(BGR)      \n");
 		cv::Mat src_image(SRC_HEIGHT,SRC_WIDTH, CV_8UC3);
 		cv::Mat dst_image(768, 1024, CV_8UC3, out_data);
-		src_size = SRC_WIDTH * SRC_HEIGHT * 3;
-		dst_size = 1024 * 768 * 3;
+		oca_case_report<OCA_CASE_RESIZE>();
 
 		/* Read image data */
+		OCA_TRACE_BEGIN("imread", OCA_TRACE_CAT_IO);
 		src_image = imread(in_file, cv::IMREAD_COLOR);
+		OCA_TRACE_END("imread", OCA_TRACE_CAT_IO);
 		sync();
 
 		/* Disable Opencv Accelerator */
-		OCA_f[DRP_FUNC_RESIZE] = OPENCVA_FUNC_DISABLE;
-		OCA_Activate(&OCA_f[0]);
+		oca_case_activate<OCA_CASE_RESIZE>(&OCA_f[0], OPENCVA_FUNC_DISABLE);
 
 		/* [CPU]Opencv start */
-		timespec_get(&start_time, TIME_UTC);
-		cv::resize(src_image, dst_image, {1024, 768}, 0, 0, cv::INTER_LINEAR);
-		oca_s = out_data[0]; //for suppress optimization
-		timespec_get(&end_time, TIME_UTC);
-		cpu_time = timedifference_msec(start_time, end_time);
+		while (oca_report_next(OCA_REPORT_CPU, iterations)) {
+			oca_report_start(OCA_REPORT_CPU);
+			oca_case_run<OCA_CASE_RESIZE>(src_image, cv::Mat(), dst_image);
+			oca_s = out_data[0]; //for suppress optimization
+			oca_report_stop(OCA_REPORT_CPU);
+		}
+		oca_report_reference(dst_image);
+		cpu_time = oca_report_median(OCA_REPORT_CPU);
 		printf("[CPU]%fmsec\n", cpu_time);
 
 		/* [CPU]Write image data */
+		OCA_TRACE_BEGIN("imwrite", OCA_TRACE_CAT_IO);
 		imwrite(results / "OCA1_cpu_out.png", dst_image);
+		OCA_TRACE_END("imwrite", OCA_TRACE_CAT_IO);
 		sync();
 		/* Wait to complete writing to storage */
 #if C_DELAY
@@ -193,19 +461,24 @@ int32_t main(int32_t argc, char *argv[]) {
 #endif
 
 		/* Enable Opencv Accelerator */
-		OCA_f[DRP_FUNC_RESIZE] = OPENCVA_FUNC_ENABLE;
-		OCA_Activate(&OCA_f[0]);
+		oca_case_activate<OCA_CASE_RESIZE>(&OCA_f[0], OPENCVA_FUNC_ENABLE);
 
 		/* [OCA]Opencv start */
-		timespec_get(&start_time, TIME_UTC);
-		cv::resize(src_image, dst_image, {1024, 768}, 0, 0, cv::INTER_LINEAR);
-		oca_s = out_data[0]; //for suppress optimization
-		timespec_get(&end_time, TIME_UTC);
-		oca_time = timedifference_msec(start_time, end_time);
+		while (oca_report_next(OCA_REPORT_OCA, iterations)) {
+			oca_report_start(OCA_REPORT_OCA);
+			oca_case_run<OCA_CASE_RESIZE>(src_image, cv::Mat(), dst_image);
+			oca_s = out_data[0]; //for suppress optimization
+			oca_case_charge<OCA_CASE_RESIZE>();
+			oca_report_stop(OCA_REPORT_OCA);
+			oca_report_accuracy(OCA_REPORT_OCA, dst_image);
+		}
+		oca_time = oca_report_median(OCA_REPORT_OCA);
 		printf("[OCA]%fmsec\n", oca_time);
 
 		/* [OCA]Write image data */
+		OCA_TRACE_BEGIN("imwrite", OCA_TRACE_CAT_IO);
 		imwrite(results / "OCA1_oca_out.png", dst_image);
+		OCA_TRACE_END("imwrite", OCA_TRACE_CAT_IO);
 		sync();
 		/* Wait to complete writing to storage */
 #if C_DELAY
@@ -214,7 +487,6 @@ int32_t main(int32_t argc, char *argv[]) {
 
 		/* Result */
 		printf("[CPU] / [OCA] = %f times\n\n", cpu_time / oca_time);
-		OCA_f[DRP_FUNC_RESIZE] = OPENCVA_FUNC_NOCHANGE;
 	}
 
 
@@ -229,15 +501,17 @@ int32_t main(int32_t argc, char *argv[]) {
 		cv::Mat tmp_image(SRC_HEIGHT,SRC_WIDTH, CV_8UC3);
 		cv::Mat3b tmp2;
 		cv::Vec3b bgr;
-		src_size = SRC_WIDTH * SRC_HEIGHT * 3;
-		dst_size = SRC_WIDTH * SRC_HEIGHT * 3;
+		oca_case_report<OCA_CASE_CVT_YUV2BGR>();
 
 		/* Read image data */
+		OCA_TRACE_BEGIN("imread", OCA_TRACE_CAT_IO);
 		tmp_image = imread(in_file, cv::IMREAD_COLOR);
+		OCA_TRACE_END("imread", OCA_TRACE_CAT_IO);
 		tmp2 = tmp_image;
 		sync();
 
 		/* Convert BGR to UYVY */
+		OCA_TRACE_BEGIN("BGR to UYVY", OCA_TRACE_CAT_INPUT);
 		src_counter = 0;
 		for (int y = 0; y < SRC_HEIGHT; y++) {
 			for (int x = 0; x < SRC_WIDTH; x += 2) {
@@ -263,24 +537,29 @@ int32_t main(int32_t argc, char *argv[]) {
 				src_counter += 4;
 			}
 		}
+		OCA_TRACE_END("BGR to UYVY", OCA_TRACE_CAT_INPUT);
 		cv::Mat src_image(SRC_HEIGHT,SRC_WIDTH, CV_8UC2, in_data);
 
 		saveMatNPY(src_image, resources/"cvtColor.npy");
 
 		/* Disable Opencv Accelerator */
-		OCA_f[DRP_FUNC_CVT_YUV2BGR] = OPENCVA_FUNC_DISABLE;
-		OCA_Activate(&OCA_f[0]);
+		oca_case_activate<OCA_CASE_CVT_YUV2BGR>(&OCA_f[0], OPENCVA_FUNC_DISABLE);
 
 		/* [CPU]Opencv start */
-		timespec_get(&start_time, TIME_UTC);
-		cv::cvtColor(src_image, dst_image, cv::COLOR_YUV2BGR_YUYV);
-		oca_s = out_data[0]; //for suppress optimization
-		timespec_get(&end_time, TIME_UTC);
-		cpu_time = timedifference_msec(start_time, end_time);
+		while (oca_report_next(OCA_REPORT_CPU, iterations)) {
+			oca_report_start(OCA_REPORT_CPU);
+			oca_case_run<OCA_CASE_CVT_YUV2BGR>(src_image, cv::Mat(), dst_image);
+			oca_s = out_data[0]; //for suppress optimization
+			oca_report_stop(OCA_REPORT_CPU);
+		}
+		oca_report_reference(dst_image);
+		cpu_time = oca_report_median(OCA_REPORT_CPU);
 		printf("[CPU]%fmsec\n", cpu_time);
 
 		/* [CPU]Write image data */
+		OCA_TRACE_BEGIN("imwrite", OCA_TRACE_CAT_IO);
 		imwrite(results / "OCA2_cpu_out.png", dst_image);
+		OCA_TRACE_END("imwrite", OCA_TRACE_CAT_IO);
 		sync();
 		/* Wait to complete writing to storage */
 #if C_DELAY
@@ -288,19 +567,24 @@ int32_t main(int32_t argc, char *argv[]) {
 #endif
 
 		/* Enable Opencv Accelerator */
-		OCA_f[DRP_FUNC_CVT_YUV2BGR] = OPENCVA_FUNC_ENABLE;
-		OCA_Activate(&OCA_f[0]);
+		oca_case_activate<OCA_CASE_CVT_YUV2BGR>(&OCA_f[0], OPENCVA_FUNC_ENABLE);
 
 		/* [OCA]Opencv start */
-		timespec_get(&start_time, TIME_UTC);
-		cv::cvtColor(src_image, dst_image, cv::COLOR_YUV2BGR_YUYV);
-		oca_s = out_data[0]; //for suppress optimization
-		timespec_get(&end_time, TIME_UTC);
-		oca_time = timedifference_msec(start_time, end_time);
+		while (oca_report_next(OCA_REPORT_OCA, iterations)) {
+			oca_report_start(OCA_REPORT_OCA);
+			oca_case_run<OCA_CASE_CVT_YUV2BGR>(src_image, cv::Mat(), dst_image);
+			oca_s = out_data[0]; //for suppress optimization
+			oca_case_charge<OCA_CASE_CVT_YUV2BGR>();
+			oca_report_stop(OCA_REPORT_OCA);
+			oca_report_accuracy(OCA_REPORT_OCA, dst_image);
+		}
+		oca_time = oca_report_median(OCA_REPORT_OCA);
 		printf("[OCA]%fmsec\n", oca_time);
 
 		/* [OCA]Write image data */
+		OCA_TRACE_BEGIN("imwrite", OCA_TRACE_CAT_IO);
 		imwrite(results / "OCA2_oca_out.png", dst_image);
+		OCA_TRACE_END("imwrite", OCA_TRACE_CAT_IO);
 		sync();
 		/* Wait to complete writing to storage */
 #if C_DELAY
@@ -309,7 +593,6 @@ int32_t main(int32_t argc, char *argv[]) {
 
 		/* Result */
 		printf("[CPU] / [OCA] = %f times\n\n", cpu_time / oca_time);
-		OCA_f[DRP_FUNC_CVT_YUV2BGR] = OPENCVA_FUNC_NOCHANGE;
 	}
 
 
@@ -324,15 +607,17 @@ int32_t main(int32_t argc, char *argv[]) {
 		cv::Mat tmp_image(SRC_HEIGHT,SRC_WIDTH, CV_8UC3);
 		cv::Mat3b tmp2;
 		cv::Vec3b bgr;
-		src_size = SRC_WIDTH * SRC_HEIGHT * 3;
-		dst_size = SRC_WIDTH * SRC_HEIGHT * 3;
+		oca_case_report<OCA_CASE_CVT_NV2BGR>();
 
 		/* Read image data */
+		OCA_TRACE_BEGIN("imread", OCA_TRACE_CAT_IO);
 		tmp_image = imread(in_file, cv::IMREAD_COLOR);
+		OCA_TRACE_END("imread", OCA_TRACE_CAT_IO);
 		tmp2 = tmp_image;
 		sync();
 
 		/* Convert BGR to NV21 */
+		OCA_TRACE_BEGIN("BGR to NV21", OCA_TRACE_CAT_INPUT);
 		for (int y = 0; y < SRC_HEIGHT; y += 2) {
 			for (int x = 0; x < SRC_WIDTH; x += 2) {
 				float y00, y01, y10, y11, u, v;
@@ -370,6 +655,7 @@ int32_t main(int32_t argc, char *argv[]) {
 				in_data1[y * (SRC_WIDTH / 2) + x + 1] = v > 255.0f ? 255 : v < 0.0f ? 0 : static_cast<unsigned char>(v);
 			}
 		}
+		OCA_TRACE_END("BGR to NV21", OCA_TRACE_CAT_INPUT);
 		cv::Mat src_image1(SRC_HEIGHT,SRC_WIDTH, CV_8UC1, in_data0);
 		cv::Mat src_image2((SRC_HEIGHT / 2), (SRC_WIDTH / 2), CV_8UC2, in_data1);
 
@@ -377,19 +663,23 @@ int32_t main(int32_t argc, char *argv[]) {
 		saveMatNPY(src_image2, resources/"cvtColorTwoPlane2.npy");
 
 		/* Disable Opencv Accelerator */
-		OCA_f[DRP_FUNC_CVT_NV2BGR] = OPENCVA_FUNC_DISABLE;
-		OCA_Activate(&OCA_f[0]);
+		oca_case_activate<OCA_CASE_CVT_NV2BGR>(&OCA_f[0], OPENCVA_FUNC_DISABLE);
 
 		/* [CPU]Opencv start */
-		timespec_get(&start_time, TIME_UTC);
-		cv::cvtColorTwoPlane(src_image1, src_image2, dst_image, cv::COLOR_YUV2RGB_NV21);
-		oca_s = out_data[0]; //for suppress optimization
-		timespec_get(&end_time, TIME_UTC);
-		cpu_time = timedifference_msec(start_time, end_time);
+		while (oca_report_next(OCA_REPORT_CPU, iterations)) {
+			oca_report_start(OCA_REPORT_CPU);
+			oca_case_run<OCA_CASE_CVT_NV2BGR>(src_image1, src_image2, dst_image);
+			oca_s = out_data[0]; //for suppress optimization
+			oca_report_stop(OCA_REPORT_CPU);
+		}
+		oca_report_reference(dst_image);
+		cpu_time = oca_report_median(OCA_REPORT_CPU);
 		printf("[CPU]%fmsec\n", cpu_time);
 
 		/* [CPU]Write image data */
+		OCA_TRACE_BEGIN("imwrite", OCA_TRACE_CAT_IO);
 		imwrite(results / "OCA3_cpu_out.png", dst_image);
+		OCA_TRACE_END("imwrite", OCA_TRACE_CAT_IO);
 		sync();
 		/* Wait to complete writing to storage */
 #if C_DELAY
@@ -397,19 +687,24 @@ int32_t main(int32_t argc, char *argv[]) {
 #endif
 
 		/* Enable Opencv Accelerator */
-		OCA_f[DRP_FUNC_CVT_NV2BGR] = OPENCVA_FUNC_ENABLE;
-		OCA_Activate(&OCA_f[0]);
+		oca_case_activate<OCA_CASE_CVT_NV2BGR>(&OCA_f[0], OPENCVA_FUNC_ENABLE);
 
 		/* [OCA]Opencv start */
-		timespec_get(&start_time, TIME_UTC);
-		cv::cvtColorTwoPlane(src_image1, src_image2, dst_image, cv::COLOR_YUV2RGB_NV21);
-		oca_s = out_data[0]; //for suppress optimization
-		timespec_get(&end_time, TIME_UTC);
-		oca_time = timedifference_msec(start_time, end_time);
+		while (oca_report_next(OCA_REPORT_OCA, iterations)) {
+			oca_report_start(OCA_REPORT_OCA);
+			oca_case_run<OCA_CASE_CVT_NV2BGR>(src_image1, src_image2, dst_image);
+			oca_s = out_data[0]; //for suppress optimization
+			oca_case_charge<OCA_CASE_CVT_NV2BGR>();
+			oca_report_stop(OCA_REPORT_OCA);
+			oca_report_accuracy(OCA_REPORT_OCA, dst_image);
+		}
+		oca_time = oca_report_median(OCA_REPORT_OCA);
 		printf("[OCA]%fmsec\n", oca_time);
 
 		/* [OCA]Write image data */
+		OCA_TRACE_BEGIN("imwrite", OCA_TRACE_CAT_IO);
 		imwrite(results / "OCA3_oca_out.png", dst_image);
+		OCA_TRACE_END("imwrite", OCA_TRACE_CAT_IO);
 		sync();
 		/* Wait to complete writing to storage */
 #if C_DELAY
@@ -418,7 +713,6 @@ int32_t main(int32_t argc, char *argv[]) {
 
 		/* Result */
 		printf("[CPU] / [OCA] = %f times\n\n", cpu_time / oca_time);
-		OCA_f[DRP_FUNC_CVT_YUV2BGR] = OPENCVA_FUNC_NOCHANGE;
 	}
 
 
@@ -426,58 +720,91 @@ int32_t main(int32_t argc, char *argv[]) {
 	/* [4]  GaussianBlur   FHD(BGR) [7x7] */
 	/**************************************/
 	{
+		double fix_time;
 		printf("[4] GaussianBlur       FHD(BGR) [7x7]\n");
 		cv::Mat src_image(SRC_HEIGHT,SRC_WIDTH, CV_8UC3);
 		cv::Mat dst_image(SRC_HEIGHT,SRC_WIDTH, CV_8UC3, out_data);
-		src_size = SRC_WIDTH * SRC_HEIGHT * 3;
-		dst_size = SRC_WIDTH * SRC_HEIGHT * 3;
+		cv::Mat ref_image(SRC_HEIGHT,SRC_WIDTH, CV_8UC3);
+		cv::Mat fix_image(SRC_HEIGHT,SRC_WIDTH, CV_8UC3);
+		oca_case_report<OCA_CASE_GAUSSIAN>();
 
 		/* Read image data */
+		OCA_TRACE_BEGIN("imread", OCA_TRACE_CAT_IO);
 		src_image = imread(in_file, cv::IMREAD_COLOR);
+		OCA_TRACE_END("imread", OCA_TRACE_CAT_IO);
 		sync();
 
 		/* Disable Opencv Accelerator */
-		OCA_f[DRP_FUNC_GAUSSIAN] = OPENCVA_FUNC_DISABLE;
-		OCA_Activate(&OCA_f[0]);
+		oca_case_activate<OCA_CASE_GAUSSIAN>(&OCA_f[0], OPENCVA_FUNC_DISABLE);
 
 		/* [CPU]Opencv start */
-		timespec_get(&start_time, TIME_UTC);
-		cv::GaussianBlur(src_image, dst_image, {7, 7}, 0, 0);
-		oca_s = out_data[0]; //for suppress optimization
-		timespec_get(&end_time, TIME_UTC);
-		cpu_time = timedifference_msec(start_time, end_time);
+		while (oca_report_next(OCA_REPORT_CPU, iterations)) {
+			oca_report_start(OCA_REPORT_CPU);
+			oca_case_run<OCA_CASE_GAUSSIAN>(src_image, cv::Mat(), dst_image);
+			oca_s = out_data[0]; //for suppress optimization
+			oca_report_stop(OCA_REPORT_CPU);
+		}
+		oca_report_reference(dst_image);
+		cpu_time = oca_report_median(OCA_REPORT_CPU);
 		printf("[CPU]%fmsec\n", cpu_time);
 
 		/* [CPU]Write image data */
+		OCA_TRACE_BEGIN("imwrite", OCA_TRACE_CAT_IO);
 		imwrite(results / "OCA4_cpu_out.png", dst_image);
+		OCA_TRACE_END("imwrite", OCA_TRACE_CAT_IO);
 		sync();
 		/* Wait to complete writing to storage */
 #if C_DELAY
 		sleep(C_DELAY);
 #endif
 
+		/* [FIX]Fixed-point CPU fallback start */
+		while (oca_report_next(OCA_REPORT_FIX, iterations)) {
+			oca_report_start(OCA_REPORT_FIX);
+			gaussian_blur_fixed<7>(src_image, fix_image);
+			oca_s = fix_image.data[0]; //for suppress optimization
+			oca_report_stop(OCA_REPORT_FIX);
+			oca_report_accuracy(OCA_REPORT_FIX, fix_image);
+		}
+		fix_time = oca_report_median(OCA_REPORT_FIX);
+		printf("[FIX]%fmsec\n", fix_time);
+
+		/* [FIX]Verify bit-exactness against the CPU path for every specialized size, any difference fails the run */
+		for (int ksize = 3; ksize <= 9; ksize += 2) {
+			cv::GaussianBlur(src_image, ref_image, {ksize, ksize}, 0, 0);
+			gaussian_blur_fixed(src_image, fix_image, ksize);
+			double diff = oca_report_exact(OCA_REPORT_FIX, ref_image, fix_image);
+			printf("[FIX]%dx%d max diff %.0f%s\n", ksize, ksize, diff, diff == 0 ? "" : " FAIL");
+			fix_inexact += diff != 0;
+		}
+
 		/* Enable Opencv Accelerator */
-		OCA_f[DRP_FUNC_GAUSSIAN] = OPENCVA_FUNC_ENABLE;
-		OCA_Activate(&OCA_f[0]);
+		oca_case_activate<OCA_CASE_GAUSSIAN>(&OCA_f[0], OPENCVA_FUNC_ENABLE);
 
 		/* [OCA]Opencv start */
-		timespec_get(&start_time, TIME_UTC);
-		cv::GaussianBlur(src_image, dst_image, {7, 7}, 0, 0);
-		oca_s = out_data[0]; //for suppress optimization
-		timespec_get(&end_time, TIME_UTC);
-		oca_time = timedifference_msec(start_time, end_time);
+		while (oca_report_next(OCA_REPORT_OCA, iterations)) {
+			oca_report_start(OCA_REPORT_OCA);
+			oca_case_run<OCA_CASE_GAUSSIAN>(src_image, cv::Mat(), dst_image);
+			oca_s = out_data[0]; //for suppress optimization
+			oca_case_charge<OCA_CASE_GAUSSIAN>();
+			oca_report_stop(OCA_REPORT_OCA);
+			oca_report_accuracy(OCA_REPORT_OCA, dst_image);
+		}
+		oca_time = oca_report_median(OCA_REPORT_OCA);
 		printf("[OCA]%fmsec\n", oca_time);
 
 		/* [OCA]Write image data */
+		OCA_TRACE_BEGIN("imwrite", OCA_TRACE_CAT_IO);
 		imwrite(results / "OCA4_oca_out.png", dst_image);
+		OCA_TRACE_END("imwrite", OCA_TRACE_CAT_IO);
 		sync();
 		/* Wait to complete writing to storage */
 #if C_DELAY
 		sleep(C_DELAY);
 #endif
 
+		printf("[CPU] / [FIX] = %f times\n", cpu_time / fix_time);
 		printf("[CPU] / [OCA] = %f times\n\n", cpu_time / oca_time);
-		OCA_f[DRP_FUNC_GAUSSIAN] = OPENCVA_FUNC_NOCHANGE;
 	}
 
 
@@ -488,27 +815,32 @@ int32_t main(int32_t argc, char *argv[]) {
 		printf("[5] dilate             FHD(BGR) [iteration=200]\n");
 		cv::Mat src_image(SRC_HEIGHT,SRC_WIDTH, CV_8UC3);
 		cv::Mat dst_image(SRC_HEIGHT,SRC_WIDTH, CV_8UC3, out_data);
-		src_size = SRC_WIDTH * SRC_HEIGHT * 3;
-		dst_size = SRC_WIDTH * SRC_HEIGHT * 3;
+		oca_case_report<OCA_CASE_DILATE>();
 
 		/* Read image data */
+		OCA_TRACE_BEGIN("imread", OCA_TRACE_CAT_IO);
 		src_image = imread(in_file, cv::IMREAD_COLOR);
+		OCA_TRACE_END("imread", OCA_TRACE_CAT_IO);
 		sync();
 
 		/* Disable Opencv Accelerator */
-		OCA_f[DRP_FUNC_DILATE] = OPENCVA_FUNC_DISABLE;
-		OCA_Activate(&OCA_f[0]);
+		oca_case_activate<OCA_CASE_DILATE>(&OCA_f[0], OPENCVA_FUNC_DISABLE);
 
 		/* [CPU]Opencv start */
-		timespec_get(&start_time, TIME_UTC);
-		cv::dilate(src_image, dst_image, cv::Mat(), cv::Point(-1, -1), 200);
-		oca_s = out_data[0]; //for suppress optimization
-		timespec_get(&end_time, TIME_UTC);
-		cpu_time = timedifference_msec(start_time, end_time);
+		while (oca_report_next(OCA_REPORT_CPU, iterations)) {
+			oca_report_start(OCA_REPORT_CPU);
+			oca_case_run<OCA_CASE_DILATE>(src_image, cv::Mat(), dst_image);
+			oca_s = out_data[0]; //for suppress optimization
+			oca_report_stop(OCA_REPORT_CPU);
+		}
+		oca_report_reference(dst_image);
+		cpu_time = oca_report_median(OCA_REPORT_CPU);
 		printf("[CPU]%fmsec\n", cpu_time);
 
 		/* [CPU]Write image data */
+		OCA_TRACE_BEGIN("imwrite", OCA_TRACE_CAT_IO);
 		imwrite(results / "OCA5_cpu_out.png", dst_image);
+		OCA_TRACE_END("imwrite", OCA_TRACE_CAT_IO);
 		sync();
 		/* Wait to complete writing to storage */
 #if C_DELAY
@@ -516,19 +848,24 @@ int32_t main(int32_t argc, char *argv[]) {
 #endif
 
 		/* Enable Opencv Accelerator */
-		OCA_f[DRP_FUNC_DILATE] = OPENCVA_FUNC_ENABLE;
-		OCA_Activate(&OCA_f[0]);
+		oca_case_activate<OCA_CASE_DILATE>(&OCA_f[0], OPENCVA_FUNC_ENABLE);
 
 		/* [OCA]Opencv start */
-		timespec_get(&start_time, TIME_UTC);
-		cv::dilate(src_image, dst_image, cv::Mat(), cv::Point(-1, -1), 200);
-		oca_s = out_data[0]; //for suppress optimization
-		timespec_get(&end_time, TIME_UTC);
-		oca_time = timedifference_msec(start_time, end_time);
+		while (oca_report_next(OCA_REPORT_OCA, iterations)) {
+			oca_report_start(OCA_REPORT_OCA);
+			oca_case_run<OCA_CASE_DILATE>(src_image, cv::Mat(), dst_image);
+			oca_s = out_data[0]; //for suppress optimization
+			oca_case_charge<OCA_CASE_DILATE>();
+			oca_report_stop(OCA_REPORT_OCA);
+			oca_report_accuracy(OCA_REPORT_OCA, dst_image);
+		}
+		oca_time = oca_report_median(OCA_REPORT_OCA);
 		printf("[OCA]%fmsec\n", oca_time);
 
 		/* [OCA]Write image data */
+		OCA_TRACE_BEGIN("imwrite", OCA_TRACE_CAT_IO);
 		imwrite(results / "OCA5_oca_out.png", dst_image);
+		OCA_TRACE_END("imwrite", OCA_TRACE_CAT_IO);
 		sync();
 		/* Wait to complete writing to storage */
 #if C_DELAY
@@ -536,7 +873,6 @@ int32_t main(int32_t argc, char *argv[]) {
 #endif
 
 		printf("[CPU] / [OCA] = %f times\n\n", cpu_time / oca_time);
-		OCA_f[DRP_FUNC_DILATE] = OPENCVA_FUNC_NOCHANGE;
 	}
 
 
@@ -547,27 +883,32 @@ int32_t main(int32_t argc, char *argv[]) {
 		printf("[6] erode              FHD(BGR) [iteration=100]\n");
 		cv::Mat src_image(SRC_HEIGHT,SRC_WIDTH, CV_8UC3);
 		cv::Mat dst_image(SRC_HEIGHT,SRC_WIDTH, CV_8UC3, out_data);
-		src_size = SRC_WIDTH * SRC_HEIGHT * 3;
-		dst_size = SRC_WIDTH * SRC_HEIGHT * 3;
+		oca_case_report<OCA_CASE_ERODE>();
 
 		/* Read image data */
+		OCA_TRACE_BEGIN("imread", OCA_TRACE_CAT_IO);
 		src_image = imread(in_file, cv::IMREAD_COLOR);
+		OCA_TRACE_END("imread", OCA_TRACE_CAT_IO);
 		sync();
 
 		/* Disable Opencv Accelerator */
-		OCA_f[DRP_FUNC_ERODE] = OPENCVA_FUNC_DISABLE;
-		OCA_Activate(&OCA_f[0]);
+		oca_case_activate<OCA_CASE_ERODE>(&OCA_f[0], OPENCVA_FUNC_DISABLE);
 
 		/* [CPU]Opencv start */
-		timespec_get(&start_time, TIME_UTC);
-		cv::erode(src_image, dst_image, cv::Mat(), cv::Point(-1, -1), 100);
-		oca_s = out_data[0]; //for suppress optimization
-		timespec_get(&end_time, TIME_UTC);
-		cpu_time = timedifference_msec(start_time, end_time);
+		while (oca_report_next(OCA_REPORT_CPU, iterations)) {
+			oca_report_start(OCA_REPORT_CPU);
+			oca_case_run<OCA_CASE_ERODE>(src_image, cv::Mat(), dst_image);
+			oca_s = out_data[0]; //for suppress optimization
+			oca_report_stop(OCA_REPORT_CPU);
+		}
+		oca_report_reference(dst_image);
+		cpu_time = oca_report_median(OCA_REPORT_CPU);
 		printf("[CPU]%fmsec\n", cpu_time);
 
 		/* [CPU]Write image data */
+		OCA_TRACE_BEGIN("imwrite", OCA_TRACE_CAT_IO);
 		imwrite(results / "OCA6_cpu_out.png", dst_image);
+		OCA_TRACE_END("imwrite", OCA_TRACE_CAT_IO);
 		sync();
 		/* Wait to complete writing to storage */
 #if C_DELAY
@@ -575,19 +916,24 @@ int32_t main(int32_t argc, char *argv[]) {
 #endif
 
 		/* Enable Opencv Accelerator */
-		OCA_f[DRP_FUNC_ERODE] = OPENCVA_FUNC_ENABLE;
-		OCA_Activate(&OCA_f[0]);
+		oca_case_activate<OCA_CASE_ERODE>(&OCA_f[0], OPENCVA_FUNC_ENABLE);
 
 		/* [OCA]Opencv start */
-		timespec_get(&start_time, TIME_UTC);
-		cv::erode(src_image, dst_image, cv::Mat(), cv::Point(-1, -1), 100);
-		oca_s = out_data[0]; //for suppress optimization
-		timespec_get(&end_time, TIME_UTC);
-		oca_time = timedifference_msec(start_time, end_time);
+		while (oca_report_next(OCA_REPORT_OCA, iterations)) {
+			oca_report_start(OCA_REPORT_OCA);
+			oca_case_run<OCA_CASE_ERODE>(src_image, cv::Mat(), dst_image);
+			oca_s = out_data[0]; //for suppress optimization
+			oca_case_charge<OCA_CASE_ERODE>();
+			oca_report_stop(OCA_REPORT_OCA);
+			oca_report_accuracy(OCA_REPORT_OCA, dst_image);
+		}
+		oca_time = oca_report_median(OCA_REPORT_OCA);
 		printf("[OCA]%fmsec\n", oca_time);
 
 		/* [OCA]Write image data */
+		OCA_TRACE_BEGIN("imwrite", OCA_TRACE_CAT_IO);
 		imwrite(results / "OCA6_oca_out.png", dst_image);
+		OCA_TRACE_END("imwrite", OCA_TRACE_CAT_IO);
 		sync();
 		/* Wait to complete writing to storage */
 #if C_DELAY
@@ -595,7 +941,6 @@ int32_t main(int32_t argc, char *argv[]) {
 #endif
 
 		printf("[CPU] / [OCA] = %f times\n\n", cpu_time / oca_time);
-		OCA_f[DRP_FUNC_ERODE] = OPENCVA_FUNC_NOCHANGE;
 	}
 
 
@@ -606,28 +951,32 @@ int32_t main(int32_t argc, char *argv[]) {
 		printf("[7] morphologyEX       FHD(BGR) [iteration= 50] \n");
 		cv::Mat src_image(SRC_HEIGHT,SRC_WIDTH, CV_8UC3);
 		cv::Mat dst_image(SRC_HEIGHT,SRC_WIDTH, CV_8UC3, out_data);
-		src_size = SRC_WIDTH * SRC_HEIGHT * 3;
-		dst_size = SRC_WIDTH * SRC_HEIGHT * 3;
+		oca_case_report<OCA_CASE_MORPHOLOGY>();
 
 		/* Read image data */
+		OCA_TRACE_BEGIN("imread", OCA_TRACE_CAT_IO);
 		src_image = imread(in_file, cv::IMREAD_COLOR);
+		OCA_TRACE_END("imread", OCA_TRACE_CAT_IO);
 		sync();
 
 		/* Disable Opencv Accelerator */
-		OCA_f[DRP_FUNC_ERODE] = OPENCVA_FUNC_DISABLE;
-		OCA_f[DRP_FUNC_DILATE] = OPENCVA_FUNC_DISABLE;
-		OCA_Activate(&OCA_f[0]);
+		oca_case_activate<OCA_CASE_MORPHOLOGY>(&OCA_f[0], OPENCVA_FUNC_DISABLE);
 
 		/* [CPU]Opencv start */
-		timespec_get(&start_time, TIME_UTC);
-		cv::morphologyEx(src_image, dst_image, cv::MORPH_OPEN, cv::Mat(), cv::Point(-1, -1), 50);
-		oca_s = out_data[0]; //for suppress optimization
-		timespec_get(&end_time, TIME_UTC);
-		cpu_time = timedifference_msec(start_time, end_time);
+		while (oca_report_next(OCA_REPORT_CPU, iterations)) {
+			oca_report_start(OCA_REPORT_CPU);
+			oca_case_run<OCA_CASE_MORPHOLOGY>(src_image, cv::Mat(), dst_image);
+			oca_s = out_data[0]; //for suppress optimization
+			oca_report_stop(OCA_REPORT_CPU);
+		}
+		oca_report_reference(dst_image);
+		cpu_time = oca_report_median(OCA_REPORT_CPU);
 		printf("[CPU]%fmsec\n", cpu_time);
 
 		/* [CPU]Write image data */
+		OCA_TRACE_BEGIN("imwrite", OCA_TRACE_CAT_IO);
 		imwrite(results / "OCA7_cpu_out.png", dst_image);
+		OCA_TRACE_END("imwrite", OCA_TRACE_CAT_IO);
 		sync();
 		/* Wait to complete writing to storage */
 #if C_DELAY
@@ -635,20 +984,24 @@ int32_t main(int32_t argc, char *argv[]) {
 #endif
 
 		/* Enable Opencv Accelerator */
-		OCA_f[DRP_FUNC_ERODE] = OPENCVA_FUNC_ENABLE;
-		OCA_f[DRP_FUNC_DILATE] = OPENCVA_FUNC_ENABLE;
-		OCA_Activate(&OCA_f[0]);
+		oca_case_activate<OCA_CASE_MORPHOLOGY>(&OCA_f[0], OPENCVA_FUNC_ENABLE);
 
 		/* [OCA]Opencv start */
-		timespec_get(&start_time, TIME_UTC);
-		cv::morphologyEx(src_image, dst_image, cv::MORPH_OPEN, cv::Mat(), cv::Point(-1, -1), 50);
-		oca_s = out_data[0]; //for suppress optimization
-		timespec_get(&end_time, TIME_UTC);
-		oca_time = timedifference_msec(start_time, end_time);
+		while (oca_report_next(OCA_REPORT_OCA, iterations)) {
+			oca_report_start(OCA_REPORT_OCA);
+			oca_case_run<OCA_CASE_MORPHOLOGY>(src_image, cv::Mat(), dst_image);
+			oca_s = out_data[0]; //for suppress optimization
+			oca_case_charge<OCA_CASE_MORPHOLOGY>();
+			oca_report_stop(OCA_REPORT_OCA);
+			oca_report_accuracy(OCA_REPORT_OCA, dst_image);
+		}
+		oca_time = oca_report_median(OCA_REPORT_OCA);
 		printf("[OCA]%fmsec\n", oca_time);
 
 		/* [OCA]Write image data */
+		OCA_TRACE_BEGIN("imwrite", OCA_TRACE_CAT_IO);
 		imwrite(results / "OCA7_oca_out.png", dst_image);
+		OCA_TRACE_END("imwrite", OCA_TRACE_CAT_IO);
 		sync();
 		/* Wait to complete writing to storage */
 #if C_DELAY
@@ -656,8 +1009,6 @@ int32_t main(int32_t argc, char *argv[]) {
 #endif
 
 		printf("[CPU] / [OCA] = %f times\n\n", cpu_time / oca_time);
-		OCA_f[DRP_FUNC_ERODE] = OPENCVA_FUNC_NOCHANGE;
-		OCA_f[DRP_FUNC_DILATE] = OPENCVA_FUNC_NOCHANGE;
 	}
 
 
@@ -665,32 +1016,35 @@ int32_t main(int32_t argc, char *argv[]) {
 	/* [8]  filter2D   FHD(BGR) */
 	/****************************/
 	{
-		float kernel[9] = {-0.2, -0.2, -0.2, -0.2, 2.6, -0.2, -0.2, -0.2, -0.2};
-		cv::Mat unsharp(3, 3, CV_32FC1, kernel);
 		printf("[8] filter2D           FHD(BGR)\n");
 		cv::Mat src_image(SRC_HEIGHT,SRC_WIDTH, CV_8UC3);
 		cv::Mat dst_image(SRC_HEIGHT,SRC_WIDTH, CV_8UC3, out_data);
-		src_size = SRC_WIDTH * SRC_HEIGHT * 3;
-		dst_size = SRC_WIDTH * SRC_HEIGHT * 3;
+		oca_case_report<OCA_CASE_FILTER2D>();
 
 		/* Read image data */
+		OCA_TRACE_BEGIN("imread", OCA_TRACE_CAT_IO);
 		src_image = imread(in_file, cv::IMREAD_COLOR);
+		OCA_TRACE_END("imread", OCA_TRACE_CAT_IO);
 		sync();
 
 		/* Disable Opencv Accelerator */
-		OCA_f[DRP_FUNC_FILTER2D] = OPENCVA_FUNC_DISABLE;
-		OCA_Activate(&OCA_f[0]);
+		oca_case_activate<OCA_CASE_FILTER2D>(&OCA_f[0], OPENCVA_FUNC_DISABLE);
 
 		/* [CPU]Opencv start */
-		timespec_get(&start_time, TIME_UTC);
-		cv::filter2D(src_image, dst_image, -1, unsharp);
-		oca_s = out_data[0]; //for suppress optimization
-		timespec_get(&end_time, TIME_UTC);
-		cpu_time = timedifference_msec(start_time, end_time);
+		while (oca_report_next(OCA_REPORT_CPU, iterations)) {
+			oca_report_start(OCA_REPORT_CPU);
+			oca_case_run<OCA_CASE_FILTER2D>(src_image, cv::Mat(), dst_image);
+			oca_s = out_data[0]; //for suppress optimization
+			oca_report_stop(OCA_REPORT_CPU);
+		}
+		oca_report_reference(dst_image);
+		cpu_time = oca_report_median(OCA_REPORT_CPU);
 		printf("[CPU]%fmsec\n", cpu_time);
 
 		/* [CPU]Write image data */
+		OCA_TRACE_BEGIN("imwrite", OCA_TRACE_CAT_IO);
 		imwrite(results / "OCA8_cpu_out.png", dst_image);
+		OCA_TRACE_END("imwrite", OCA_TRACE_CAT_IO);
 		sync();
 		/* Wait to complete writing to storage */
 #if C_DELAY
@@ -698,19 +1052,24 @@ int32_t main(int32_t argc, char *argv[]) {
 #endif
 
 		/* Enable Opencv Accelerator */
-		OCA_f[DRP_FUNC_FILTER2D] = OPENCVA_FUNC_ENABLE;
-		OCA_Activate(&OCA_f[0]);
+		oca_case_activate<OCA_CASE_FILTER2D>(&OCA_f[0], OPENCVA_FUNC_ENABLE);
 
 		/* [OCA]Opencv start */
-		timespec_get(&start_time, TIME_UTC);
-		cv::filter2D(src_image, dst_image, -1, unsharp);
-		oca_s = out_data[0]; //for suppress optimization
-		timespec_get(&end_time, TIME_UTC);
-		oca_time = timedifference_msec(start_time, end_time);
+		while (oca_report_next(OCA_REPORT_OCA, iterations)) {
+			oca_report_start(OCA_REPORT_OCA);
+			oca_case_run<OCA_CASE_FILTER2D>(src_image, cv::Mat(), dst_image);
+			oca_s = out_data[0]; //for suppress optimization
+			oca_case_charge<OCA_CASE_FILTER2D>();
+			oca_report_stop(OCA_REPORT_OCA);
+			oca_report_accuracy(OCA_REPORT_OCA, dst_image);
+		}
+		oca_time = oca_report_median(OCA_REPORT_OCA);
 		printf("[OCA]%fmsec\n", oca_time);
 
 		/* [OCA]Write image data */
+		OCA_TRACE_BEGIN("imwrite", OCA_TRACE_CAT_IO);
 		imwrite(results / "OCA8_oca_out.png", dst_image);
+		OCA_TRACE_END("imwrite", OCA_TRACE_CAT_IO);
 		sync();
 		/* Wait to complete writing to storage */
 #if C_DELAY
@@ -718,7 +1077,6 @@ int32_t main(int32_t argc, char *argv[]) {
 #endif
 
 		printf("[CPU] / [OCA] = %f times\n\n", cpu_time / oca_time);
-		OCA_f[DRP_FUNC_FILTER2D] = OPENCVA_FUNC_NOCHANGE;
 	}
 
 
@@ -729,27 +1087,32 @@ int32_t main(int32_t argc, char *argv[]) {
 		printf("[9] Sobel              FHD(BGR)\n");
 		cv::Mat src_image(SRC_HEIGHT,SRC_WIDTH, CV_8UC3);
 		cv::Mat dst_image(SRC_HEIGHT,SRC_WIDTH, CV_8UC3, out_data);
-		src_size = SRC_WIDTH * SRC_HEIGHT * 3;
-		dst_size = SRC_WIDTH * SRC_HEIGHT * 3;
+		oca_case_report<OCA_CASE_SOBEL>();
 
 		/* Read image data */
+		OCA_TRACE_BEGIN("imread", OCA_TRACE_CAT_IO);
 		src_image = imread(in_file, cv::IMREAD_COLOR);
+		OCA_TRACE_END("imread", OCA_TRACE_CAT_IO);
 		sync();
 
 		/* Disable Opencv Accelerator */
-		OCA_f[DRP_FUNC_SOBEL] = OPENCVA_FUNC_DISABLE;
-		OCA_Activate(&OCA_f[0]);
+		oca_case_activate<OCA_CASE_SOBEL>(&OCA_f[0], OPENCVA_FUNC_DISABLE);
 
 		/* [CPU]Opencv start */
-		timespec_get(&start_time, TIME_UTC);
-		cv::Sobel(src_image, dst_image, -1, 1, 0);
-		oca_s = out_data[0]; //for suppress optimization
-		timespec_get(&end_time, TIME_UTC);
-		cpu_time = timedifference_msec(start_time, end_time);
+		while (oca_report_next(OCA_REPORT_CPU, iterations)) {
+			oca_report_start(OCA_REPORT_CPU);
+			oca_case_run<OCA_CASE_SOBEL>(src_image, cv::Mat(), dst_image);
+			oca_s = out_data[0]; //for suppress optimization
+			oca_report_stop(OCA_REPORT_CPU);
+		}
+		oca_report_reference(dst_image);
+		cpu_time = oca_report_median(OCA_REPORT_CPU);
 		printf("[CPU]%fmsec\n", cpu_time);
 
 		/* [CPU]Write image data */
+		OCA_TRACE_BEGIN("imwrite", OCA_TRACE_CAT_IO);
 		imwrite(results / "OCA9_cpu_out.png", dst_image);
+		OCA_TRACE_END("imwrite", OCA_TRACE_CAT_IO);
 		sync();
 		/* Wait to complete writing to storage */
 #if C_DELAY
@@ -757,19 +1120,24 @@ int32_t main(int32_t argc, char *argv[]) {
 #endif
 
 		/* Enable Opencv Accelerator */
-		OCA_f[DRP_FUNC_SOBEL] = OPENCVA_FUNC_ENABLE;
-		OCA_Activate(&OCA_f[0]);
+		oca_case_activate<OCA_CASE_SOBEL>(&OCA_f[0], OPENCVA_FUNC_ENABLE);
 
 		/* [OCA]Opencv start */
-		timespec_get(&start_time, TIME_UTC);
-		cv::Sobel(src_image, dst_image, -1, 1, 0);
-		oca_s = out_data[0]; //for suppress optimization
-		timespec_get(&end_time, TIME_UTC);
-		oca_time = timedifference_msec(start_time, end_time);
+		while (oca_report_next(OCA_REPORT_OCA, iterations)) {
+			oca_report_start(OCA_REPORT_OCA);
+			oca_case_run<OCA_CASE_SOBEL>(src_image, cv::Mat(), dst_image);
+			oca_s = out_data[0]; //for suppress optimization
+			oca_case_charge<OCA_CASE_SOBEL>();
+			oca_report_stop(OCA_REPORT_OCA);
+			oca_report_accuracy(OCA_REPORT_OCA, dst_image);
+		}
+		oca_time = oca_report_median(OCA_REPORT_OCA);
 		printf("[OCA]%fmsec\n", oca_time);
 
 		/* [OCA]Write image data */
+		OCA_TRACE_BEGIN("imwrite", OCA_TRACE_CAT_IO);
 		imwrite(results / "OCA9_oca_out.png", dst_image);
+		OCA_TRACE_END("imwrite", OCA_TRACE_CAT_IO);
 		sync();
 		/* Wait to complete writing to storage */
 #if C_DELAY
@@ -777,7 +1145,6 @@ int32_t main(int32_t argc, char *argv[]) {
 #endif
 
 		printf("[CPU] / [OCA] = %f times\n\n", cpu_time / oca_time);
-		OCA_f[DRP_FUNC_SOBEL] = OPENCVA_FUNC_NOCHANGE;
 	}
 
 
@@ -788,27 +1155,32 @@ int32_t main(int32_t argc, char *argv[]) {
 		printf("[10] adaptiveThreshold FHD(gray)[kernel= 99x99]\n");
 		cv::Mat src_image(SRC_HEIGHT,SRC_WIDTH, CV_8UC1);
 		cv::Mat dst_image(SRC_HEIGHT,SRC_WIDTH, CV_8UC1, out_data);
-		src_size = SRC_WIDTH * SRC_HEIGHT * 1;
-		dst_size = SRC_WIDTH * SRC_HEIGHT * 1;
+		oca_case_report<OCA_CASE_A_THRESHOLD>();
 
 		/* Read image data */
+		OCA_TRACE_BEGIN("imread", OCA_TRACE_CAT_IO);
 		src_image = imread(in_file, cv::IMREAD_GRAYSCALE);
+		OCA_TRACE_END("imread", OCA_TRACE_CAT_IO);
 		sync();
 
 		/* Disable Opencv Accelerator */
-		OCA_f[DRP_FUNC_A_THRESHOLD] = OPENCVA_FUNC_DISABLE;
-		OCA_Activate(&OCA_f[0]);
+		oca_case_activate<OCA_CASE_A_THRESHOLD>(&OCA_f[0], OPENCVA_FUNC_DISABLE);
 
 		/* [CPU]Opencv start */
-		timespec_get(&start_time, TIME_UTC);
-		cv::adaptiveThreshold(src_image, dst_image, 0xFF, cv::ADAPTIVE_THRESH_MEAN_C, cv::THRESH_BINARY, 99, 0);
-		oca_s = out_data[0]; //for suppress optimization
-		timespec_get(&end_time, TIME_UTC);
-		cpu_time = timedifference_msec(start_time, end_time);
+		while (oca_report_next(OCA_REPORT_CPU, iterations)) {
+			oca_report_start(OCA_REPORT_CPU);
+			oca_case_run<OCA_CASE_A_THRESHOLD>(src_image, cv::Mat(), dst_image);
+			oca_s = out_data[0]; //for suppress optimization
+			oca_report_stop(OCA_REPORT_CPU);
+		}
+		oca_report_reference(dst_image);
+		cpu_time = oca_report_median(OCA_REPORT_CPU);
 		printf("[CPU]%fmsec\n", cpu_time);
 
 		/* [CPU]Write image data */
+		OCA_TRACE_BEGIN("imwrite", OCA_TRACE_CAT_IO);
 		imwrite(results / "OCA10_cpu_out.png", dst_image);
+		OCA_TRACE_END("imwrite", OCA_TRACE_CAT_IO);
 		sync();
 		/* Wait to complete writing to storage */
 #if C_DELAY
@@ -816,19 +1188,24 @@ int32_t main(int32_t argc, char *argv[]) {
 #endif
 
 		/* Enable Opencv Accelerator */
-		OCA_f[DRP_FUNC_A_THRESHOLD] = OPENCVA_FUNC_ENABLE;
-		OCA_Activate(&OCA_f[0]);
+		oca_case_activate<OCA_CASE_A_THRESHOLD>(&OCA_f[0], OPENCVA_FUNC_ENABLE);
 
 		/* [OCA]Opencv start */
-		timespec_get(&start_time, TIME_UTC);
-		cv::adaptiveThreshold(src_image, dst_image, 0xFF, cv::ADAPTIVE_THRESH_MEAN_C, cv::THRESH_BINARY, 99, 0);
-		oca_s = out_data[0]; //for suppress optimization
-		timespec_get(&end_time, TIME_UTC);
-		oca_time = timedifference_msec(start_time, end_time);
+		while (oca_report_next(OCA_REPORT_OCA, iterations)) {
+			oca_report_start(OCA_REPORT_OCA);
+			oca_case_run<OCA_CASE_A_THRESHOLD>(src_image, cv::Mat(), dst_image);
+			oca_s = out_data[0]; //for suppress optimization
+			oca_case_charge<OCA_CASE_A_THRESHOLD>();
+			oca_report_stop(OCA_REPORT_OCA);
+			oca_report_accuracy(OCA_REPORT_OCA, dst_image);
+		}
+		oca_time = oca_report_median(OCA_REPORT_OCA);
 		printf("[OCA]%fmsec\n", oca_time);
 
 		/* [OCA]Write image data */
+		OCA_TRACE_BEGIN("imwrite", OCA_TRACE_CAT_IO);
 		imwrite(results / "OCA10_oca_out.png", dst_image);
+		OCA_TRACE_END("imwrite", OCA_TRACE_CAT_IO);
 		sync();
 		/* Wait to complete writing to storage */
 #if C_DELAY
@@ -836,7 +1213,6 @@ int32_t main(int32_t argc, char *argv[]) {
 #endif
 
 		printf("[CPU] / [OCA] = %f times\n\n", cpu_time / oca_time);
-		OCA_f[DRP_FUNC_A_THRESHOLD] = OPENCVA_FUNC_NOCHANGE;
 	}
 
 	/****************************************************/
@@ -849,11 +1225,12 @@ int32_t main(int32_t argc, char *argv[]) {
 		cv::Mat tpl_image(16, 16, CV_8UC3);
 		cv::Mat dst_image(360 - 16 + 1, 640 - 16 + 1, CV_32FC1, out_data);
 		cv::Mat out_image(SRC_HEIGHT,SRC_WIDTH, CV_8UC3);
-		src_size = SRC_WIDTH * SRC_HEIGHT * 3;
-		dst_size = SRC_WIDTH * SRC_HEIGHT * 3;
+		oca_case_report<OCA_CASE_TMPLEATMATCH>();
 
 		/* Read image data */
+		OCA_TRACE_BEGIN("imread", OCA_TRACE_CAT_IO);
 		tmp_image = imread(in_file, cv::IMREAD_COLOR);
+		OCA_TRACE_END("imread", OCA_TRACE_CAT_IO);
 		sync();
 
 		/* Crop src image(640x360) */
@@ -865,27 +1242,33 @@ int32_t main(int32_t argc, char *argv[]) {
 		tpl_image = tpl_image.clone();
 
 		/* Disable Opencv Accelerator */
-		OCA_f[DRP_FUNC_TMPLEATMATCH] = OPENCVA_FUNC_DISABLE;
-		OCA_Activate(&OCA_f[0]);
+		oca_case_activate<OCA_CASE_TMPLEATMATCH>(&OCA_f[0], OPENCVA_FUNC_DISABLE);
 
 		/* [CPU]Opencv start */
-		timespec_get(&start_time, TIME_UTC);
-		cv::matchTemplate(src_image, tpl_image, dst_image, cv::TM_SQDIFF);
-		oca_s = out_data[0]; //for suppress optimization
-		timespec_get(&end_time, TIME_UTC);
-		cpu_time = timedifference_msec(start_time, end_time);
+		while (oca_report_next(OCA_REPORT_CPU, iterations)) {
+			oca_report_start(OCA_REPORT_CPU);
+			oca_case_run<OCA_CASE_TMPLEATMATCH>(src_image, tpl_image, dst_image);
+			oca_s = out_data[0]; //for suppress optimization
+			oca_report_stop(OCA_REPORT_CPU);
+		}
+		oca_report_reference(dst_image);
+		cpu_time = oca_report_median(OCA_REPORT_CPU);
 		printf("[CPU]%fmsec\n", cpu_time); //
 		{
 			double min, max;
 			cv::Point min_p, max_p;
 			cv::minMaxLoc(dst_image, &min, &max, &min_p, &max_p);
+			OCA_TRACE_BEGIN("imread", OCA_TRACE_CAT_IO);
 			out_image = imread(in_file, cv::IMREAD_COLOR);
+			OCA_TRACE_END("imread", OCA_TRACE_CAT_IO);
 			cv::rectangle(out_image, {min_p.x + 800, min_p.y + 400}, {min_p.x + 816, min_p.y + 416}, {128, 0, 128}, 3);
 		}
 		oca_s = out_data[0]; //for suppress optimization
 
 		/* [CPU]Write image data */
+		OCA_TRACE_BEGIN("imwrite", OCA_TRACE_CAT_IO);
 		imwrite(results / "OCA11_cpu_out.png", out_image);
+		OCA_TRACE_END("imwrite", OCA_TRACE_CAT_IO);
 		sync();
 		/* Wait to complete writing to storage */
 #if C_DELAY
@@ -893,25 +1276,32 @@ int32_t main(int32_t argc, char *argv[]) {
 #endif
 
 		/* Enable Opencv Accelerator */
-		OCA_f[DRP_FUNC_TMPLEATMATCH] = OPENCVA_FUNC_ENABLE;
-		OCA_Activate(&OCA_f[0]);
+		oca_case_activate<OCA_CASE_TMPLEATMATCH>(&OCA_f[0], OPENCVA_FUNC_ENABLE);
 
 		/* [OCA]Opencv start */
-		timespec_get(&start_time, TIME_UTC);
-		cv::matchTemplate(src_image, tpl_image, dst_image, cv::TM_SQDIFF);
-		oca_s = out_data[0]; //for suppress optimization
-		timespec_get(&end_time, TIME_UTC);
-		oca_time = timedifference_msec(start_time, end_time);
+		while (oca_report_next(OCA_REPORT_OCA, iterations)) {
+			oca_report_start(OCA_REPORT_OCA);
+			oca_case_run<OCA_CASE_TMPLEATMATCH>(src_image, tpl_image, dst_image);
+			oca_s = out_data[0]; //for suppress optimization
+			oca_case_charge<OCA_CASE_TMPLEATMATCH>();
+			oca_report_stop(OCA_REPORT_OCA);
+			oca_report_accuracy(OCA_REPORT_OCA, dst_image);
+		}
+		oca_time = oca_report_median(OCA_REPORT_OCA);
 		printf("[OCA]%fmsec\n", oca_time); {
 			double min, max;
 			cv::Point min_p, max_p;
 			cv::minMaxLoc(dst_image, &min, &max, &min_p, &max_p);
+			OCA_TRACE_BEGIN("imread", OCA_TRACE_CAT_IO);
 			out_image = imread(in_file, cv::IMREAD_COLOR);
+			OCA_TRACE_END("imread", OCA_TRACE_CAT_IO);
 			cv::rectangle(out_image, {min_p.x + 800, min_p.y + 400}, {min_p.x + 816, min_p.y + 416}, {128, 128, 128}, 3);
 		}
 
 		/* [OCA]Write image data */
+		OCA_TRACE_BEGIN("imwrite", OCA_TRACE_CAT_IO);
 		imwrite(results / "OCA11_oca_out.png", out_image);
+		OCA_TRACE_END("imwrite", OCA_TRACE_CAT_IO);
 		sync();
 		/* Wait to complete writing to storage */
 #if C_DELAY
@@ -919,39 +1309,42 @@ int32_t main(int32_t argc, char *argv[]) {
 #endif
 
 		printf("[CPU] / [OCA] = %f times\n\n", cpu_time / oca_time);
-		OCA_f[DRP_FUNC_TMPLEATMATCH] = OPENCVA_FUNC_NOCHANGE;
 	}
 
 	/*******************************/
 	/* [12]  warpAffine   FHD(BGR) */
 	/*******************************/
 	{
-		float kernel[6] = {0.7071, -0.7071, 649, 0.7071, 0.7071, 510};
-		cv::Mat rotate45(2, 3, CV_32FC1, kernel);
+		const cv::Mat rotate45 = oca_case_matrix<OCA_CASE_AFFINE>({SRC_WIDTH, SRC_HEIGHT});
 		printf("[12] warpAffine          FHD(BGR)\n");
 		cv::Mat src_image(SRC_HEIGHT,SRC_WIDTH, CV_8UC3);
 		cv::Mat dst_image(SRC_HEIGHT,SRC_WIDTH, CV_8UC3, out_data);
-		src_size = SRC_WIDTH * SRC_HEIGHT * 3;
-		dst_size = SRC_WIDTH * SRC_HEIGHT * 3;
+		oca_case_report<OCA_CASE_AFFINE>();
 
 		/* Read image data */
+		OCA_TRACE_BEGIN("imread", OCA_TRACE_CAT_IO);
 		src_image = imread(in_file, cv::IMREAD_COLOR);
+		OCA_TRACE_END("imread", OCA_TRACE_CAT_IO);
 		sync();
 
 		/* Disable Opencv Accelerator */
-		OCA_f[DRP_FUNC_AFFINE] = OPENCVA_FUNC_DISABLE;
-		OCA_Activate(&OCA_f[0]);
+		oca_case_activate<OCA_CASE_AFFINE>(&OCA_f[0], OPENCVA_FUNC_DISABLE);
 
 		/* [CPU]Opencv start */
-		timespec_get(&start_time, TIME_UTC);
-		cv::warpAffine(src_image, dst_image, rotate45, {SRC_WIDTH,SRC_HEIGHT});
-		oca_s = out_data[0]; //for suppress optimization
-		timespec_get(&end_time, TIME_UTC);
-		cpu_time = timedifference_msec(start_time, end_time);
+		while (oca_report_next(OCA_REPORT_CPU, iterations)) {
+			oca_report_start(OCA_REPORT_CPU);
+			oca_case_run<OCA_CASE_AFFINE>(src_image, rotate45, dst_image);
+			oca_s = out_data[0]; //for suppress optimization
+			oca_report_stop(OCA_REPORT_CPU);
+		}
+		oca_report_reference(dst_image);
+		cpu_time = oca_report_median(OCA_REPORT_CPU);
 		printf("[CPU]%fmsec\n", cpu_time);
 
 		/* [CPU]Write image data */
+		OCA_TRACE_BEGIN("imwrite", OCA_TRACE_CAT_IO);
 		imwrite(results / "OCA12_cpu_out.png", dst_image);
+		OCA_TRACE_END("imwrite", OCA_TRACE_CAT_IO);
 		sync();
 		/* Wait to complete writing to storage */
 #if C_DELAY
@@ -959,19 +1352,24 @@ int32_t main(int32_t argc, char *argv[]) {
 #endif
 
 		/* Enable Opencv Accelerator */
-		OCA_f[DRP_FUNC_AFFINE] = OPENCVA_FUNC_ENABLE;
-		OCA_Activate(&OCA_f[0]);
+		oca_case_activate<OCA_CASE_AFFINE>(&OCA_f[0], OPENCVA_FUNC_ENABLE);
 
 		/* [OCA]Opencv start */
-		timespec_get(&start_time, TIME_UTC);
-		cv::warpAffine(src_image, dst_image, rotate45, {SRC_WIDTH,SRC_HEIGHT});
-		oca_s = out_data[0]; //for suppress optimization
-		timespec_get(&end_time, TIME_UTC);
-		oca_time = timedifference_msec(start_time, end_time);
+		while (oca_report_next(OCA_REPORT_OCA, iterations)) {
+			oca_report_start(OCA_REPORT_OCA);
+			oca_case_run<OCA_CASE_AFFINE>(src_image, rotate45, dst_image);
+			oca_s = out_data[0]; //for suppress optimization
+			oca_case_charge<OCA_CASE_AFFINE>();
+			oca_report_stop(OCA_REPORT_OCA);
+			oca_report_accuracy(OCA_REPORT_OCA, dst_image);
+		}
+		oca_time = oca_report_median(OCA_REPORT_OCA);
 		printf("[OCA]%fmsec\n", oca_time);
 
 		/* [OCA]Write image data */
+		OCA_TRACE_BEGIN("imwrite", OCA_TRACE_CAT_IO);
 		imwrite(results / "OCA12_oca_out.png", dst_image);
+		OCA_TRACE_END("imwrite", OCA_TRACE_CAT_IO);
 		sync();
 		/* Wait to complete writing to storage */
 #if C_DELAY
@@ -979,7 +1377,6 @@ int32_t main(int32_t argc, char *argv[]) {
 #endif
 
 		printf("[CPU] / [OCA] = %f times\n\n", cpu_time / oca_time);
-		OCA_f[DRP_FUNC_AFFINE] = OPENCVA_FUNC_NOCHANGE;
 	}
 
 
@@ -987,32 +1384,36 @@ int32_t main(int32_t argc, char *argv[]) {
 	/* [13]  warpPerspective   FHD(BGR) */
 	/************************************/
 	{
-		float kernel[9] = {0.5, 0.2, 20, -0.1, 0.8, 50, -0.001, 0.001, 1.0};
-		cv::Mat perspective(3, 3, CV_32FC1, kernel);
+		const cv::Mat perspective = oca_case_matrix<OCA_CASE_PERSPECTIVE>({SRC_WIDTH, SRC_HEIGHT});
 		printf("[13] warpPerspective         FHD(BGR)\n");
 		cv::Mat src_image(SRC_HEIGHT,SRC_WIDTH, CV_8UC3);
 		cv::Mat dst_image(SRC_HEIGHT,SRC_WIDTH, CV_8UC3, out_data);
-		src_size = SRC_WIDTH * SRC_HEIGHT * 3;
-		dst_size = SRC_WIDTH * SRC_HEIGHT * 3;
+		oca_case_report<OCA_CASE_PERSPECTIVE>();
 
 		/* Read image data */
+		OCA_TRACE_BEGIN("imread", OCA_TRACE_CAT_IO);
 		src_image = imread(in_file, cv::IMREAD_COLOR);
+		OCA_TRACE_END("imread", OCA_TRACE_CAT_IO);
 		sync();
 
 		/* Disable Opencv Accelerator */
-		OCA_f[DRP_FUNC_PERSPECTIVE] = OPENCVA_FUNC_DISABLE;
-		OCA_Activate(&OCA_f[0]);
+		oca_case_activate<OCA_CASE_PERSPECTIVE>(&OCA_f[0], OPENCVA_FUNC_DISABLE);
 
 		/* [CPU]Opencv start */
-		timespec_get(&start_time, TIME_UTC);
-		cv::warpPerspective(src_image, dst_image, perspective, {SRC_WIDTH,SRC_HEIGHT});
-		oca_s = out_data[0]; //for suppress optimization
-		timespec_get(&end_time, TIME_UTC);
-		cpu_time = timedifference_msec(start_time, end_time);
+		while (oca_report_next(OCA_REPORT_CPU, iterations)) {
+			oca_report_start(OCA_REPORT_CPU);
+			oca_case_run<OCA_CASE_PERSPECTIVE>(src_image, perspective, dst_image);
+			oca_s = out_data[0]; //for suppress optimization
+			oca_report_stop(OCA_REPORT_CPU);
+		}
+		oca_report_reference(dst_image);
+		cpu_time = oca_report_median(OCA_REPORT_CPU);
 		printf("[CPU]%fmsec\n", cpu_time);
 
 		/* [CPU]Write image data */
+		OCA_TRACE_BEGIN("imwrite", OCA_TRACE_CAT_IO);
 		imwrite(results / "OCA13_cpu_out.png", dst_image);
+		OCA_TRACE_END("imwrite", OCA_TRACE_CAT_IO);
 		sync();
 		/* Wait to complete writing to storage */
 #if C_DELAY
@@ -1020,19 +1421,24 @@ int32_t main(int32_t argc, char *argv[]) {
 #endif
 
 		/* Enable Opencv Accelerator */
-		OCA_f[DRP_FUNC_PERSPECTIVE] = OPENCVA_FUNC_ENABLE;
-		OCA_Activate(&OCA_f[0]);
+		oca_case_activate<OCA_CASE_PERSPECTIVE>(&OCA_f[0], OPENCVA_FUNC_ENABLE);
 
 		/* [OCA]Opencv start */
-		timespec_get(&start_time, TIME_UTC);
-		cv::warpPerspective(src_image, dst_image, perspective, {SRC_WIDTH,SRC_HEIGHT});
-		oca_s = out_data[0]; //for suppress optimization
-		timespec_get(&end_time, TIME_UTC);
-		oca_time = timedifference_msec(start_time, end_time);
+		while (oca_report_next(OCA_REPORT_OCA, iterations)) {
+			oca_report_start(OCA_REPORT_OCA);
+			oca_case_run<OCA_CASE_PERSPECTIVE>(src_image, perspective, dst_image);
+			oca_s = out_data[0]; //for suppress optimization
+			oca_case_charge<OCA_CASE_PERSPECTIVE>();
+			oca_report_stop(OCA_REPORT_OCA);
+			oca_report_accuracy(OCA_REPORT_OCA, dst_image);
+		}
+		oca_time = oca_report_median(OCA_REPORT_OCA);
 		printf("[OCA]%fmsec\n", oca_time);
 
 		/* [OCA]Write image data */
+		OCA_TRACE_BEGIN("imwrite", OCA_TRACE_CAT_IO);
 		imwrite(results / "OCA13_oca_out.png", dst_image);
+		OCA_TRACE_END("imwrite", OCA_TRACE_CAT_IO);
 		sync();
 		/* Wait to complete writing to storage */
 #if C_DELAY
@@ -1040,7 +1446,6 @@ int32_t main(int32_t argc, char *argv[]) {
 #endif
 
 		printf("[CPU] / [OCA] = %f times\n\n", cpu_time / oca_time);
-		OCA_f[DRP_FUNC_PERSPECTIVE] = OPENCVA_FUNC_NOCHANGE;
 	}
 
 
@@ -1051,27 +1456,32 @@ int32_t main(int32_t argc, char *argv[]) {
 		printf("[14] pyrDown           FHD(BGR) -> QFHD(BGR)    \n");
 		cv::Mat src_image(SRC_HEIGHT,SRC_WIDTH, CV_8UC3);
 		cv::Mat dst_image((SRC_HEIGHT / 2), (SRC_WIDTH / 2), CV_8UC3, out_data);
-		src_size = SRC_WIDTH * SRC_HEIGHT * 3;
-		dst_size = (SRC_WIDTH / 2) * (SRC_HEIGHT / 2) * 3;
+		oca_case_report<OCA_CASE_PYR_DOWN>();
 
 		/* Read image data */
+		OCA_TRACE_BEGIN("imread", OCA_TRACE_CAT_IO);
 		src_image = imread(in_file, cv::IMREAD_COLOR);
+		OCA_TRACE_END("imread", OCA_TRACE_CAT_IO);
 		sync();
 
 		/* Disable Opencv Accelerator */
-		OCA_f[DRP_FUNC_PYR_DOWN] = OPENCVA_FUNC_DISABLE;
-		OCA_Activate(&OCA_f[0]);
+		oca_case_activate<OCA_CASE_PYR_DOWN>(&OCA_f[0], OPENCVA_FUNC_DISABLE);
 
 		/* [CPU]Opencv start */
-		timespec_get(&start_time, TIME_UTC);
-		cv::pyrDown(src_image, dst_image);
-		oca_s = out_data[0]; //for suppress optimization
-		timespec_get(&end_time, TIME_UTC);
-		cpu_time = timedifference_msec(start_time, end_time);
+		while (oca_report_next(OCA_REPORT_CPU, iterations)) {
+			oca_report_start(OCA_REPORT_CPU);
+			oca_case_run<OCA_CASE_PYR_DOWN>(src_image, cv::Mat(), dst_image);
+			oca_s = out_data[0]; //for suppress optimization
+			oca_report_stop(OCA_REPORT_CPU);
+		}
+		oca_report_reference(dst_image);
+		cpu_time = oca_report_median(OCA_REPORT_CPU);
 		printf("[CPU]%fmsec\n", cpu_time);
 
 		/* [CPU]Write image data */
+		OCA_TRACE_BEGIN("imwrite", OCA_TRACE_CAT_IO);
 		imwrite(results / "OCA14_cpu_out.png", dst_image);
+		OCA_TRACE_END("imwrite", OCA_TRACE_CAT_IO);
 		copy_file(results / "OCA14_cpu_out.png", resources / "small.png",  std::filesystem::copy_options::overwrite_existing);
 		sync();
 		/* Wait to complete writing to storage */
@@ -1080,19 +1490,24 @@ int32_t main(int32_t argc, char *argv[]) {
 #endif
 
 		/* Enable Opencv Accelerator */
-		OCA_f[DRP_FUNC_PYR_DOWN] = OPENCVA_FUNC_ENABLE;
-		OCA_Activate(&OCA_f[0]);
+		oca_case_activate<OCA_CASE_PYR_DOWN>(&OCA_f[0], OPENCVA_FUNC_ENABLE);
 
 		/* [OCA]Opencv start */
-		timespec_get(&start_time, TIME_UTC);
-		cv::pyrDown(src_image, dst_image);
-		oca_s = out_data[0]; //for suppress optimization
-		timespec_get(&end_time, TIME_UTC);
-		oca_time = timedifference_msec(start_time, end_time);
+		while (oca_report_next(OCA_REPORT_OCA, iterations)) {
+			oca_report_start(OCA_REPORT_OCA);
+			oca_case_run<OCA_CASE_PYR_DOWN>(src_image, cv::Mat(), dst_image);
+			oca_s = out_data[0]; //for suppress optimization
+			oca_case_charge<OCA_CASE_PYR_DOWN>();
+			oca_report_stop(OCA_REPORT_OCA);
+			oca_report_accuracy(OCA_REPORT_OCA, dst_image);
+		}
+		oca_time = oca_report_median(OCA_REPORT_OCA);
 		printf("[OCA]%fmsec\n", oca_time);
 
 		/* [OCA]Write image data */
+		OCA_TRACE_BEGIN("imwrite", OCA_TRACE_CAT_IO);
 		imwrite(results / "OCA14_oca_out.png", dst_image);
+		OCA_TRACE_END("imwrite", OCA_TRACE_CAT_IO);
 		sync();
 		/* Wait to complete writing to storage */
 #if C_DELAY
@@ -1100,7 +1515,6 @@ int32_t main(int32_t argc, char *argv[]) {
 #endif
 
 		printf("[CPU] / [OCA] = %f times\n\n", cpu_time / oca_time);
-		OCA_f[DRP_FUNC_PYR_DOWN] = OPENCVA_FUNC_NOCHANGE;
 	}
 
 
@@ -1111,27 +1525,32 @@ int32_t main(int32_t argc, char *argv[]) {
 		printf("[15] pyrUp              QFHD(BGR) -> FHD(BGR)    \n");
 		cv::Mat src_image((SRC_HEIGHT / 2), (SRC_WIDTH / 2), CV_8UC3);
 		cv::Mat dst_image(SRC_HEIGHT,SRC_WIDTH, CV_8UC3, out_data);
-		src_size = (SRC_WIDTH / 2) * (SRC_HEIGHT / 2) * 3;
-		dst_size = SRC_WIDTH * SRC_HEIGHT * 3;
+		oca_case_report<OCA_CASE_PYR_UP>();
 
 		/* Read image data */
+		OCA_TRACE_BEGIN("imread", OCA_TRACE_CAT_IO);
 		src_image = imread("OCA14_cpu_out.png", cv::IMREAD_COLOR);
+		OCA_TRACE_END("imread", OCA_TRACE_CAT_IO);
 		sync();
 
 		/* Disable Opencv Accelerator */
-		OCA_f[DRP_FUNC_PYR_UP] = OPENCVA_FUNC_DISABLE;
-		OCA_Activate(&OCA_f[0]);
+		oca_case_activate<OCA_CASE_PYR_UP>(&OCA_f[0], OPENCVA_FUNC_DISABLE);
 
 		/* [CPU]Opencv start */
-		timespec_get(&start_time, TIME_UTC);
-		cv::pyrUp(src_image, dst_image);
-		oca_s = out_data[0]; //for suppress optimization
-		timespec_get(&end_time, TIME_UTC);
-		cpu_time = timedifference_msec(start_time, end_time);
+		while (oca_report_next(OCA_REPORT_CPU, iterations)) {
+			oca_report_start(OCA_REPORT_CPU);
+			oca_case_run<OCA_CASE_PYR_UP>(src_image, cv::Mat(), dst_image);
+			oca_s = out_data[0]; //for suppress optimization
+			oca_report_stop(OCA_REPORT_CPU);
+		}
+		oca_report_reference(dst_image);
+		cpu_time = oca_report_median(OCA_REPORT_CPU);
 		printf("[CPU]%fmsec\n", cpu_time);
 
 		/* [CPU]Write image data */
+		OCA_TRACE_BEGIN("imwrite", OCA_TRACE_CAT_IO);
 		imwrite(results / "OCA15_cpu_out.png", dst_image);
+		OCA_TRACE_END("imwrite", OCA_TRACE_CAT_IO);
 		sync();
 		/* Wait to complete writing to storage */
 #if C_DELAY
@@ -1139,19 +1558,24 @@ int32_t main(int32_t argc, char *argv[]) {
 #endif
 
 		/* Enable Opencv Accelerator */
-		OCA_f[DRP_FUNC_PYR_UP] = OPENCVA_FUNC_ENABLE;
-		OCA_Activate(&OCA_f[0]);
+		oca_case_activate<OCA_CASE_PYR_UP>(&OCA_f[0], OPENCVA_FUNC_ENABLE);
 
 		/* [OCA]Opencv start */
-		timespec_get(&start_time, TIME_UTC);
-		cv::pyrUp(src_image, dst_image);
-		oca_s = out_data[0]; //for suppress optimization
-		timespec_get(&end_time, TIME_UTC);
-		oca_time = timedifference_msec(start_time, end_time);
+		while (oca_report_next(OCA_REPORT_OCA, iterations)) {
+			oca_report_start(OCA_REPORT_OCA);
+			oca_case_run<OCA_CASE_PYR_UP>(src_image, cv::Mat(), dst_image);
+			oca_s = out_data[0]; //for suppress optimization
+			oca_case_charge<OCA_CASE_PYR_UP>();
+			oca_report_stop(OCA_REPORT_OCA);
+			oca_report_accuracy(OCA_REPORT_OCA, dst_image);
+		}
+		oca_time = oca_report_median(OCA_REPORT_OCA);
 		printf("[OCA]%fmsec\n", oca_time);
 
 		/* [OCA]Write image data */
+		OCA_TRACE_BEGIN("imwrite", OCA_TRACE_CAT_IO);
 		imwrite(results / "OCA15_oca_out.png", dst_image);
+		OCA_TRACE_END("imwrite", OCA_TRACE_CAT_IO);
 		sync();
 		/* Wait to complete writing to storage */
 #if C_DELAY
@@ -1159,9 +1583,17 @@ int32_t main(int32_t argc, char *argv[]) {
 #endif
 
 		printf("[CPU] / [OCA] = %f times\n\n", cpu_time / oca_time);
-		OCA_f[DRP_FUNC_PYR_UP] = OPENCVA_FUNC_NOCHANGE;
 	}
 
+	/* Machine-readable results */
+	oca_report_write(results, iterations);
+	if (fix_inexact) {
+		std::cerr << "Error: fixed-point GaussianBlur differs from the CPU path for " << fix_inexact << " kernel sizes"
+				  << std::endl;
+		return sample_finish(results, -1);
+	}
+	sample_finish(results, 0);
+
 	printf("[END] Complete!!\n");
 	return 0;
 }
@@ -43,5 +43,45 @@
 #include <cstring>
 #include <float.h>
 #include <math.h>
+#include <time.h>
+
+/*****************************************
+* Macros
+******************************************/
+/* OpenCVA Circuit Number */
+#define DRP_FUNC_NUM            (16)
+#define DRP_FUNC_RESIZE         (0)
+#define DRP_FUNC_CVT_YUV2BGR    (2)
+#define DRP_FUNC_CVT_NV2BGR     (2)
+#define DRP_FUNC_GAUSSIAN       (4)
+#define DRP_FUNC_DILATE         (5)
+#define DRP_FUNC_ERODE          (6)
+#define DRP_FUNC_FILTER2D       (7)
+#define DRP_FUNC_SOBEL          (8)
+#define DRP_FUNC_A_THRESHOLD    (9)
+#define DRP_FUNC_TMPLEATMATCH   (10)
+#define DRP_FUNC_AFFINE         (11)
+#define DRP_FUNC_PYR_DOWN       (12)
+#define DRP_FUNC_PYR_UP         (13)
+#define DRP_FUNC_PERSPECTIVE    (14)
+
+/* OpenCVA Activate */
+#define OPENCVA_FUNC_DISABLE    (0)
+#define OPENCVA_FUNC_ENABLE     (1)
+#define OPENCVA_FUNC_NOCHANGE   (2)
+
+/* DRP device node, present when the accelerator is available */
+#define OCA_DRP_DEVICE          "/dev/drp1"
+
+/*****************************************
+* Global Variables
+******************************************/
+/* for suppress optimization */
+extern volatile int oca_s;
+
+/*****************************************
+* Functions
+******************************************/
+double timedifference_msec(struct timespec t0, struct timespec t1);
 
 #endif
@@ -0,0 +1,234 @@
+/***********************************************************************************************************************
+* Copyright (C) 2024 Renesas Electronics Corporation. All rights reserved.
+***********************************************************************************************************************/
+/***********************************************************************************************************************
+* File Name    : gaussian_fixed.h
+* Version      : 1.00
+* Description  : Compile-time specialized fixed-point GaussianBlur (ksize 3/5/7/9, sigma 0) for CV_8U images.
+*                Output is bit-exact with the 8-bit fixed-point path of cv::GaussianBlur (BORDER_REFLECT_101).
+***********************************************************************************************************************/
+
+#ifndef GAUSSIAN_FIXED_H
+#define GAUSSIAN_FIXED_H
+
+/*****************************************
+* Includes
+******************************************/
+#include <stdint.h>
+#include <cstring>
+#include <algorithm>
+#include <utility>
+#include <vector>
+#include <opencv2/core.hpp>
+#include <opencv2/core/hal/intrin.hpp>
+
+/*****************************************
+* Kernel coefficients
+* cv::GaussianBlur uses the binomial tables below for sigma <= 0 and converts them
+* to ufixedpoint16 (8 fractional bits), so every tap is an exact integer in Q8.
+******************************************/
+template<int KSIZE> struct gaussian_q8;
+template<> struct gaussian_q8<3> { static constexpr uint16_t coeff[3] = {64, 128, 64}; };
+template<> struct gaussian_q8<5> { static constexpr uint16_t coeff[5] = {16, 64, 96, 64, 16}; };
+template<> struct gaussian_q8<7> { static constexpr uint16_t coeff[7] = {8, 28, 56, 72, 56, 28, 8}; };
+template<> struct gaussian_q8<9> { static constexpr uint16_t coeff[9] = {4, 13, 30, 51, 60, 51, 30, 13, 4}; };
+
+template<int KSIZE>
+constexpr int gaussian_q8_sum() {
+	int sum = 0;
+	for (int i = 0; i < KSIZE; i++) {
+		sum += gaussian_q8<KSIZE>::coeff[i];
+	}
+	return sum;
+}
+
+static_assert(gaussian_q8_sum<3>() == 256, "3x3 kernel must sum to 1.0 in Q8");
+static_assert(gaussian_q8_sum<5>() == 256, "5x5 kernel must sum to 1.0 in Q8");
+static_assert(gaussian_q8_sum<7>() == 256, "7x7 kernel must sum to 1.0 in Q8");
+static_assert(gaussian_q8_sum<9>() == 256, "9x9 kernel must sum to 1.0 in Q8");
+
+/*****************************************
+* Function Name : gaussian_reflect101
+* Description   : map an out-of-range index to BORDER_REFLECT_101 (gfedcb|abcdefgh|gfedcba)
+* Arguments     : i = index
+*                 n = length of the line
+* Return value  : index in [0, n)
+******************************************/
+static inline int gaussian_reflect101(int i, int n) {
+	if (i < 0) {
+		return -i;
+	}
+	if (i >= n) {
+		return 2 * n - 2 - i;
+	}
+	return i;
+}
+
+/*****************************************
+* Function Name : gaussian_hline_px
+* Description   : horizontal pass for one element, Q8 result (max 255 * 256, never saturates)
+******************************************/
+template<int KSIZE, int... J>
+static inline uint16_t gaussian_hline_px(const uint8_t *p, int cn, std::integer_sequence<int, J...>) {
+	constexpr const uint16_t *k = gaussian_q8<KSIZE>::coeff;
+	constexpr int R = KSIZE / 2;
+	uint32_t s = (uint32_t)k[R] * p[R * cn];
+	((s += (uint32_t)k[J] * (p[J * cn] + p[(KSIZE - 1 - J) * cn])), ...);
+	return (uint16_t)s;
+}
+
+/*****************************************
+* Function Name : gaussian_vline_px
+* Description   : vertical pass for one element, Q16 sum rounded back to 8 bit
+******************************************/
+template<int KSIZE, int... J>
+static inline uint8_t gaussian_vline_px(const uint16_t *const *h, int i, std::integer_sequence<int, J...>) {
+	constexpr const uint16_t *k = gaussian_q8<KSIZE>::coeff;
+	uint32_t s = 0;
+	((s += (uint32_t)k[J] * h[J][i]), ...);
+	s = (s + (1u << 15)) >> 16;
+	return (uint8_t)(s > 255 ? 255 : s);
+}
+
+#if CV_SIMD128
+/*****************************************
+* Function Name : gaussian_hline_v
+* Description   : horizontal pass for 8 consecutive interleaved elements.
+*                 Taps are cn elements apart, so BGR needs no channel shuffles.
+*                 The kernel is symmetric: mirrored taps are summed before the multiply.
+******************************************/
+template<int KSIZE, int... J>
+static inline cv::v_uint16x8 gaussian_hline_v(const uint8_t *p, int cn, std::integer_sequence<int, J...>) {
+	constexpr const uint16_t *k = gaussian_q8<KSIZE>::coeff;
+	constexpr int R = KSIZE / 2;
+	cv::v_uint16x8 s = cv::v_load_expand(p + R * cn) * cv::v_setall_u16(k[R]);
+	((s = s + (cv::v_load_expand(p + J * cn) + cv::v_load_expand(p + (KSIZE - 1 - J) * cn)) * cv::v_setall_u16(k[J])), ...);
+	return s;
+}
+
+/*****************************************
+* Function Name : gaussian_vline_v
+* Description   : vertical pass for 8 elements, widened to 32 bit and rounded as ufixedpoint32 -> uchar
+******************************************/
+template<int KSIZE, int... J>
+static inline void gaussian_vline_v(const uint16_t *const *h, int i, uint8_t *d, std::integer_sequence<int, J...>) {
+	constexpr const uint16_t *k = gaussian_q8<KSIZE>::coeff;
+	cv::v_uint32x4 lo = cv::v_setzero_u32(), hi = cv::v_setzero_u32();
+	cv::v_uint32x4 a, b;
+	((cv::v_mul_expand(cv::v_load(h[J] + i), cv::v_setall_u16(k[J]), a, b), lo = lo + a, hi = hi + b), ...);
+	cv::v_pack_store(d + i, cv::v_rshr_pack<16>(lo, hi));
+}
+#endif
+
+/*****************************************
+* Function Name : gaussian_hline
+* Description   : horizontal pass over a whole row
+* Arguments     : src = source row
+*                 pad = scratch, (width + KSIZE - 1) * cn elements
+*                 dst = Q8 output row, width * cn elements
+*                 width, cn = row geometry
+******************************************/
+template<int KSIZE>
+static void gaussian_hline(const uint8_t *src, uint8_t *pad, uint16_t *dst, int width, int cn) {
+	constexpr int R = KSIZE / 2;
+	const int len = width * cn;
+
+	/* Build the reflected border once per row so the inner loop has no branches */
+	memcpy(pad + R * cn, src, len);
+	for (int x = 1; x <= R; x++) {
+		memcpy(pad + (R - x) * cn, src + gaussian_reflect101(-x, width) * cn, cn);
+		memcpy(pad + (R + width - 1 + x) * cn, src + gaussian_reflect101(width - 1 + x, width) * cn, cn);
+	}
+
+	int i = 0;
+#if CV_SIMD128
+	for (; i <= len - 8; i += 8) {
+		cv::v_store(dst + i, gaussian_hline_v<KSIZE>(pad + i, cn, std::make_integer_sequence<int, R>{}));
+	}
+#endif
+	for (; i < len; i++) {
+		dst[i] = gaussian_hline_px<KSIZE>(pad + i, cn, std::make_integer_sequence<int, R>{});
+	}
+}
+
+/*****************************************
+* Function Name : gaussian_vline
+* Description   : vertical pass over a whole row
+* Arguments     : h = KSIZE Q8 rows, top to bottom
+*                 dst = destination row
+*                 len = elements per row
+******************************************/
+template<int KSIZE>
+static void gaussian_vline(const uint16_t *const *h, uint8_t *dst, int len) {
+	int i = 0;
+#if CV_SIMD128
+	for (; i <= len - 8; i += 8) {
+		gaussian_vline_v<KSIZE>(h, i, dst, std::make_integer_sequence<int, KSIZE>{});
+	}
+#endif
+	for (; i < len; i++) {
+		dst[i] = gaussian_vline_px<KSIZE>(h, i, std::make_integer_sequence<int, KSIZE>{});
+	}
+}
+
+/*****************************************
+* Function Name : gaussian_blur_fixed
+* Description   : separable fixed-point GaussianBlur with a compile-time kernel.
+*                 Rows are split into one stripe per thread; each stripe keeps a
+*                 ring of KSIZE horizontally filtered rows.
+* Arguments     : src = CV_8U image, any channel count, larger than KSIZE/2 in both directions
+*                 dst = output image, (re)allocated to src size/type
+******************************************/
+template<int KSIZE>
+void gaussian_blur_fixed(const cv::Mat &src_in, cv::Mat &dst) {
+	constexpr int R = KSIZE / 2;
+	CV_Assert(src_in.depth() == CV_8U && src_in.rows > R && src_in.cols > R);
+
+	cv::Mat src = (src_in.data == dst.data) ? src_in.clone() : src_in;
+	dst.create(src.size(), src.type());
+
+	const int rows = src.rows;
+	const int width = src.cols;
+	const int cn = src.channels();
+	const int len = width * cn;
+
+	cv::parallel_for_(cv::Range(0, rows), [&](const cv::Range &range) {
+		std::vector<uint16_t> ring((size_t)KSIZE * len);
+		std::vector<uint8_t> pad((size_t)(width + 2 * R) * cn);
+		const uint16_t *h[KSIZE];
+
+		for (int y = range.start - R, t = 0; y < range.end + R; y++, t++) {
+			gaussian_hline<KSIZE>(src.ptr<uint8_t>(gaussian_reflect101(y, rows)), pad.data(),
+								  ring.data() + (size_t)(t % KSIZE) * len, width, cn);
+			if (t < KSIZE - 1) {
+				continue;
+			}
+			for (int j = 0; j < KSIZE; j++) {
+				h[j] = ring.data() + (size_t)((t - KSIZE + 1 + j) % KSIZE) * len;
+			}
+			gaussian_vline<KSIZE>(h, dst.ptr<uint8_t>(y - R), len);
+		}
+	}, (double)std::max(1, cv::getNumThreads()));
+}
+
+/*****************************************
+* Function Name : gaussian_blur_fixed
+* Description   : runtime entry to the specialized kernels
+* Arguments     : src, dst = as above
+*                 ksize = square kernel size
+* Return value  : true if handled, false if the caller must fall back to cv::GaussianBlur
+******************************************/
+static inline bool gaussian_blur_fixed(const cv::Mat &src, cv::Mat &dst, int ksize) {
+	if (src.depth() != CV_8U || src.rows <= ksize / 2 || src.cols <= ksize / 2) {
+		return false;
+	}
+	switch (ksize) {
+		case 3: gaussian_blur_fixed<3>(src, dst); return true;
+		case 5: gaussian_blur_fixed<5>(src, dst); return true;
+		case 7: gaussian_blur_fixed<7>(src, dst); return true;
+		case 9: gaussian_blur_fixed<9>(src, dst); return true;
+		default: return false;
+	}
+}
+
+#endif
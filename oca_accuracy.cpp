@@ -0,0 +1,216 @@
+/***********************************************************************************************************************
+* Copyright (C) 2024 Renesas Electronics Corporation. All rights reserved.
+***********************************************************************************************************************/
+/***********************************************************************************************************************
+* File Name    : oca_accuracy.cpp
+* Version      : 1.00
+* Description  : In-memory comparison of an OCA (or fallback) output against the CPU reference with per-op tolerances
+***********************************************************************************************************************/
+
+/*****************************************
+* Includes
+******************************************/
+#include "define.h"
+#include "oca_accuracy.h"
+#include <algorithm>
+#include <mutex>
+#include <opencv2/core/hal/intrin.hpp>
+
+/*****************************************
+* Global Variables
+******************************************/
+/* Starting points for the DRP circuits: interpolating ops differ by rounding, morphology should be exact.
+   Tune per board / BSP release. The last entry is the default for unlisted ops. */
+static const oca_tolerance accuracy_tolerance[] = {
+	/* op                  abs  mismatch  psnr   rel    argmin */
+	{"resize",              2,  0.01,     40.0,  0,     false},
+	{"cvtColor",            2,  0.01,     40.0,  0,     false},
+	{"cvtColorTwoPlane",    2,  0.01,     40.0,  0,     false},
+	{"GaussianBlur",        1,  0.01,     45.0,  0,     false},
+	{"dilate",              0,  0.001,    50.0,  0,     false},
+	{"erode",               0,  0.001,    50.0,  0,     false},
+	{"morphologyEx",        0,  0.001,    50.0,  0,     false},
+	{"filter2D",            1,  0.01,     40.0,  0,     false},
+	{"Sobel",               1,  0.01,     40.0,  0,     false},
+	{"adaptiveThreshold",   0,  0.01,     20.0,  0,     false},
+	{"matchTemplate",       0,  0.001,    40.0,  1E-3,  true},
+	{"warpAffine",          2,  0.02,     30.0,  0,     false},
+	{"warpPerspective",     2,  0.02,     30.0,  0,     false},
+	{"pyrDown",             1,  0.01,     40.0,  0,     false},
+	{"pyrUp",               1,  0.01,     40.0,  0,     false},
+	{"",                    1,  0.01,     40.0,  1E-3,  false},
+};
+
+/*****************************************
+* Function Name : oca_accuracy_tolerance
+* Description   : tolerance of an op, the default entry if not listed
+******************************************/
+const oca_tolerance &oca_accuracy_tolerance(const char *op) {
+	const size_t n = sizeof(accuracy_tolerance) / sizeof(accuracy_tolerance[0]);
+	for (size_t i = 0; i + 1 < n; i++) {
+		if (strcmp(accuracy_tolerance[i].op, op) == 0) {
+			return accuracy_tolerance[i];
+		}
+	}
+	return accuracy_tolerance[n - 1];
+}
+
+/*****************************************
+* Function Name : compare_row_u8
+* Description   : max difference, mismatches above tol and squared error of one row; diff row if not null
+******************************************/
+static void compare_row_u8(const uint8_t *a, const uint8_t *b, int len, int tol, uint8_t *diff, int &max_abs,
+						   uint64_t &mismatched, uint64_t &sse) {
+	int i = 0;
+	int vmax_abs = 0;
+	uint64_t vmismatched = 0, vsse = 0;
+#if CV_SIMD128
+	/* Lane sums are per row: no overflow below 256K elements per row */
+	cv::v_uint8x16 vtol = cv::v_setall_u8((uint8_t)tol);
+	cv::v_uint8x16 vone = cv::v_setall_u8(1);
+	cv::v_uint8x16 vmax = cv::v_setzero_u8();
+	cv::v_uint16x8 vcount = cv::v_setzero_u16();
+	cv::v_uint32x4 vsq = cv::v_setzero_u32();
+	for (; i <= len - 16; i += 16) {
+		cv::v_uint8x16 d = cv::v_absdiff(cv::v_load(a + i), cv::v_load(b + i));
+		cv::v_uint16x8 d0, d1, c0, c1;
+		cv::v_uint32x4 s0, s1;
+		vmax = cv::v_max(vmax, d);
+		cv::v_expand((d > vtol) & vone, c0, c1);
+		vcount = vcount + c0 + c1;
+		cv::v_expand(d, d0, d1);
+		cv::v_mul_expand(d0, d0, s0, s1);
+		vsq = vsq + s0 + s1;
+		cv::v_mul_expand(d1, d1, s0, s1);
+		vsq = vsq + s0 + s1;
+		if (diff) {
+			cv::v_store(diff + i, d);
+		}
+	}
+	cv::v_uint16x8 m0, m1;
+	cv::v_uint32x4 n0, n1;
+	cv::v_expand(vmax, m0, m1);
+	cv::v_expand(vcount, n0, n1);
+	vmax_abs = cv::v_reduce_max(cv::v_max(m0, m1));
+	vmismatched = cv::v_reduce_sum(n0 + n1);
+	vsse = cv::v_reduce_sum(vsq);
+#endif
+	for (; i < len; i++) {
+		int d = std::abs((int)a[i] - (int)b[i]);
+		vmax_abs = std::max(vmax_abs, d);
+		vmismatched += (d > tol);
+		vsse += (uint64_t)(d * d);
+		if (diff) {
+			diff[i] = (uint8_t)d;
+		}
+	}
+	max_abs = std::max(max_abs, vmax_abs);
+	mismatched += vmismatched;
+	sse += vsse;
+}
+
+/*****************************************
+* Function Name : oca_accuracy_compare
+* Description   : compare out against ref, row stripes in parallel. 8-bit: max-abs-diff, mismatches, PSNR.
+*                 Float (matchTemplate): also relative error and agreement of the minimum location.
+* Arguments     : ref = CPU reference
+*                 out = output under test, same size and type
+*                 tol = limits
+*                 result = output
+*                 heatmap = if not null, per-pixel difference (max over channels) as a color map
+* Return value  : 0 on success, -1 if size or type differ (result.pass is false)
+******************************************/
+int oca_accuracy_compare(const cv::Mat &ref, const cv::Mat &out, const oca_tolerance &tol, oca_accuracy &result,
+						 cv::Mat *heatmap) {
+	std::mutex lock;
+	cv::Mat diff;
+	double peak = 0, sse = 0;
+	int max_abs = 0;
+
+	result = oca_accuracy();
+	result.argmin_match = true;
+	if (ref.size() != out.size() || ref.type() != out.type() || ref.empty()) {
+		return -1;
+	}
+	const int len = ref.cols * ref.channels();
+	result.total = (uint64_t)ref.rows * (uint64_t)len;
+	if (heatmap) {
+		diff.create(ref.rows, ref.cols, ref.depth() == CV_8U ? ref.type() : CV_MAKETYPE(CV_32F, ref.channels()));
+	}
+
+	if (ref.depth() == CV_8U) {
+		cv::parallel_for_(cv::Range(0, ref.rows), [&](const cv::Range &range) {
+			int m = 0;
+			uint64_t n = 0, s = 0;
+			for (int y = range.start; y < range.end; y++) {
+				compare_row_u8(ref.ptr<uint8_t>(y), out.ptr<uint8_t>(y), len, tol.max_abs,
+							   heatmap ? diff.ptr<uint8_t>(y) : nullptr, m, n, s);
+			}
+			std::lock_guard<std::mutex> guard(lock);
+			max_abs = std::max(max_abs, m);
+			result.mismatched += n;
+			sse += (double)s;
+		});
+		result.max_abs = max_abs;
+		peak = 255;
+	} else if (ref.depth() == CV_32F) {
+		cv::parallel_for_(cv::Range(0, ref.rows), [&](const cv::Range &range) {
+			double m = 0, r = 0, s = 0, p = 0;
+			uint64_t n = 0;
+			for (int y = range.start; y < range.end; y++) {
+				const float *a = ref.ptr<float>(y);
+				const float *b = out.ptr<float>(y);
+				float *d = heatmap ? diff.ptr<float>(y) : nullptr;
+				for (int i = 0; i < len; i++) {
+					double e = fabs((double)a[i] - (double)b[i]);
+					double rel = e / std::max(fabs((double)a[i]), (double)FLT_MIN);
+					m = std::max(m, e);
+					r = std::max(r, rel);
+					p = std::max(p, fabs((double)a[i]));
+					n += (rel > tol.max_rel);
+					s += e * e;
+					if (d) {
+						d[i] = (float)e;
+					}
+				}
+			}
+			std::lock_guard<std::mutex> guard(lock);
+			result.max_abs = std::max(result.max_abs, m);
+			result.max_rel = std::max(result.max_rel, r);
+			result.mismatched += n;
+			sse += s;
+			peak = std::max(peak, p);
+		});
+		if (tol.argmin && ref.channels() == 1) {
+			cv::Point ref_loc, out_loc;
+			cv::minMaxLoc(ref, nullptr, nullptr, &ref_loc);
+			cv::minMaxLoc(out, nullptr, nullptr, &out_loc);
+			result.argmin_match = (ref_loc.x == out_loc.x && ref_loc.y == out_loc.y);
+		}
+	} else {
+		return -1;
+	}
+
+	double mse = sse / (double)result.total;
+	result.psnr = (mse > 0 && peak > 0) ? 10.0 * log10(peak * peak / mse) : INFINITY;
+	result.pass = (double)result.mismatched <= tol.max_mismatch * (double)result.total && result.psnr >= tol.min_psnr &&
+				  result.argmin_match;
+
+	if (heatmap) {
+		cv::Mat gray;
+		if (diff.channels() > 1) {
+			std::vector<cv::Mat> planes;
+			cv::split(diff, planes);
+			gray = planes[0];
+			for (size_t c = 1; c < planes.size(); c++) {
+				cv::max(gray, planes[c], gray);
+			}
+		} else {
+			gray = diff;
+		}
+		/* Full scale = largest difference, so small errors stay visible */
+		gray.convertTo(gray, CV_8U, result.max_abs > 0 ? 255.0 / result.max_abs : 0);
+		cv::applyColorMap(gray, *heatmap, cv::COLORMAP_JET);
+	}
+	return 0;
+}
@@ -0,0 +1,50 @@
+/***********************************************************************************************************************
+* Copyright (C) 2024 Renesas Electronics Corporation. All rights reserved.
+***********************************************************************************************************************/
+/***********************************************************************************************************************
+* File Name    : oca_accuracy.h
+* Version      : 1.00
+* Description  : In-memory comparison of an OCA (or fallback) output against the CPU reference with per-op tolerances
+***********************************************************************************************************************/
+
+#ifndef OCA_ACCURACY_H
+#define OCA_ACCURACY_H
+
+/*****************************************
+* Includes
+******************************************/
+#include <stdint.h>
+#include <opencv2/opencv.hpp>
+
+/*****************************************
+* Typedefs
+******************************************/
+/* Pass limits of one op. 8-bit outputs use the absolute limits, float outputs the relative ones */
+struct oca_tolerance {
+	const char *op;
+	int max_abs;                        /* element difference not counted as a mismatch */
+	double max_mismatch;                /* allowed fraction of mismatched elements */
+	double min_psnr;                    /* dB */
+	double max_rel;                     /* float: relative error not counted as a mismatch */
+	bool argmin;                        /* float: best match location must agree (TM_SQDIFF) */
+};
+
+/* Result of one comparison */
+struct oca_accuracy {
+	double max_abs;                     /* largest element difference */
+	double max_rel;                     /* float: largest relative error */
+	uint64_t mismatched;                /* elements above the tolerance */
+	uint64_t total;                     /* elements compared */
+	double psnr;                        /* dB, INFINITY if identical; float: peak = largest |reference| */
+	bool argmin_match;                  /* float: minimum at the same location (true for 8-bit) */
+	bool pass;
+};
+
+/*****************************************
+* Functions
+******************************************/
+const oca_tolerance &oca_accuracy_tolerance(const char *op);
+int oca_accuracy_compare(const cv::Mat &ref, const cv::Mat &out, const oca_tolerance &tol, oca_accuracy &result,
+						 cv::Mat *heatmap);
+
+#endif
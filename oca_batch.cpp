@@ -0,0 +1,315 @@
+/***********************************************************************************************************************
+* Copyright (C) 2024 Renesas Electronics Corporation. All rights reserved.
+***********************************************************************************************************************/
+/***********************************************************************************************************************
+* File Name    : oca_batch.cpp
+* Version      : 1.00
+* Description  : Batched small-image execution (resize / GaussianBlur / matchTemplate) to amortize accelerator overhead
+***********************************************************************************************************************/
+
+/*****************************************
+* Includes
+******************************************/
+#include "define.h"
+#include "oca_batch.h"
+#include "oca_op_table.h"
+#include "oca_report.h"
+#include "oca_sim.h"
+#include <algorithm>
+#include <numeric>
+
+/*****************************************
+* Macros
+******************************************/
+#define BATCH_MAX               (256)
+#define BATCH_ROI_WIDTH         (160)
+#define BATCH_ROI_HEIGHT        (120)
+#define BATCH_TPL_SIZE          (16)
+#define BATCH_RESIZE_SCALE      (0.5)
+#define BATCH_GAUSSIAN_KSIZE    (7)
+
+/*****************************************
+* Global Variables
+******************************************/
+/* Benchmarked cases */
+static const int batch_ops[] = {OCA_CASE_RESIZE, OCA_CASE_GAUSSIAN, OCA_CASE_TMPLEATMATCH};
+
+/*****************************************
+* Function Name : oca_atlas_pack
+* Description   : shelf-pack ROIs into one image. Each ROI is surrounded by a gutter
+*                 filled with border_type so neighbourhood ops see the same border
+*                 they would see on the isolated ROI.
+* Arguments     : rois = input images, all of the same type
+*                 gutter = minimum border width in pixels on every side
+*                 border_type = cv::BorderTypes used to fill the gutter
+*                 atlas = packed output (reused across calls)
+*                 align = slot origins are multiples of align; the gutter is widened to match
+* Return value  : -
+******************************************/
+void oca_atlas_pack(const std::vector<cv::Mat> &rois, int gutter, int border_type, oca_atlas &atlas,
+					cv::Size align) {
+	std::vector<cv::Rect> slots(rois.size());
+	std::vector<size_t> order(rois.size());
+	const int gx = (gutter + align.width - 1) / align.width * align.width;
+	const int gy = (gutter + align.height - 1) / align.height * align.height;
+	int width = OCA_ATLAS_WIDTH;
+	int x = 0, y = 0, shelf = 0;
+
+	CV_Assert(!rois.empty() && align.width > 0 && align.height > 0);
+	for (const cv::Mat &roi: rois) {
+		CV_Assert(roi.type() == rois[0].type());
+		width = std::max(width, roi.cols + 2 * gx);
+	}
+	width = (width + align.width - 1) / align.width * align.width;
+
+	/* Tallest first keeps shelves dense */
+	std::iota(order.begin(), order.end(), 0);
+	std::stable_sort(order.begin(), order.end(), [&](size_t a, size_t b) { return rois[a].rows > rois[b].rows; });
+	for (size_t i: order) {
+		/* Cell sizes are multiples of align, so every cell origin stays aligned */
+		int w = (rois[i].cols + 2 * gx + align.width - 1) / align.width * align.width;
+		int h = (rois[i].rows + 2 * gy + align.height - 1) / align.height * align.height;
+		if (x + w > width) {
+			x = 0;
+			y += shelf;
+			shelf = 0;
+		}
+		slots[i] = cv::Rect(x + gx, y + gy, rois[i].cols, rois[i].rows);
+		x += w;
+		shelf = std::max(shelf, h);
+	}
+
+	/* Clear unused area only when the layout changes */
+	if (slots != atlas.slots || atlas.image.type() != rois[0].type() ||
+		atlas.image.rows != y + shelf || atlas.image.cols != width) {
+		atlas.image.create(y + shelf, width, rois[0].type());
+		atlas.image.setTo(cv::Scalar::all(0));
+		atlas.slots = slots;
+	}
+
+	for (size_t i = 0; i < rois.size(); i++) {
+		const cv::Rect &s = atlas.slots[i];
+		if (gx > 0 || gy > 0) {
+			cv::Mat dst = atlas.image(cv::Rect(s.x - gx, s.y - gy, s.width + 2 * gx, s.height + 2 * gy));
+			cv::copyMakeBorder(rois[i], dst, gy, gy, gx, gx, border_type);
+		} else {
+			rois[i].copyTo(atlas.image(s));
+		}
+	}
+}
+
+/*****************************************
+* Function Name : oca_batch_resize
+* Description   : resize every ROI by the same factors.
+*                 Atlas mode pads each ROI with replicated pixels and aligns the slots
+*                 to ceil(1 / f) pixels, so every ROI is sampled with the same phase as
+*                 a per-ROI call. Results are identical when 1 / fx and 1 / fy are
+*                 integers (downscaling by 2, 4, ...).
+* Arguments     : src = input ROIs
+*                 dst = output ROIs (allocated)
+*                 fx, fy = scale factors
+*                 interpolation = cv::InterpolationFlags
+*                 mode = OCA_BATCH_QUEUE / OCA_BATCH_ATLAS
+*                 atlas = workspace
+* Return value  : -
+******************************************/
+void oca_batch_resize(const std::vector<cv::Mat> &src, std::vector<cv::Mat> &dst, double fx, double fy,
+					  int interpolation, int mode, oca_atlas &atlas) {
+	dst.resize(src.size());
+	if (mode == OCA_BATCH_QUEUE) {
+		for (size_t i = 0; i < src.size(); i++) {
+			cv::resize(src[i], dst[i], {}, fx, fy, interpolation);
+		}
+		return;
+	}
+
+	cv::Size align((int)ceil(1.0 / fx), (int)ceil(1.0 / fy));
+	int gutter = std::max(align.width, align.height) + 1;
+	cv::Mat out;
+	oca_atlas_pack(src, gutter, cv::BORDER_REPLICATE, atlas, align);
+	cv::resize(atlas.image, out, {}, fx, fy, interpolation);
+	for (size_t i = 0; i < src.size(); i++) {
+		const cv::Rect &s = atlas.slots[i];
+		cv::Rect r(cvRound(s.x * fx), cvRound(s.y * fy), cvRound(s.width * fx), cvRound(s.height * fy));
+		out(r & cv::Rect(0, 0, out.cols, out.rows)).copyTo(dst[i]);
+	}
+}
+
+/*****************************************
+* Function Name : oca_batch_gaussian
+* Description   : GaussianBlur (sigma 0) every ROI. Atlas gutters are filled with
+*                 BORDER_REFLECT_101, so results are identical to per-ROI calls.
+* Arguments     : src = input ROIs
+*                 dst = output ROIs (allocated)
+*                 ksize = square kernel size
+*                 mode = OCA_BATCH_QUEUE / OCA_BATCH_ATLAS
+*                 atlas = workspace
+* Return value  : -
+******************************************/
+void oca_batch_gaussian(const std::vector<cv::Mat> &src, std::vector<cv::Mat> &dst, int ksize, int mode,
+						oca_atlas &atlas) {
+	dst.resize(src.size());
+	if (mode == OCA_BATCH_QUEUE) {
+		for (size_t i = 0; i < src.size(); i++) {
+			cv::GaussianBlur(src[i], dst[i], {ksize, ksize}, 0, 0);
+		}
+		return;
+	}
+
+	cv::Mat out;
+	oca_atlas_pack(src, ksize / 2, cv::BORDER_REFLECT_101, atlas);
+	cv::GaussianBlur(atlas.image, out, {ksize, ksize}, 0, 0);
+	for (size_t i = 0; i < src.size(); i++) {
+		out(atlas.slots[i]).copyTo(dst[i]);
+	}
+}
+
+/*****************************************
+* Function Name : oca_batch_match
+* Description   : matchTemplate one template over every ROI. In atlas mode only
+*                 positions whose window lies inside a slot are scattered back;
+*                 values agree with per-ROI calls up to float rounding.
+* Arguments     : src = search ROIs
+*                 tpl = template
+*                 dst = CV_32FC1 score maps (allocated)
+*                 method = cv::TemplateMatchModes
+*                 mode = OCA_BATCH_QUEUE / OCA_BATCH_ATLAS
+*                 atlas = workspace
+* Return value  : -
+******************************************/
+void oca_batch_match(const std::vector<cv::Mat> &src, const cv::Mat &tpl, std::vector<cv::Mat> &dst, int method,
+					 int mode, oca_atlas &atlas) {
+	dst.resize(src.size());
+	if (mode == OCA_BATCH_QUEUE) {
+		for (size_t i = 0; i < src.size(); i++) {
+			cv::matchTemplate(src[i], tpl, dst[i], method);
+		}
+		return;
+	}
+
+	cv::Mat out;
+	oca_atlas_pack(src, 0, cv::BORDER_CONSTANT, atlas);
+	cv::matchTemplate(atlas.image, tpl, out, method);
+	for (size_t i = 0; i < src.size(); i++) {
+		const cv::Rect &s = atlas.slots[i];
+		out(cv::Rect(s.x, s.y, s.width - tpl.cols + 1, s.height - tpl.rows + 1)).copyTo(dst[i]);
+	}
+}
+
+/*****************************************
+* Function Name : batch_run
+* Description   : run one benchmarked op over a batch
+* Arguments     : id = OCA_CASE_RESIZE / OCA_CASE_GAUSSIAN / OCA_CASE_TMPLEATMATCH
+*                 mode = OCA_BATCH_QUEUE / OCA_BATCH_ATLAS
+* Return value  : -
+******************************************/
+static void batch_run(int id, const std::vector<cv::Mat> &src, const cv::Mat &tpl, std::vector<cv::Mat> &dst,
+					  int mode, oca_atlas &atlas) {
+	OCA_SIM_BEGIN();
+	switch (id) {
+		case OCA_CASE_RESIZE:
+			oca_batch_resize(src, dst, BATCH_RESIZE_SCALE, BATCH_RESIZE_SCALE, cv::INTER_LINEAR, mode, atlas);
+			break;
+		case OCA_CASE_GAUSSIAN:
+			oca_batch_gaussian(src, dst, BATCH_GAUSSIAN_KSIZE, mode, atlas);
+			break;
+		default:
+			oca_batch_match(src, tpl, dst, cv::TM_SQDIFF, mode, atlas);
+			break;
+	}
+	oca_s = dst[0].data[0]; //for suppress optimization
+#if OCA_SIM
+	/* One circuit call per ROI, or one over the whole atlas */
+	size_t in_bytes = 0, out_bytes = 0;
+	for (size_t i = 0; i < src.size(); i++) {
+		if (mode == OCA_BATCH_QUEUE) {
+			OCA_SIM_CHARGE(oca_op_table[id].drp[0], src[i].total() * src[i].elemSize(),
+						   dst[i].total() * dst[i].elemSize(), 1);
+		}
+		out_bytes += dst[i].total() * dst[i].elemSize();
+	}
+	if (mode == OCA_BATCH_ATLAS) {
+		in_bytes = atlas.image.total() * atlas.image.elemSize();
+		OCA_SIM_CHARGE(oca_op_table[id].drp[0], in_bytes, out_bytes, 1);
+	}
+#endif
+	OCA_SIM_END();
+}
+
+/*****************************************
+* Function Name : oca_batch_benchmark
+* Description   : per-ROI cost of resize / GaussianBlur / matchTemplate at batch
+*                 sizes 1..256 on CPU and OCA, for three dispatch patterns:
+*                 loop  = OCA_Activate + call per ROI
+*                 queue = one OCA_Activate, one call per ROI
+*                 atlas = one OCA_Activate, one call on the packed atlas
+* Arguments     : image = source frame the ROIs are cropped from
+*                 OCA_f = OCA_Activate function list
+* Return value  : -
+******************************************/
+void oca_batch_benchmark(const cv::Mat &image, unsigned long *OCA_f) {
+	struct timespec t0, t1;
+	std::vector<cv::Mat> rois(BATCH_MAX);
+	std::vector<cv::Mat> dst, ref;
+	oca_atlas atlas;
+
+	/* Crop ROIs on a grid over the frame, cloned so each one is an isolated image */
+	for (int i = 0; i < BATCH_MAX; i++) {
+		int x = (i * 97) % (image.cols - BATCH_ROI_WIDTH);
+		int y = (i * 53) % (image.rows - BATCH_ROI_HEIGHT);
+		rois[i] = image(cv::Rect(x, y, BATCH_ROI_WIDTH, BATCH_ROI_HEIGHT)).clone();
+	}
+	cv::Mat tpl = rois[0](cv::Rect(BATCH_ROI_WIDTH / 2, BATCH_ROI_HEIGHT / 2, BATCH_TPL_SIZE, BATCH_TPL_SIZE)).clone();
+
+	printf("[BATCH] ROI %dx%d(BGR), msec/ROI\n", BATCH_ROI_WIDTH, BATCH_ROI_HEIGHT);
+	for (int id: batch_ops) {
+		const oca_op_desc &desc = oca_op_table[id];
+		printf("[BATCH] %s\n", desc.name);
+		printf("    n   [CPU]loop  [CPU]queue  [CPU]atlas   [OCA]loop  [OCA]queue  [OCA]atlas\n");
+		for (int n = 1; n <= BATCH_MAX; n *= 2) {
+			std::vector<cv::Mat> batch(rois.begin(), rois.begin() + n);
+			double t_loop[OCA_REPORT_CPU_OCA_NUM], t_queue[OCA_REPORT_CPU_OCA_NUM], t_atlas[OCA_REPORT_CPU_OCA_NUM];
+
+			for (int path = OCA_REPORT_CPU; path <= OCA_REPORT_OCA; path++) {
+				unsigned long state = path == OCA_REPORT_OCA ? OPENCVA_FUNC_ENABLE : OPENCVA_FUNC_DISABLE;
+
+				/* loop: activation per ROI */
+				timespec_get(&t0, TIME_UTC);
+				for (int i = 0; i < n; i++) {
+					oca_op_activate(OCA_f, desc, state);
+					batch_run(id, std::vector<cv::Mat>(1, batch[i]), tpl, dst, OCA_BATCH_QUEUE, atlas);
+				}
+				timespec_get(&t1, TIME_UTC);
+				t_loop[path] = timedifference_msec(t0, t1) / n;
+
+				/* queue: single activation */
+				timespec_get(&t0, TIME_UTC);
+				oca_op_activate(OCA_f, desc, state);
+				batch_run(id, batch, tpl, ref, OCA_BATCH_QUEUE, atlas);
+				timespec_get(&t1, TIME_UTC);
+				t_queue[path] = timedifference_msec(t0, t1) / n;
+
+				/* atlas: single activation, single call */
+				timespec_get(&t0, TIME_UTC);
+				oca_op_activate(OCA_f, desc, state);
+				batch_run(id, batch, tpl, dst, OCA_BATCH_ATLAS, atlas);
+				timespec_get(&t1, TIME_UTC);
+				t_atlas[path] = timedifference_msec(t0, t1) / n;
+			}
+
+			printf("  %3d  %10.4f  %10.4f  %10.4f  %10.4f  %10.4f  %10.4f\n", n,
+				   t_loop[OCA_REPORT_CPU], t_queue[OCA_REPORT_CPU], t_atlas[OCA_REPORT_CPU],
+				   t_loop[OCA_REPORT_OCA], t_queue[OCA_REPORT_OCA], t_atlas[OCA_REPORT_OCA]);
+		}
+
+		/* Atlas vs queue agreement on the last (OCA) batch; a size mismatch is a failure */
+		double diff = 0;
+		for (size_t i = 0; i < dst.size(); i++) {
+			diff = std::max(diff, dst[i].size() == ref[i].size() ? cv::norm(dst[i], ref[i], cv::NORM_INF) : INFINITY);
+		}
+		printf("[BATCH] %s atlas max diff %f\n\n", desc.name, diff);
+		if (id != OCA_CASE_TMPLEATMATCH && diff > 0) {
+			std::cerr << "Error: " << desc.name << " atlas output differs from per-ROI calls" << std::endl;
+		}
+	}
+}
@@ -0,0 +1,51 @@
+/***********************************************************************************************************************
+* Copyright (C) 2024 Renesas Electronics Corporation. All rights reserved.
+***********************************************************************************************************************/
+/***********************************************************************************************************************
+* File Name    : oca_batch.h
+* Version      : 1.00
+* Description  : Batched small-image execution (resize / GaussianBlur / matchTemplate) to amortize accelerator overhead
+***********************************************************************************************************************/
+
+#ifndef OCA_BATCH_H
+#define OCA_BATCH_H
+
+/*****************************************
+* Includes
+******************************************/
+#include <vector>
+#include <opencv2/opencv.hpp>
+
+/*****************************************
+* Macros
+******************************************/
+/* Batch execution mode */
+#define OCA_BATCH_QUEUE         (0)     /* one call per ROI, caller activates once */
+#define OCA_BATCH_ATLAS         (1)     /* ROIs packed into one atlas, one call */
+
+/* Default atlas width (pixels), ROIs wider than this get their own shelf width */
+#define OCA_ATLAS_WIDTH         (1920)
+
+/*****************************************
+* Typedefs
+******************************************/
+/* Packed atlas. Reused between calls: unchanged layouts skip clearing the image */
+struct oca_atlas {
+	cv::Mat image;                  /* packed ROIs including gutters */
+	std::vector<cv::Rect> slots;    /* placement of each ROI inside image, gutter excluded */
+};
+
+/*****************************************
+* Functions
+******************************************/
+void oca_atlas_pack(const std::vector<cv::Mat> &rois, int gutter, int border_type, oca_atlas &atlas,
+					cv::Size align = cv::Size(1, 1));
+void oca_batch_resize(const std::vector<cv::Mat> &src, std::vector<cv::Mat> &dst, double fx, double fy,
+					  int interpolation, int mode, oca_atlas &atlas);
+void oca_batch_gaussian(const std::vector<cv::Mat> &src, std::vector<cv::Mat> &dst, int ksize, int mode,
+						oca_atlas &atlas);
+void oca_batch_match(const std::vector<cv::Mat> &src, const cv::Mat &tpl, std::vector<cv::Mat> &dst, int method,
+					 int mode, oca_atlas &atlas);
+void oca_batch_benchmark(const cv::Mat &image, unsigned long *OCA_f);
+
+#endif
@@ -0,0 +1,269 @@
+/***********************************************************************************************************************
+* Copyright (C) 2024 Renesas Electronics Corporation. All rights reserved.
+***********************************************************************************************************************/
+/***********************************************************************************************************************
+* File Name    : oca_client.cpp
+* Version      : 1.00
+* Description  : Client side of the accelerator-arbitration server
+***********************************************************************************************************************/
+
+/*****************************************
+* Includes
+******************************************/
+#include "define.h"
+#include "oca_server.h"
+#include "oca_accuracy.h"
+#include <iostream>
+#include <sys/socket.h>
+#include <sys/un.h>
+
+/*****************************************
+* Macros
+******************************************/
+#define CLIENT_BENCH_REQUESTS   (8)
+
+/*****************************************
+* Function Name : oca_shm_alloc
+* Description   : create a memfd buffer and map it
+* Return value  : 0 on success, negative errno on failure
+******************************************/
+int oca_shm_alloc(oca_shm_buffer &buf, size_t size) {
+	int fd = memfd_create("oca_shm_buffer", MFD_CLOEXEC);
+	if (fd < 0) {
+		return -errno;
+	}
+	if (ftruncate(fd, (off_t)size) < 0) {
+		int err = -errno;
+		close(fd);
+		return err;
+	}
+	void *p = mmap(nullptr, size, PROT_READ | PROT_WRITE, MAP_SHARED, fd, 0);
+	if (p == MAP_FAILED) {
+		int err = -errno;
+		close(fd);
+		return err;
+	}
+	buf.fd = fd;
+	buf.ptr = static_cast<uint8_t *>(p);
+	buf.size = size;
+	return 0;
+}
+
+/*****************************************
+* Function Name : oca_shm_free
+* Description   : unmap and close a memfd buffer
+******************************************/
+void oca_shm_free(oca_shm_buffer &buf) {
+	if (buf.ptr) {
+		munmap(buf.ptr, buf.size);
+	}
+	if (buf.fd >= 0) {
+		close(buf.fd);
+	}
+	buf = oca_shm_buffer();
+}
+
+/*****************************************
+* Function Name : oca_shm_mat
+* Description   : cv::Mat header over an image inside a shared buffer (no copy)
+******************************************/
+cv::Mat oca_shm_mat(const oca_shm_buffer &buf, const oca_srv_image &img) {
+	return cv::Mat((int)img.rows, (int)img.cols, (int)img.type, buf.ptr + img.offset, img.step);
+}
+
+/*****************************************
+* Function Name : oca_srv_image_desc
+* Description   : describe a continuous image at offset
+******************************************/
+oca_srv_image oca_srv_image_desc(int rows, int cols, int type, uint64_t offset) {
+	oca_srv_image img;
+	img.rows = (uint32_t)rows;
+	img.cols = (uint32_t)cols;
+	img.type = (uint32_t)type;
+	img.step = (uint32_t)(cols * CV_ELEM_SIZE(type));
+	img.offset = offset;
+	return img;
+}
+
+/*****************************************
+* Function Name : oca_client_connect
+* Description   : connect to the server socket
+* Return value  : 0 on success, negative errno on failure
+******************************************/
+int oca_client_connect(oca_client &client, const char *path) {
+	struct sockaddr_un addr = {};
+	int sock = socket(AF_UNIX, SOCK_SEQPACKET | SOCK_CLOEXEC, 0);
+	if (sock < 0) {
+		return -errno;
+	}
+	addr.sun_family = AF_UNIX;
+	strncpy(addr.sun_path, path, sizeof(addr.sun_path) - 1);
+	if (connect(sock, reinterpret_cast<struct sockaddr *>(&addr), sizeof(addr)) < 0) {
+		int err = -errno;
+		close(sock);
+		return err;
+	}
+	client.sock = sock;
+	return 0;
+}
+
+/*****************************************
+* Function Name : oca_client_close
+* Description   : close the connection
+******************************************/
+void oca_client_close(oca_client &client) {
+	if (client.sock >= 0) {
+		close(client.sock);
+	}
+	client = oca_client();
+}
+
+/*****************************************
+* Function Name : oca_client_submit
+* Description   : queue a request without waiting. Buffers must stay mapped until
+*                 the matching reply arrives.
+* Arguments     : req = request, magic and id are filled in here
+*                 src, dst = shared buffers passed by fd
+* Return value  : request id, or negative errno on failure
+******************************************/
+int oca_client_submit(oca_client &client, oca_srv_request &req, const oca_shm_buffer &src, const oca_shm_buffer &dst) {
+	int fds[2] = {src.fd, dst.fd};
+	char ctrl[CMSG_SPACE(sizeof(fds))] = {};
+	struct iovec iov = {&req, sizeof(req)};
+	struct msghdr msg = {};
+
+	req.magic = OCA_SRV_MAGIC;
+	req.id = client.next_id++;
+	msg.msg_iov = &iov;
+	msg.msg_iovlen = 1;
+	msg.msg_control = ctrl;
+	msg.msg_controllen = sizeof(ctrl);
+	struct cmsghdr *cmsg = CMSG_FIRSTHDR(&msg);
+	cmsg->cmsg_level = SOL_SOCKET;
+	cmsg->cmsg_type = SCM_RIGHTS;
+	cmsg->cmsg_len = CMSG_LEN(sizeof(fds));
+	memcpy(CMSG_DATA(cmsg), fds, sizeof(fds));
+
+	if (sendmsg(client.sock, &msg, MSG_NOSIGNAL) != (ssize_t)sizeof(req)) {
+		return -errno;
+	}
+	return (int)req.id;
+}
+
+/*****************************************
+* Function Name : oca_client_wait
+* Description   : receive the next reply (replies may arrive out of submit order)
+* Return value  : 0 on success, negative errno on failure
+******************************************/
+int oca_client_wait(oca_client &client, oca_srv_reply &reply) {
+	ssize_t n = recv(client.sock, &reply, sizeof(reply), 0);
+	if (n != (ssize_t)sizeof(reply)) {
+		return n < 0 ? -errno : -EPIPE;
+	}
+	if (reply.magic != OCA_SRV_MAGIC) {
+		return -EPROTO;
+	}
+	return 0;
+}
+
+/*****************************************
+* Function Name : oca_client_benchmark
+* Description   : pipeline interleaved resize / warpAffine requests to a running
+*                 oca_server and check every result against the local CPU path
+* Arguments     : image = FHD BGR source
+* Return value  : 0 if all results match, -1 otherwise
+******************************************/
+int oca_client_benchmark(const cv::Mat &image) {
+	const double m[6] = {0.7071, -0.7071, 649, 0.7071, 0.7071, 510};
+	/* Connection and shared buffers, released on every return */
+	struct client_resources {
+		oca_client client;
+		oca_shm_buffer src, dst[CLIENT_BENCH_REQUESTS];
+		~client_resources() {
+			for (oca_shm_buffer &b: dst) {
+				oca_shm_free(b);
+			}
+			oca_shm_free(src);
+			oca_client_close(client);
+		}
+	} res;
+	oca_client &client = res.client;
+	oca_shm_buffer &src = res.src, *dst = res.dst;
+	oca_srv_request req[CLIENT_BENCH_REQUESTS] = {};
+	struct timespec t0, t1;
+	int ret = oca_client_connect(client, OCA_SRV_SOCKET);
+	if (ret < 0) {
+		std::cerr << "Error: Cannot connect " << OCA_SRV_SOCKET << ": " << strerror(-ret) << std::endl;
+		return -1;
+	}
+
+	oca_srv_image src_desc = oca_srv_image_desc(image.rows, image.cols, image.type(), 0);
+	if (oca_shm_alloc(src, (size_t)src_desc.rows * src_desc.step) < 0) {
+		std::cerr << "Error: Cannot allocate shared buffer" << std::endl;
+		return -1;
+	}
+	image.copyTo(oca_shm_mat(src, src_desc));
+
+	/* Alternate ops so the server has to reorder to avoid reconfiguration */
+	for (int i = 0; i < CLIENT_BENCH_REQUESTS; i++) {
+		req[i].op = (i & 1) ? OCA_SRV_OP_WARP_AFFINE : OCA_SRV_OP_RESIZE;
+		req[i].interpolation = cv::INTER_LINEAR;
+		req[i].src = src_desc;
+		req[i].dst = (i & 1) ? oca_srv_image_desc(image.rows, image.cols, image.type(), 0)
+							 : oca_srv_image_desc(768, 1024, image.type(), 0);
+		memcpy(req[i].m, m, sizeof(m));
+		if (oca_shm_alloc(dst[i], (size_t)req[i].dst.rows * req[i].dst.step) < 0) {
+			std::cerr << "Error: Cannot allocate shared buffer" << std::endl;
+			return -1;
+		}
+	}
+
+	printf("[CLIENT] %d pipelined requests (resize FHD->XGA / warpAffine FHD)\n", CLIENT_BENCH_REQUESTS);
+	timespec_get(&t0, TIME_UTC);
+	for (int i = 0; i < CLIENT_BENCH_REQUESTS; i++) {
+		if (oca_client_submit(client, req[i], src, dst[i]) < 0) {
+			std::cerr << "Error: submit failed" << std::endl;
+			return -1;
+		}
+	}
+
+	int errors = 0;
+	for (int i = 0; i < CLIENT_BENCH_REQUESTS; i++) {
+		oca_srv_reply reply;
+		if (oca_client_wait(client, reply) < 0) {
+			std::cerr << "Error: connection lost" << std::endl;
+			return -1;
+		}
+		int64_t k = (int64_t)reply.id - (int64_t)req[0].id;
+		if (k < 0 || k >= CLIENT_BENCH_REQUESTS) {
+			std::cerr << "Error: reply for unknown request id " << reply.id << std::endl;
+			errors++;
+			continue;
+		}
+		cv::Mat ref;
+		if (req[k].op == OCA_SRV_OP_RESIZE) {
+			cv::resize(image, ref, {1024, 768}, 0, 0, cv::INTER_LINEAR);
+		} else {
+			cv::warpAffine(image, ref, cv::Mat(2, 3, CV_64FC1, const_cast<double *>(m)), image.size());
+		}
+		/* CPU replies must match the local CPU path exactly, OCA replies within the op's tolerance */
+		const char *op = req[k].op == OCA_SRV_OP_RESIZE ? "resize" : "warpAffine";
+		oca_accuracy acc = {};
+		double diff = -1;
+		bool pass = false;
+		if (reply.status == 0 && oca_accuracy_compare(ref, oca_shm_mat(dst[k], req[k].dst),
+													   oca_accuracy_tolerance(op), acc, nullptr) == 0) {
+			diff = acc.max_abs;
+			pass = reply.accelerated ? acc.pass : diff == 0;
+		}
+		printf("[CLIENT] id %2u %-10s status %d %s queue %8.3fmsec exec %8.3fmsec max diff %.0f%s\n", reply.id, op,
+			   reply.status, reply.accelerated ? "[OCA]" : "[CPU]", reply.queue_ms, reply.exec_ms, diff,
+			   pass ? "" : " FAIL");
+		if (!pass) {
+			errors++;
+		}
+	}
+	timespec_get(&t1, TIME_UTC);
+	printf("[CLIENT] total %fmsec\n\n", timedifference_msec(t0, t1));
+	return errors ? -1 : 0;
+}
@@ -0,0 +1,223 @@
+/***********************************************************************************************************************
+* Copyright (C) 2024 Renesas Electronics Corporation. All rights reserved.
+***********************************************************************************************************************/
+/***********************************************************************************************************************
+* File Name    : oca_coldstart.cpp
+* Version      : 1.00
+* Description  : Startup profiler: process start, OpenCV init, first OCA_Activate and cold versus steady first calls
+***********************************************************************************************************************/
+
+/*****************************************
+* Includes
+******************************************/
+#include "define.h"
+#include "oca_coldstart.h"
+#include "oca_ops.h"
+#include "oca_sim.h"
+#include <algorithm>
+#include <iostream>
+#include <thread>
+#include <opencv2/opencv.hpp>
+
+/*****************************************
+* Macros
+******************************************/
+/* Last line of a profile run, parsed by oca_coldstart_compare */
+#define COLD_READY_TAG          "[COLD] ready "
+
+/*****************************************
+* Function Name : oca_coldstart_now_ns
+* Description   : CLOCK_BOOTTIME in ns, the clock of the process start time in /proc/self/stat
+******************************************/
+uint64_t oca_coldstart_now_ns() {
+	struct timespec ts;
+	clock_gettime(CLOCK_BOOTTIME, &ts);
+	return (uint64_t)ts.tv_sec * 1000000000ull + (uint64_t)ts.tv_nsec;
+}
+
+/*****************************************
+* Function Name : process_start_ns
+* Description   : exec time of this process on the oca_coldstart_now_ns clock, jiffy resolution
+* Return value  : ns, 0 if unknown
+******************************************/
+static uint64_t process_start_ns() {
+	char buf[1024];
+	unsigned long long start = 0;
+	FILE *f = fopen("/proc/self/stat", "r");
+	if (!f) {
+		return 0;
+	}
+	size_t n = fread(buf, 1, sizeof(buf) - 1, f);
+	fclose(f);
+	buf[n] = '\0';
+	/* comm may contain spaces; fields after it start with state (field 3), starttime is field 22 */
+	const char *p = strrchr(buf, ')');
+	if (!p || sscanf(p + 2, "%*c %*d %*d %*d %*d %*d %*u %*u %*u %*u %*u %*u %*u %*d %*d %*d %*d %*d %*d %llu",
+					 &start) != 1) {
+		return 0;
+	}
+	return (uint64_t)(start * 1000000000ull / (unsigned long long)sysconf(_SC_CLK_TCK));
+}
+
+/*****************************************
+* Function Name : timed_call
+* Description   : one OCA call, msec (simulated builds pad it to the board model)
+******************************************/
+static double timed_call(const std::function<void()> &run, int drp, size_t in, size_t out) {
+	(void)drp;
+	(void)in;
+	(void)out;
+	uint64_t t0 = oca_coldstart_now_ns();
+	OCA_SIM_BEGIN();
+	run();
+	OCA_SIM_CHARGE(drp, in, out, 1);
+	OCA_SIM_END();
+	return (double)(oca_coldstart_now_ns() - t0) / 1E6;
+}
+
+/*****************************************
+* Function Name : prewarm_circuits
+* Description   : enable every circuit and run each op once on a blank frame
+******************************************/
+static void prewarm_circuits(const std::vector<oca_op> &ops, unsigned long *OCA_f) {
+	cv::Mat bgr(1080, 1920, CV_8UC3, cv::Scalar::all(0));
+	oca_activate(OCA_f);
+	for (const oca_op &op: ops) {
+		oca_case_data d;
+		std::function<void()> run = op.setup(bgr, d);
+		timed_call(run, op.desc->drp[0], d.in, d.out);
+	}
+}
+
+/*****************************************
+* Function Name : oca_coldstart_profile
+* Description   : startup phases of this process, then the first (cold) and steady-state OCA call of every
+*                 circuit. Run in a fresh process before any other OpenCV / OCA call.
+*                 With prewarm, OCA_Activate and one call per circuit on a blank frame run on a
+*                 second thread while the input is decoded.
+* Arguments     : main_ns = oca_coldstart_now_ns() at the top of main
+*                 in_file = input image
+*                 OCA_f = OCA_Activate function list
+*                 prewarm = overlap circuit initialization with input decoding
+* Return value  : 0 on success, -1 on error
+******************************************/
+int oca_coldstart_profile(uint64_t main_ns, const std::filesystem::path &in_file, unsigned long *OCA_f, bool prewarm) {
+	const std::vector<oca_op> &ops = oca_ops();
+	uint64_t start_ns = process_start_ns();
+	uint64_t t0, t1, ready_ns;
+	cv::Mat image;
+	double first_sum = 0;
+
+	printf("[COLD] startup profile%s\n", prewarm ? " with parallel pre-warm" : "");
+	if (start_ns > 0 && start_ns <= main_ns) {
+		printf("[COLD] exec -> main            %10.3fmsec (%ldHz resolution)\n", (double)(main_ns - start_ns) / 1E6,
+			   sysconf(_SC_CLK_TCK));
+	} else {
+		start_ns = main_ns;
+		printf("[COLD] exec -> main            unknown, times below are from main\n");
+	}
+
+	/* OpenCV init: thread pool creation on the first parallel region */
+	t0 = oca_coldstart_now_ns();
+	cv::parallel_for_(cv::Range(0, cv::getNumThreads()), [](const cv::Range &) {});
+	t1 = oca_coldstart_now_ns();
+	printf("[COLD] OpenCV init             %10.3fmsec (%d threads)\n", (double)(t1 - t0) / 1E6, cv::getNumThreads());
+
+	for (const oca_op &op: ops) {
+		oca_op_set(OCA_f, *op.desc, OPENCVA_FUNC_ENABLE);
+	}
+	if (prewarm) {
+		uint64_t warm_ns = 0;
+		t0 = oca_coldstart_now_ns();
+		std::thread warm([&] {
+			prewarm_circuits(ops, OCA_f);
+			warm_ns = oca_coldstart_now_ns();
+		});
+		image = cv::imread(in_file, cv::IMREAD_COLOR);
+		uint64_t read_ns = oca_coldstart_now_ns();
+		warm.join();
+		t1 = oca_coldstart_now_ns();
+		printf("[COLD] imread                  %10.3fmsec\n", (double)(read_ns - t0) / 1E6);
+		printf("[COLD] pre-warm (parallel)     %10.3fmsec\n", (double)(warm_ns - t0) / 1E6);
+		printf("[COLD] both done               %10.3fmsec\n", (double)(t1 - t0) / 1E6);
+	} else {
+		t0 = oca_coldstart_now_ns();
+		image = cv::imread(in_file, cv::IMREAD_COLOR);
+		t1 = oca_coldstart_now_ns();
+		printf("[COLD] imread                  %10.3fmsec\n", (double)(t1 - t0) / 1E6);
+		t0 = t1;
+		oca_activate(OCA_f);
+		t1 = oca_coldstart_now_ns();
+		printf("[COLD] first OCA_Activate      %10.3fmsec (%zu circuits)\n", (double)(t1 - t0) / 1E6, ops.size());
+	}
+	ready_ns = t1;
+	if (image.empty()) {
+		std::cerr << "Error: Cannot read " << in_file << std::endl;
+		return -1;
+	}
+
+	/* First call versus steady state; input preparation is not on the startup path */
+	printf("[COLD] %-18s %12s %12s %12s\n", "op", "first(ms)", "steady(ms)", "cold cost");
+	for (const oca_op &op: ops) {
+		oca_case_data d;
+		double steady[OCA_COLDSTART_STEADY];
+		std::function<void()> run = op.setup(image, d);
+		double first = timed_call(run, op.desc->drp[0], d.in, d.out);
+		for (double &v: steady) {
+			v = timed_call(run, op.desc->drp[0], d.in, d.out);
+		}
+		oca_s = d.dst.data ? d.dst.data[0] : 0;    //for suppress optimization
+		std::sort(steady, steady + OCA_COLDSTART_STEADY);
+		double median = steady[OCA_COLDSTART_STEADY / 2];
+		printf("[COLD] %-18s %12.3f %12.3f %12.3f\n", op.desc->name, first, median, first - median);
+		first_sum += first;
+	}
+	/* Time to the first output of every circuit: startup path plus the first calls */
+	printf(COLD_READY_TAG "%.3fmsec\n", (double)(ready_ns - start_ns) / 1E6 + first_sum);
+	return 0;
+}
+
+/*****************************************
+* Function Name : run_child
+* Description   : run a profile in a fresh process and echo its output
+* Return value  : ready time in msec, negative on error
+******************************************/
+static double run_child(const char *exe, bool prewarm) {
+	char line[256];
+	double ready = -1;
+	std::string cmd = "'";
+	for (const char *c = exe; *c; c++) {
+		cmd += (*c == '\'') ? std::string("'\\''") : std::string(1, *c);
+	}
+	cmd += std::string("' --cold-start-run") + (prewarm ? " --prewarm" : "");
+	FILE *p = popen(cmd.c_str(), "r");
+	if (!p) {
+		return -1;
+	}
+	while (fgets(line, sizeof(line), p)) {
+		fputs(line, stdout);
+		if (strncmp(line, COLD_READY_TAG, strlen(COLD_READY_TAG)) == 0) {
+			ready = atof(line + strlen(COLD_READY_TAG));
+		}
+	}
+	return pclose(p) == 0 ? ready : -1;
+}
+
+/*****************************************
+* Function Name : oca_coldstart_compare
+* Description   : profile a cold start without and with pre-warm, each in a new process, and report the saving
+* Arguments     : exe = absolute path of this executable (not /proc/self/exe, which popen's shell resolves to itself)
+* Return value  : 0 on success, -1 on error
+******************************************/
+int oca_coldstart_compare(const char *exe) {
+	double cold = run_child(exe, false);
+	printf("\n");
+	double warm = run_child(exe, true);
+	if (cold < 0 || warm < 0) {
+		std::cerr << "Error: cold-start profile run failed" << std::endl;
+		return -1;
+	}
+	printf("\n[COLD] time to first output of all circuits: %.3fmsec sequential, %.3fmsec with pre-warm, "
+		   "saves %.3fmsec (%.1f%%)\n", cold, warm, cold - warm, cold > 0 ? (cold - warm) / cold * 100 : 0);
+	return 0;
+}
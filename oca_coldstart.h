@@ -0,0 +1,31 @@
+/***********************************************************************************************************************
+* Copyright (C) 2024 Renesas Electronics Corporation. All rights reserved.
+***********************************************************************************************************************/
+/***********************************************************************************************************************
+* File Name    : oca_coldstart.h
+* Version      : 1.00
+* Description  : Startup profiler: process start, OpenCV init, first OCA_Activate and cold versus steady first calls
+***********************************************************************************************************************/
+
+#ifndef OCA_COLDSTART_H
+#define OCA_COLDSTART_H
+
+/*****************************************
+* Includes
+******************************************/
+#include <stdint.h>
+#include <filesystem>
+
+/*****************************************
+* Macros
+******************************************/
+#define OCA_COLDSTART_STEADY    (5)             /* calls after the first one, median = steady state */
+
+/*****************************************
+* Functions
+******************************************/
+uint64_t oca_coldstart_now_ns();
+int oca_coldstart_profile(uint64_t main_ns, const std::filesystem::path &in_file, unsigned long *OCA_f, bool prewarm);
+int oca_coldstart_compare(const char *exe);
+
+#endif
@@ -0,0 +1,24 @@
+/***********************************************************************************************************************
+* Copyright (C) 2024 Renesas Electronics Corporation. All rights reserved.
+***********************************************************************************************************************/
+/***********************************************************************************************************************
+* File Name    : oca_common.cpp
+* Version      : 1.00
+* Description  : Helpers declared in define.h, linked into every executable
+***********************************************************************************************************************/
+
+/*****************************************
+* Includes
+******************************************/
+#include "define.h"
+
+/*****************************************
+* Function Name : timedifference_msec
+* Description   : compute the time diffences in ms between two moments
+* Arguments     : t0 = start time
+*                 t1 = stop time
+* Return value  : the time diffence in ms
+******************************************/
+double timedifference_msec(struct timespec t0, struct timespec t1) {
+	return ((t1.tv_sec - t0.tv_sec) * 1E3 + (t1.tv_nsec - t0.tv_nsec) / 1E6);
+}
@@ -0,0 +1,333 @@
+/***********************************************************************************************************************
+* Copyright (C) 2024 Renesas Electronics Corporation. All rights reserved.
+***********************************************************************************************************************/
+/***********************************************************************************************************************
+* File Name    : oca_compare.cpp
+* Version      : 1.00
+* Description  : Compare two oca_sample result sets (oca_results.csv) per case and path and fail on regressions.
+*                Significance: Mann-Whitney U test on the samples. Effect size: median ratio with a bootstrap CI.
+***********************************************************************************************************************/
+
+/*****************************************
+* Includes
+******************************************/
+#include "define.h"
+#include "oca_report_file.h"
+#include <algorithm>
+#include <filesystem>
+#include <iostream>
+#include <random>
+#include <sstream>
+
+/*****************************************
+* Macros
+******************************************/
+#define CMP_THRESHOLD_PCT       (5.0)   /* slowdown of the median that counts as a regression */
+#define CMP_ALPHA               (0.05)  /* two-sided significance level */
+#define CMP_BOOTSTRAP           (2000)  /* bootstrap resamples for the ratio CI */
+#define CMP_MIN_SAMPLES         (5)     /* below this on either side only the median ratio is checked */
+#define CMP_EXACT_MAX           (60)    /* exact Mann-Whitney p-values up to this total sample count */
+#define CMP_SEED                (12345) /* fixed so repeated comparisons print the same CI */
+
+/* Exit codes */
+#define CMP_EXIT_OK             (0)
+#define CMP_EXIT_REGRESSION     (1)
+#define CMP_EXIT_ERROR          (2)
+
+/*****************************************
+* Typedefs
+******************************************/
+/* One case / path row of a result set */
+struct cmp_row {
+	std::string key;                    /* "<case> <op> <path>" */
+	std::vector<double> samples;
+};
+
+/*****************************************
+* Function Name : cmp_median
+* Description   : median of a sample set
+******************************************/
+static double cmp_median(std::vector<double> v) {
+	if (v.empty()) {
+		return 0;
+	}
+	std::sort(v.begin(), v.end());
+	size_t n = v.size();
+	return (n & 1) ? v[n / 2] : (v[n / 2 - 1] + v[n / 2]) / 2;
+}
+
+/*****************************************
+* Function Name : cmp_load
+* Description   : read the rows of an oca_results.csv
+* Arguments     : path = CSV file, or a results directory containing OCA_REPORT_CSV
+*                 rows = output, in file order
+* Return value  : 0 on success, -1 on error
+******************************************/
+static int cmp_load(std::string path, std::vector<cmp_row> &rows) {
+	std::map<std::string, size_t> col;
+	std::string line;
+	if (std::filesystem::is_directory(path)) {
+		path = (std::filesystem::path(path) / OCA_REPORT_CSV).string();
+	}
+	std::ifstream file(path);
+	if (!file.is_open()) {
+		std::cerr << "Error: Cannot open " << path << std::endl;
+		return -1;
+	}
+	while (std::getline(file, line)) {
+		std::vector<std::string> field;
+		std::stringstream ss(line);
+		std::string f;
+		if (line.empty() || line[0] == '#') {
+			continue;
+		}
+		while (std::getline(ss, f, ',')) {
+			field.push_back(f);
+		}
+		if (col.empty()) {
+			for (size_t i = 0; i < field.size(); i++) {
+				col[field[i]] = i;
+			}
+			if (!col.count("case") || !col.count("op") || !col.count("path") || !col.count("samples_ms")) {
+				std::cerr << "Error: " << path << " is not an oca_sample result file" << std::endl;
+				return -1;
+			}
+			continue;
+		}
+		if (field.size() <= col["samples_ms"]) {
+			continue;
+		}
+		cmp_row row;
+		row.key = field[col["case"]] + " " + field[col["op"]] + " " + field[col["path"]];
+		std::stringstream samples(field[col["samples_ms"]]);
+		while (std::getline(samples, f, ';')) {
+			row.samples.push_back(atof(f.c_str()));
+		}
+		rows.push_back(row);
+	}
+	return 0;
+}
+
+/*****************************************
+* Function Name : cmp_ranks
+* Description   : ranks of the pooled samples, ties get their average rank
+* Arguments     : a, b = sample sets
+*                 rank = output, ranks of a followed by ranks of b
+* Return value  : tie correction term sum(t^3 - t)
+******************************************/
+static double cmp_ranks(const std::vector<double> &a, const std::vector<double> &b, std::vector<double> &rank) {
+	std::vector<std::pair<double, size_t>> all;
+	double ties = 0;
+	for (size_t i = 0; i < a.size(); i++) {
+		all.push_back({a[i], i});
+	}
+	for (size_t i = 0; i < b.size(); i++) {
+		all.push_back({b[i], a.size() + i});
+	}
+	std::sort(all.begin(), all.end());
+	rank.assign(all.size(), 0);
+	for (size_t i = 0; i < all.size();) {
+		size_t j = i;
+		while (j < all.size() && all[j].first == all[i].first) {
+			j++;
+		}
+		double t = (double)(j - i);
+		ties += t * t * t - t;
+		for (size_t k = i; k < j; k++) {
+			rank[all[k].second] = (double)(i + j + 1) / 2;     /* average of ranks i+1 .. j */
+		}
+		i = j;
+	}
+	return ties;
+}
+
+/*****************************************
+* Function Name : cmp_mann_whitney_exact
+* Description   : two-sided exact p-value: the fraction of all ways to pick n1 of the pooled ranks whose rank
+*                 sum is at least as far from its mean as the observed one. Ties are handled by counting
+*                 over the (doubled, hence integer) average ranks.
+******************************************/
+static double cmp_mann_whitney_exact(const std::vector<double> &rank, size_t n1) {
+	const size_t n = rank.size();
+	std::vector<int> r2(n);
+	int total = 0, observed = 0;
+	for (size_t i = 0; i < n; i++) {
+		r2[i] = (int)lround(rank[i] * 2);
+		total += r2[i];
+		observed += i < n1 ? r2[i] : 0;
+	}
+	/* count[k][s]: subsets of k ranks with doubled sum s */
+	std::vector<std::vector<double>> count(n1 + 1, std::vector<double>(total + 1, 0));
+	count[0][0] = 1;
+	for (size_t i = 0; i < n; i++) {
+		for (size_t k = std::min(n1, i + 1); k >= 1; k--) {
+			for (int s = total; s >= r2[i]; s--) {
+				count[k][s] += count[k - 1][s - r2[i]];
+			}
+		}
+	}
+	/* Mean of the doubled sum is n1 * total / n; compare in units of 1/n to stay in integers */
+	const long long mean_n = (long long)n1 * total;
+	const long long dev = std::llabs((long long)observed * (long long)n - mean_n);
+	double extreme = 0, all = 0;
+	for (int s = 0; s <= total; s++) {
+		all += count[n1][s];
+		if (std::llabs((long long)s * (long long)n - mean_n) >= dev) {
+			extreme += count[n1][s];
+		}
+	}
+	return all > 0 ? std::min(1.0, extreme / all) : 1.0;
+}
+
+/*****************************************
+* Function Name : cmp_mann_whitney
+* Description   : two-sided Mann-Whitney U test. Exact up to CMP_EXACT_MAX samples, normal approximation
+*                 with tie and continuity correction above.
+* Return value  : p-value
+******************************************/
+static double cmp_mann_whitney(const std::vector<double> &a, const std::vector<double> &b) {
+	std::vector<double> rank;
+	double n1 = (double)a.size(), n2 = (double)b.size(), n = n1 + n2;
+	double ties = cmp_ranks(a, b, rank);
+	if (rank.size() <= CMP_EXACT_MAX) {
+		return cmp_mann_whitney_exact(rank, a.size());
+	}
+	double r1 = 0;
+	for (size_t i = 0; i < a.size(); i++) {
+		r1 += rank[i];
+	}
+	double u = r1 - n1 * (n1 + 1) / 2;
+	double mu = n1 * n2 / 2;
+	double sigma = sqrt(n1 * n2 / 12 * ((n + 1) - ties / (n * (n - 1))));
+	if (sigma <= 0) {
+		return 1.0;
+	}
+	double z = (fabs(u - mu) - 0.5) / sigma;
+	return std::min(1.0, erfc(std::max(0.0, z) / sqrt(2.0)));
+}
+
+/*****************************************
+* Function Name : cmp_min_p
+* Description   : smallest two-sided p-value the test can reach: both extreme arrangements out of C(n, n1)
+******************************************/
+static double cmp_min_p(size_t n1, size_t n2) {
+	double c = 1;
+	for (size_t i = 1; i <= n1; i++) {
+		c = c * (double)(n2 + i) / (double)i;
+	}
+	return std::min(1.0, 2 / c);
+}
+
+/*****************************************
+* Function Name : cmp_bootstrap_ratio
+* Description   : percentile bootstrap CI of median(b) / median(a)
+******************************************/
+static void cmp_bootstrap_ratio(const std::vector<double> &a, const std::vector<double> &b, int rounds,
+								double alpha, double &lo, double &hi) {
+	std::mt19937 rng(CMP_SEED);
+	std::uniform_int_distribution<size_t> pick_a(0, a.size() - 1), pick_b(0, b.size() - 1);
+	std::vector<double> ratio(rounds), ra(a.size()), rb(b.size());
+	for (int r = 0; r < rounds; r++) {
+		for (double &v: ra) {
+			v = a[pick_a(rng)];
+		}
+		for (double &v: rb) {
+			v = b[pick_b(rng)];
+		}
+		double ma = cmp_median(ra);
+		ratio[r] = ma > 0 ? cmp_median(rb) / ma : 1.0;
+	}
+	std::sort(ratio.begin(), ratio.end());
+	lo = ratio[(size_t)(alpha / 2 * (rounds - 1))];
+	hi = ratio[(size_t)((1 - alpha / 2) * (rounds - 1))];
+}
+
+/*****************************************
+* Function Name : cmp_usage
+* Description   : print command line help
+******************************************/
+static void cmp_usage(const char *prog) {
+	printf("usage: %s [--threshold PCT] [--alpha A] [--bootstrap N] BASELINE CANDIDATE\n", prog);
+	printf("  BASELINE, CANDIDATE  %s files or results directories written by oca_sample\n", OCA_REPORT_CSV);
+	printf("  --threshold PCT      median slowdown that fails the gate (default %.1f)\n", CMP_THRESHOLD_PCT);
+	printf("  --alpha A            significance level of the Mann-Whitney test (default %.2f)\n", CMP_ALPHA);
+	printf("  --bootstrap N        bootstrap resamples for the ratio CI (default %d)\n", CMP_BOOTSTRAP);
+	printf("exit status: %d no regression, %d regression, %d error\n", CMP_EXIT_OK, CMP_EXIT_REGRESSION,
+		   CMP_EXIT_ERROR);
+}
+
+/* main */
+int32_t main(int32_t argc, char *argv[]) {
+	double threshold = CMP_THRESHOLD_PCT, alpha = CMP_ALPHA;
+	int rounds = CMP_BOOTSTRAP;
+	std::vector<const char *> files;
+	std::vector<cmp_row> base, cand;
+
+	for (int i = 1; i < argc; i++) {
+		if (strcmp(argv[i], "--threshold") == 0 && i + 1 < argc) {
+			threshold = atof(argv[++i]);
+		} else if (strcmp(argv[i], "--alpha") == 0 && i + 1 < argc) {
+			alpha = atof(argv[++i]);
+		} else if (strcmp(argv[i], "--bootstrap") == 0 && i + 1 < argc) {
+			rounds = std::max(100, atoi(argv[++i]));
+		} else if (argv[i][0] != '-') {
+			files.push_back(argv[i]);
+		} else {
+			cmp_usage(argv[0]);
+			return CMP_EXIT_ERROR;
+		}
+	}
+	if (files.size() != 2) {
+		cmp_usage(argv[0]);
+		return CMP_EXIT_ERROR;
+	}
+	if (cmp_load(files[0], base) < 0 || cmp_load(files[1], cand) < 0) {
+		return CMP_EXIT_ERROR;
+	}
+
+	int regressions = 0, improvements = 0, compared = 0;
+	printf("[COMPARE] %s -> %s, threshold %.1f%%, alpha %.2f\n", files[0], files[1], threshold, alpha);
+	printf("  %-28s %6s %6s %12s %12s %9s %19s %8s  %s\n", "case", "n(b)", "n(c)", "base[ms]", "cand[ms]",
+		   "change", "CI(ratio)", "p", "result");
+	for (const cmp_row &b: base) {
+		auto c = std::find_if(cand.begin(), cand.end(), [&](const cmp_row &r) { return r.key == b.key; });
+		if (c == cand.end()) {
+			printf("  %-28s missing in candidate\n", b.key.c_str());
+			continue;
+		}
+		if (b.samples.empty() || c->samples.empty()) {
+			continue;
+		}
+		double mb = cmp_median(b.samples), mc = cmp_median(c->samples);
+		double ratio = mb > 0 ? mc / mb : 1.0;
+		/* The test only gates when it can reach p < alpha with these sample counts */
+		bool tested = b.samples.size() >= CMP_MIN_SAMPLES && c->samples.size() >= CMP_MIN_SAMPLES &&
+			cmp_min_p(b.samples.size(), c->samples.size()) < alpha;
+		double p = tested ? cmp_mann_whitney(b.samples, c->samples) : 0;
+		double lo = ratio, hi = ratio;
+		if (tested) {
+			cmp_bootstrap_ratio(b.samples, c->samples, rounds, alpha, lo, hi);
+		}
+
+		/* Slower beyond the threshold and, when there are enough samples, significant */
+		const char *result = "ok";
+		if (ratio > 1 + threshold / 100 && (!tested || p < alpha)) {
+			result = "REGRESSION";
+			regressions++;
+		} else if (ratio < 1 - threshold / 100 && (!tested || p < alpha)) {
+			result = "improved";
+			improvements++;
+		}
+		printf("  %-28s %6zu %6zu %12.4f %12.4f %+8.1f%%  [%7.3f, %7.3f] %8.4f  %s%s\n", b.key.c_str(),
+			   b.samples.size(), c->samples.size(), mb, mc, (ratio - 1) * 100, lo, hi, tested ? p : 1.0, result,
+			   tested ? "" : " (too few samples for the test)");
+		compared++;
+	}
+	for (const cmp_row &c: cand) {
+		if (std::none_of(base.begin(), base.end(), [&](const cmp_row &r) { return r.key == c.key; })) {
+			printf("  %-28s new in candidate\n", c.key.c_str());
+		}
+	}
+	printf("[COMPARE] %d compared, %d regressions, %d improvements\n", compared, regressions, improvements);
+	return regressions ? CMP_EXIT_REGRESSION : CMP_EXIT_OK;
+}
@@ -0,0 +1,304 @@
+/***********************************************************************************************************************
+* Copyright (C) 2024 Renesas Electronics Corporation. All rights reserved.
+***********************************************************************************************************************/
+/***********************************************************************************************************************
+* File Name    : oca_corpus.cpp
+* Version      : 1.00
+* Description  : Input corpus benchmark: every op over a set of images of different content
+***********************************************************************************************************************/
+
+/*****************************************
+* Includes
+******************************************/
+#include "define.h"
+#include "oca_corpus.h"
+#include "oca_ops.h"
+#include "oca_report.h"
+#include "oca_sim.h"
+#include "oca_stable.h"
+#include <algorithm>
+#include <functional>
+#include <iostream>
+#include <memory>
+
+/*****************************************
+* Typedefs
+******************************************/
+/* Op of the corpus run: an oca_ops() entry, or PNG encode / decode (no case, CPU only) */
+struct corpus_op {
+	const char *name;
+	const oca_op_desc *desc;
+	oca_op_setup setup;
+};
+
+/* Samples of one op and path over the whole corpus */
+struct corpus_total {
+	std::vector<double> samples;
+	std::vector<double> medians;        /* one per image */
+};
+
+/*****************************************
+* Function Name : oca_corpus_load
+* Description   : read the .png / .jpg / .jpeg / .bmp files of dir in name order, scaled to the case frame size
+* Return value  : number of images, 0 if dir is missing or has none
+******************************************/
+int oca_corpus_load(const std::filesystem::path &dir, std::vector<oca_corpus_image> &corpus) {
+	std::vector<std::filesystem::path> files;
+	std::error_code ec;
+	for (const auto &entry: std::filesystem::directory_iterator(dir, ec)) {
+		std::string ext = entry.path().extension().string();
+		std::transform(ext.begin(), ext.end(), ext.begin(), ::tolower);
+		if (entry.is_regular_file() && (ext == ".png" || ext == ".jpg" || ext == ".jpeg" || ext == ".bmp")) {
+			files.push_back(entry.path());
+		}
+	}
+	std::sort(files.begin(), files.end());
+	for (const std::filesystem::path &f: files) {
+		cv::Mat bgr = cv::imread(f, cv::IMREAD_COLOR);
+		if (bgr.empty()) {
+			std::cerr << "Error: Cannot read " << f << ", skipped" << std::endl;
+			continue;
+		}
+		oca_corpus_image img = {f.filename().string(), "file", cv::Mat()};
+		cv::resize(bgr, img.bgr, cv::Size(OCA_CORPUS_WIDTH, OCA_CORPUS_HEIGHT), 0, 0, cv::INTER_AREA);
+		corpus.push_back(img);
+	}
+	return (int)corpus.size();
+}
+
+/*****************************************
+* Function Name : oca_corpus_generate
+* Description   : procedural corpus: the natural input image if given, a fractal landscape, a text page,
+*                 a flat frame, a synthetic test chart and uniform noise
+******************************************/
+void oca_corpus_generate(const cv::Mat &natural, std::vector<oca_corpus_image> &corpus) {
+	const cv::Size size(OCA_CORPUS_WIDTH, OCA_CORPUS_HEIGHT);
+	cv::RNG rng(OCA_CORPUS_SEED);
+	cv::Mat img;
+
+	if (!natural.empty()) {
+		cv::resize(natural, img, size, 0, 0, cv::INTER_AREA);
+		corpus.push_back({"image.png", "natural", img.clone()});
+	}
+
+	/* Fractal landscape: octaves of smoothly upscaled noise, amplitude halving per octave, over a sky gradient */
+	cv::Mat acc(size, CV_32FC3, cv::Scalar(0, 0, 0));
+	double amp = 1.0, norm = 0;
+	for (int cells = 4; cells <= 512; cells *= 2, amp /= 2) {
+		cv::Mat coarse(cells * size.height / size.width + 1, cells, CV_32FC3), fine;
+		rng.fill(coarse, cv::RNG::UNIFORM, cv::Scalar::all(0), cv::Scalar::all(255));
+		cv::resize(coarse, fine, size, 0, 0, cv::INTER_CUBIC);
+		cv::scaleAdd(fine, amp, acc, acc);
+		norm += amp;
+	}
+	cv::Mat sky(size, CV_32FC3);
+	for (int y = 0; y < size.height; y++) {
+		sky.row(y).setTo(cv::Scalar(200, 160, 110) * ((double)(size.height - y) / size.height));
+	}
+	cv::addWeighted(acc, 0.7 / norm, sky, 0.3, 0, acc);
+	acc.convertTo(img, CV_8UC3);
+	corpus.push_back({"landscape", "natural", img.clone()});
+
+	/* Text page: lines of random words on white */
+	img.create(size, CV_8UC3);
+	img.setTo(cv::Scalar::all(255));
+	for (int y = 40; y < size.height - 10; y += 28) {
+		int x = 40;
+		while (x < size.width - 120) {
+			std::string word;
+			for (int n = rng.uniform(2, 9); n > 0; n--) {
+				word += (char)rng.uniform('a', 'z' + 1);
+			}
+			cv::putText(img, word, cv::Point(x, y), cv::FONT_HERSHEY_SIMPLEX, 0.7, cv::Scalar::all(20), 1, cv::LINE_AA);
+			x += (int)word.size() * 14 + 16;
+		}
+	}
+	corpus.push_back({"text", "text", img.clone()});
+
+	/* Flat frame */
+	img.setTo(cv::Scalar(128, 128, 128));
+	corpus.push_back({"flat", "flat", img.clone()});
+
+	/* Test chart: colour bars, checkerboard and filled circles with hard edges */
+	static const cv::Scalar bars[8] = {{255, 255, 255}, {0, 255, 255}, {255, 255, 0}, {0, 255, 0},
+									   {255, 0, 255},   {0, 0, 255},     {255, 0, 0},   {0, 0, 0}};
+	for (int i = 0; i < 8; i++) {
+		cv::rectangle(img, cv::Rect(i * size.width / 8, 0, size.width / 8 + 1, size.height / 2), bars[i], cv::FILLED);
+	}
+	for (int y = size.height / 2; y < size.height; y += 32) {
+		for (int x = 0; x < size.width; x += 32) {
+			cv::rectangle(img, cv::Rect(x, y, 32, 32), cv::Scalar::all(((x + y) / 32) % 2 ? 255 : 0), cv::FILLED);
+		}
+	}
+	for (int i = 0; i < 12; i++) {
+		cv::circle(img, cv::Point(rng.uniform(0, size.width), rng.uniform(0, size.height)), rng.uniform(20, 120),
+				   cv::Scalar(rng.uniform(0, 256), rng.uniform(0, 256), rng.uniform(0, 256)), cv::FILLED);
+	}
+	corpus.push_back({"chart", "synthetic", img.clone()});
+
+	/* Uniform noise */
+	rng.fill(img, cv::RNG::UNIFORM, cv::Scalar::all(0), cv::Scalar::all(256));
+	corpus.push_back({"noise", "noise", img.clone()});
+}
+
+/*****************************************
+* Function Name : corpus_ops
+* Description   : the oca_ops() circuits plus PNG encode and decode of the frame
+******************************************/
+static std::vector<corpus_op> corpus_ops() {
+	std::vector<corpus_op> ops;
+	for (const oca_op &op: oca_ops()) {
+		ops.push_back({op.desc->name, op.desc, op.setup});
+	}
+	ops.push_back({"imencode(png)", nullptr, [](const cv::Mat &bgr, oca_case_data &d) {
+		auto buf = std::make_shared<std::vector<uchar>>();
+		d.src = bgr;
+		d.in = d.src.total() * d.src.elemSize();
+		cv::imencode(".png", d.src, *buf);
+		d.out = buf->size();
+		return std::function<void()>([&d, buf] {
+			cv::imencode(".png", d.src, *buf);
+			d.dst = cv::Mat(1, (int)buf->size(), CV_8UC1, buf->data());
+		});
+	}});
+	ops.push_back({"imdecode(png)", nullptr, [](const cv::Mat &bgr, oca_case_data &d) {
+		std::vector<uchar> buf;
+		cv::imencode(".png", bgr, buf);
+		d.src = cv::Mat(buf, true);
+		d.in = buf.size();
+		d.out = bgr.total() * bgr.elemSize();
+		return std::function<void()>([&d] { d.dst = cv::imdecode(d.src, cv::IMREAD_COLOR); });
+	}});
+	return ops;
+}
+
+/*****************************************
+* Function Name : time_samples
+* Description   : samples timed calls after one untimed call, msec
+******************************************/
+static void time_samples(const std::function<void()> &run, int drp, size_t in, size_t out, bool oca,
+						 std::vector<double> &t) {
+	(void)drp;
+	(void)in;
+	(void)out;
+	run();                                      /* untimed: output allocation and first-call effects */
+	for (double &v: t) {
+		uint64_t t0 = oca_stable_now_ns();
+		OCA_SIM_BEGIN();
+		run();
+		if (oca) {
+			OCA_SIM_CHARGE(drp, in, out, 1);
+		}
+		OCA_SIM_END();
+		v = (double)(oca_stable_now_ns() - t0) / 1E6;
+	}
+}
+
+/*****************************************
+* Function Name : percentile
+* Description   : nearest-rank percentile of sorted values
+******************************************/
+static double percentile(const std::vector<double> &sorted, double p) {
+	if (sorted.empty()) {
+		return 0;
+	}
+	size_t rank = (size_t)std::ceil(p / 100.0 * (double)sorted.size());
+	return sorted[std::min(sorted.size() - 1, rank > 0 ? rank - 1 : 0)];
+}
+
+/*****************************************
+* Function Name : oca_corpus_benchmark
+* Description   : time every op on the CPU and OCA paths over every corpus image. Prints the per-image
+*                 median and, per op and path, the distribution over all samples and the spread of the
+*                 per-image medians (slowest / fastest image). Writes all samples to OCA_CORPUS_CSV.
+* Arguments     : corpus = images
+*                 OCA_f = OCA_Activate function list
+*                 iterations = timed calls per image, op and path (at least OCA_CORPUS_MIN_SAMPLES)
+*                 dir = results directory
+* Return value  : 0 on success, -1 on error
+******************************************/
+int oca_corpus_benchmark(const std::vector<oca_corpus_image> &corpus, unsigned long *OCA_f, int iterations,
+						 const std::filesystem::path &dir) {
+	const std::vector<corpus_op> ops = corpus_ops();
+	const int samples = std::max(iterations, OCA_CORPUS_MIN_SAMPLES);
+	std::vector<corpus_total> total(ops.size() * OCA_REPORT_CPU_OCA_NUM);
+
+	std::ofstream file(dir / OCA_CORPUS_CSV);
+	if (!file.is_open()) {
+		std::cerr << "Error: Cannot write " << dir / OCA_CORPUS_CSV << std::endl;
+		return -1;
+	}
+	file << "image,category,op,drp,path,in_bytes,out_bytes,min_ms,median_ms,max_ms,samples_ms\n";
+	file << std::fixed << std::setprecision(6);
+
+	printf("[CORPUS] %zu images, %zu ops, %d samples per image, op and path\n", corpus.size(), ops.size(), samples);
+	for (const oca_corpus_image &img: corpus) {
+		printf("[CORPUS] %s (%s)\n", img.name.c_str(), img.category.c_str());
+		for (size_t o = 0; o < ops.size(); o++) {
+			const corpus_op &op = ops[o];
+			oca_case_data d;
+			std::function<void()> run = op.setup(img.bgr, d);
+			const size_t in = d.in, out = d.out;
+			int drp = op.desc ? op.desc->drp[0] : -1;
+			double median[OCA_REPORT_CPU_OCA_NUM] = {-1, -1};
+
+			for (int p = OCA_REPORT_CPU; p <= OCA_REPORT_OCA; p++) {
+				if (!op.desc && p == OCA_REPORT_OCA) {
+					continue;
+				}
+				std::vector<double> t(samples);
+				if (op.desc) {
+					oca_op_activate(OCA_f, *op.desc,
+									(p == OCA_REPORT_OCA) ? OPENCVA_FUNC_ENABLE : OPENCVA_FUNC_DISABLE);
+				}
+				time_samples(run, drp, in, out, p == OCA_REPORT_OCA, t);
+				oca_s = d.dst.data ? d.dst.data[0] : 0;    //for suppress optimization
+
+				file << img.name << "," << img.category << "," << op.name << "," << drp << ","
+					 << oca_report_path_name(p) << "," << in << "," << out << ",";
+				std::vector<double> sorted = t;
+				std::sort(sorted.begin(), sorted.end());
+				median[p] = sorted[sorted.size() / 2];
+				file << sorted.front() << "," << median[p] << "," << sorted.back() << ",";
+				for (size_t i = 0; i < t.size(); i++) {
+					file << (i ? ";" : "") << t[i];
+				}
+				file << "\n";
+
+				corpus_total &tot = total[o * OCA_REPORT_CPU_OCA_NUM + p];
+				tot.samples.insert(tot.samples.end(), t.begin(), t.end());
+				tot.medians.push_back(median[p]);
+			}
+			if (median[OCA_REPORT_OCA] > 0) {
+				printf("[CORPUS]   %-18s cpu %10.3fmsec  oca %10.3fmsec  x%.2f\n", op.name, median[OCA_REPORT_CPU],
+					   median[OCA_REPORT_OCA], median[OCA_REPORT_CPU] / median[OCA_REPORT_OCA]);
+			} else {
+				printf("[CORPUS]   %-18s cpu %10.3fmsec\n", op.name, median[OCA_REPORT_CPU]);
+			}
+		}
+	}
+	for (const corpus_op &op: ops) {
+		if (op.desc) {
+			oca_op_set(OCA_f, *op.desc, OPENCVA_FUNC_DISABLE);
+		}
+	}
+	oca_activate(OCA_f);
+
+	printf("[CORPUS] all images, msec: p50 / p90 / p99 / max over samples; spread = slowest / fastest image median\n");
+	printf("[CORPUS] %-18s path %9s %9s %9s %9s %7s\n", "op", "p50", "p90", "p99", "max", "spread");
+	for (size_t o = 0; o < ops.size(); o++) {
+		for (int p = OCA_REPORT_CPU; p <= OCA_REPORT_OCA; p++) {
+			corpus_total &tot = total[o * OCA_REPORT_CPU_OCA_NUM + p];
+			if (tot.samples.empty()) {
+				continue;
+			}
+			std::sort(tot.samples.begin(), tot.samples.end());
+			auto mm = std::minmax_element(tot.medians.begin(), tot.medians.end());
+			printf("[CORPUS] %-18s %s  %9.3f %9.3f %9.3f %9.3f %7.2f\n", ops[o].name, oca_report_path_name(p),
+				   percentile(tot.samples, 50), percentile(tot.samples, 90), percentile(tot.samples, 99),
+				   tot.samples.back(), *mm.first > 0 ? *mm.second / *mm.first : 0);
+		}
+	}
+	printf("[CORPUS] samples: %s\n\n", (dir / OCA_CORPUS_CSV).c_str());
+	return file.good() ? 0 : -1;
+}
@@ -0,0 +1,48 @@
+/***********************************************************************************************************************
+* Copyright (C) 2024 Renesas Electronics Corporation. All rights reserved.
+***********************************************************************************************************************/
+/***********************************************************************************************************************
+* File Name    : oca_corpus.h
+* Version      : 1.00
+* Description  : Input corpus benchmark: every op over a set of images of different content
+***********************************************************************************************************************/
+
+#ifndef OCA_CORPUS_H
+#define OCA_CORPUS_H
+
+/*****************************************
+* Includes
+******************************************/
+#include <filesystem>
+#include <string>
+#include <vector>
+#include <opencv2/opencv.hpp>
+
+/*****************************************
+* Macros
+******************************************/
+#define OCA_CORPUS_DIR          "resources/corpus"  /* default image directory */
+#define OCA_CORPUS_CSV          "oca_corpus.csv"    /* written to the results directory */
+#define OCA_CORPUS_MIN_SAMPLES  (3)                 /* timed calls per image, op and path */
+#define OCA_CORPUS_WIDTH        (1920)              /* images are scaled to the case frame size */
+#define OCA_CORPUS_HEIGHT       (1080)
+#define OCA_CORPUS_SEED         (0x0CA)             /* procedural corpus, fixed for comparable runs */
+
+/*****************************************
+* Typedefs
+******************************************/
+struct oca_corpus_image {
+	std::string name;
+	std::string category;               /* natural, text, flat, synthetic, noise or file */
+	cv::Mat bgr;                        /* OCA_CORPUS_WIDTH x OCA_CORPUS_HEIGHT */
+};
+
+/*****************************************
+* Functions
+******************************************/
+int oca_corpus_load(const std::filesystem::path &dir, std::vector<oca_corpus_image> &corpus);
+void oca_corpus_generate(const cv::Mat &natural, std::vector<oca_corpus_image> &corpus);
+int oca_corpus_benchmark(const std::vector<oca_corpus_image> &corpus, unsigned long *OCA_f, int iterations,
+						 const std::filesystem::path &dir);
+
+#endif
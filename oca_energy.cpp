@@ -0,0 +1,405 @@
+/***********************************************************************************************************************
+* Copyright (C) 2024 Renesas Electronics Corporation. All rights reserved.
+***********************************************************************************************************************/
+/***********************************************************************************************************************
+* File Name    : oca_energy.cpp
+* Version      : 1.00
+* Description  : Energy around timed regions from Linux power sources (hwmon, power_supply, command, file, replay)
+***********************************************************************************************************************/
+
+/*****************************************
+* Includes
+******************************************/
+#include "define.h"
+#include "oca_energy.h"
+#include "oca_stable.h"
+#include <algorithm>
+#include <atomic>
+#include <filesystem>
+#include <memory>
+#include <mutex>
+#include <thread>
+#include <sys/resource.h>
+
+/*****************************************
+* Global Variables
+******************************************/
+static oca_energy_source energy_source;
+static bool energy_active = false;
+static double energy_origin;                   /* cumulative sources: reading at open */
+static double energy_last_j;                   /* cumulative sources: last good reading since open */
+static std::thread energy_thread;              /* power sources: sampler */
+static std::atomic<bool> energy_running(false);
+static std::mutex energy_lock;
+static double energy_joules;                   /* power sources: integral up to energy_last_ns */
+static double energy_last_w = -1;              /* negative until the first sample */
+static uint64_t energy_last_ns;
+
+/*****************************************
+* Function Name : read_number
+* Description   : first number in a text file (sysfs), NAN if unreadable
+******************************************/
+static double read_number(const std::filesystem::path &path) {
+	std::ifstream file(path);
+	double v;
+	return (file >> v) ? v : NAN;
+}
+
+/*****************************************
+* Function Name : read_text
+* Description   : first word of a text file (sysfs), empty if unreadable
+******************************************/
+static std::string read_text(const std::filesystem::path &path) {
+	std::ifstream file(path);
+	std::string s;
+	file >> s;
+	return s;
+}
+
+/*****************************************
+* Function Name : hwmon_source
+* Description   : source of one hwmon input: energyN_input (uJ, cumulative) or powerN_input / powerN_average (uW)
+******************************************/
+static oca_energy_source hwmon_source(const std::filesystem::path &input) {
+	oca_energy_source s;
+	std::string chip = read_text(input.parent_path() / "name");
+	s.name = "hwmon:" + (chip.empty() ? input.parent_path().filename().string() : chip) + "/" +
+		input.filename().string();
+	s.cumulative = input.filename().string().rfind("energy", 0) == 0;
+	s.period_ms = OCA_ENERGY_PERIOD_MS;
+	s.read = [input]() {
+		double v = read_number(input);
+		return std::isnan(v) ? -1 : v / 1E6;
+	};
+	return s;
+}
+
+/*****************************************
+* Function Name : find_hwmon
+* Description   : first readable hwmon energy input, else the first power input
+* Return value  : 0 on success, -ENOENT
+******************************************/
+static int find_hwmon(oca_energy_source &source) {
+	std::vector<std::filesystem::path> energy, power;
+	std::error_code ec;
+	for (const auto &dev: std::filesystem::directory_iterator("/sys/class/hwmon", ec)) {
+		for (const auto &f: std::filesystem::directory_iterator(dev.path(), ec)) {
+			std::string n = f.path().filename().string();
+			if (n.rfind("energy", 0) == 0 && n.size() > 6 && n.compare(n.size() - 6, 6, "_input") == 0) {
+				energy.push_back(f.path());
+			} else if (n.rfind("power", 0) == 0 && (n.find("_input") != std::string::npos ||
+													n.find("_average") != std::string::npos)) {
+				power.push_back(f.path());
+			}
+		}
+	}
+	std::sort(energy.begin(), energy.end());
+	std::sort(power.begin(), power.end());
+	energy.insert(energy.end(), power.begin(), power.end());
+	for (const std::filesystem::path &p: energy) {
+		if (!std::isnan(read_number(p))) {
+			source = hwmon_source(p);
+			return 0;
+		}
+	}
+	return -ENOENT;
+}
+
+/*****************************************
+* Function Name : find_battery
+* Description   : first battery with power_now (uW) or current_now (uA) and voltage_now (uV)
+* Return value  : 0 on success, -ENOENT
+******************************************/
+static int find_battery(oca_energy_source &source) {
+	std::error_code ec;
+	for (const auto &dev: std::filesystem::directory_iterator("/sys/class/power_supply", ec)) {
+		std::filesystem::path d = dev.path();
+		if (read_text(d / "type") != "Battery") {
+			continue;
+		}
+		source.cumulative = false;
+		source.period_ms = OCA_ENERGY_PERIOD_MS;
+		if (!std::isnan(read_number(d / "power_now"))) {
+			source.name = "battery:" + d.filename().string() + "/power_now";
+			source.read = [d]() {
+				double v = read_number(d / "power_now");
+				return std::isnan(v) ? -1 : fabs(v) / 1E6;
+			};
+			return 0;
+		}
+		if (!std::isnan(read_number(d / "current_now")) && !std::isnan(read_number(d / "voltage_now"))) {
+			source.name = "battery:" + d.filename().string() + "/current_now*voltage_now";
+			source.read = [d]() {
+				double i = read_number(d / "current_now");
+				double u = read_number(d / "voltage_now");
+				return (std::isnan(i) || std::isnan(u)) ? -1 : fabs(i) * u / 1E12;
+			};
+			return 0;
+		}
+	}
+	return -ENOENT;
+}
+
+/*****************************************
+* Function Name : command_source
+* Description   : a shell command printing the current power in watts, e.g. a meter or PMIC query
+******************************************/
+static oca_energy_source command_source(const std::string &command) {
+	oca_energy_source s;
+	s.name = "cmd:" + command;
+	s.cumulative = false;
+	s.period_ms = OCA_ENERGY_CMD_PERIOD_MS;
+	s.read = [command]() {
+		FILE *fp = popen(command.c_str(), "r");
+		double v = -1;
+		if (fp == nullptr) {
+			return v;
+		}
+		if (fscanf(fp, "%lf", &v) != 1) {
+			v = -1;
+		}
+		pclose(fp);
+		return v;
+	};
+	return s;
+}
+
+/*****************************************
+* Function Name : file_source
+* Description   : a file holding the current power in watts, rewritten by an external logger
+******************************************/
+static oca_energy_source file_source(const std::string &path) {
+	oca_energy_source s;
+	s.name = "file:" + path;
+	s.cumulative = false;
+	s.period_ms = OCA_ENERGY_PERIOD_MS;
+	s.read = [path]() {
+		double v = read_number(path);
+		return std::isnan(v) ? -1 : v;
+	};
+	return s;
+}
+
+/*****************************************
+* Function Name : replay_source
+* Description   : a recorded power trace, one "seconds watts" pair per line ('#' comments), replayed in a loop
+*                 from the time of open. The trace is linear between points and integrated exactly, so runs
+*                 are reproducible on any machine.
+* Return value  : 0 on success, -ENOENT / -EINVAL
+******************************************/
+static int replay_source(const std::string &path, oca_energy_source &source) {
+	std::ifstream file(path);
+	std::string line;
+	std::vector<double> t, w;
+	if (!file.is_open()) {
+		return -ENOENT;
+	}
+	while (std::getline(file, line)) {
+		double ts, ws;
+		if (line.empty() || line[0] == '#' || sscanf(line.c_str(), "%lf %lf", &ts, &ws) != 2) {
+			continue;
+		}
+		if (!t.empty() && ts <= t.back()) {
+			return -EINVAL;
+		}
+		t.push_back(ts);
+		w.push_back(ws);
+	}
+	if (t.size() < 2) {
+		return -EINVAL;
+	}
+	/* Energy at each trace point */
+	auto e = std::make_shared<std::vector<double>>(t.size(), 0.0);
+	for (size_t i = 1; i < t.size(); i++) {
+		(*e)[i] = (*e)[i - 1] + (w[i - 1] + w[i]) / 2 * (t[i] - t[i - 1]);
+	}
+	uint64_t start_ns = oca_stable_now_ns();
+	source.name = "replay:" + path;
+	source.cumulative = true;
+	source.period_ms = 0;
+	source.read = [t, w, e, start_ns]() {
+		double span = t.back() - t.front();
+		double x = (double)(oca_stable_now_ns() - start_ns) / 1E9;
+		double loops = floor(x / span);
+		double r = x - loops * span + t.front();
+		size_t i = std::upper_bound(t.begin(), t.end(), r) - t.begin();
+		i = std::clamp(i, (size_t)1, t.size() - 1);
+		double dt = r - t[i - 1];
+		double slope = (w[i] - w[i - 1]) / (t[i] - t[i - 1]);
+		return loops * e->back() + (*e)[i - 1] + (w[i - 1] + slope * dt / 2) * dt;
+	};
+	return 0;
+}
+
+/*****************************************
+* Function Name : model_source
+* Description   : estimate without a sensor: idle power over wall time plus core power over process CPU time.
+*                 The DRP is not modelled, so OCA calls are charged for their CPU time only and come out
+*                 too low. Only used when asked for by name.
+******************************************/
+static oca_energy_source model_source() {
+	oca_energy_source s;
+	s.name = "model";
+	s.cumulative = true;
+	s.period_ms = 0;
+	s.read = []() {
+		struct rusage ru;
+		getrusage(RUSAGE_SELF, &ru);
+		double cpu = (double)(ru.ru_utime.tv_sec + ru.ru_stime.tv_sec) +
+			(double)(ru.ru_utime.tv_usec + ru.ru_stime.tv_usec) / 1E6;
+		return OCA_ENERGY_MODEL_IDLE_W * (double)oca_stable_now_ns() / 1E9 + OCA_ENERGY_MODEL_CORE_W * cpu;
+	};
+	return s;
+}
+
+/*****************************************
+* Function Name : energy_sample
+* Description   : read a power source and integrate (trapezoid) since the previous sample
+******************************************/
+static void energy_sample() {
+	double w = energy_source.read();
+	uint64_t now = oca_stable_now_ns();
+	if (w < 0) {
+		return;
+	}
+	std::lock_guard<std::mutex> lock(energy_lock);
+	if (energy_last_w >= 0) {
+		energy_joules += (energy_last_w + w) / 2 * (double)(now - energy_last_ns) / 1E9;
+	}
+	energy_last_w = w;
+	energy_last_ns = now;
+}
+
+/*****************************************
+* Function Name : energy_sampler
+* Description   : sampler thread of a power source
+******************************************/
+static void energy_sampler() {
+	while (energy_running) {
+		energy_sample();
+		std::this_thread::sleep_for(std::chrono::milliseconds(energy_source.period_ms));
+	}
+}
+
+/*****************************************
+* Function Name : oca_energy_set_source
+* Description   : start measuring with any source, e.g. one provided by the application
+* Return value  : 0 on success, -EIO if the first read fails
+******************************************/
+int oca_energy_set_source(const oca_energy_source &source) {
+	static bool at_exit = false;
+	oca_energy_close();
+	/* A joinable sampler must not reach the std::thread destructor on an early return from main */
+	if (!at_exit) {
+		atexit(oca_energy_close);
+		at_exit = true;
+	}
+	energy_source = source;
+	if (!energy_source.cumulative) {
+		energy_source.period_ms = std::max(1, energy_source.period_ms);
+		energy_joules = 0;
+		energy_last_w = -1;
+		energy_sample();
+		if (energy_last_w < 0) {
+			return -EIO;
+		}
+		energy_running = true;
+		energy_thread = std::thread(energy_sampler);
+	} else {
+		energy_origin = energy_source.read();
+		energy_last_j = 0;
+		if (energy_origin < 0) {
+			return -EIO;
+		}
+	}
+	energy_active = true;
+	return 0;
+}
+
+/*****************************************
+* Function Name : oca_energy_open
+* Description   : start measuring with a source given on the command line
+* Arguments     : spec = "auto" (or nullptr): first hwmon input, else a battery, else OCA_ENERGY_REPLAY_FILE
+*                        "hwmon" / "hwmon:PATH", "battery", "cmd:COMMAND", "file:PATH", "replay:PATH", "model"
+* Return value  : 0 on success, negative errno
+******************************************/
+int oca_energy_open(const char *spec) {
+	oca_energy_source source;
+	std::string s = spec ? spec : "auto";
+	int ret = 0;
+	if (s == "auto") {
+		/* No sensor: the shipped trace keeps the report path testable, the model is never chosen here */
+		if (find_hwmon(source) < 0 && find_battery(source) < 0) {
+			ret = replay_source(OCA_ENERGY_REPLAY_FILE, source);
+		}
+	} else if (s == "hwmon") {
+		ret = find_hwmon(source);
+	} else if (s.rfind("hwmon:", 0) == 0) {
+		source = hwmon_source(s.substr(6));
+	} else if (s == "battery") {
+		ret = find_battery(source);
+	} else if (s.rfind("cmd:", 0) == 0) {
+		source = command_source(s.substr(4));
+	} else if (s.rfind("file:", 0) == 0) {
+		source = file_source(s.substr(5));
+	} else if (s.rfind("replay:", 0) == 0) {
+		ret = replay_source(s.substr(7), source);
+	} else if (s == "model") {
+		source = model_source();
+	} else {
+		ret = -EINVAL;
+	}
+	if (ret < 0) {
+		oca_energy_close();
+		return ret;
+	}
+	return oca_energy_set_source(source);
+}
+
+/*****************************************
+* Function Name : oca_energy_close
+* Description   : stop the sampler
+******************************************/
+void oca_energy_close() {
+	energy_running = false;
+	if (energy_thread.joinable()) {
+		energy_thread.join();
+	}
+	energy_active = false;
+}
+
+/*****************************************
+* Function Name : oca_energy_active
+* Description   : true if a source is open
+******************************************/
+bool oca_energy_active() {
+	return energy_active;
+}
+
+/*****************************************
+* Function Name : oca_energy_now
+* Description   : energy since open. Power sources are extrapolated from the last sample at its power,
+*                 so regions shorter than the sampling period get the power of the sample before them.
+* Return value  : joules
+******************************************/
+double oca_energy_now() {
+	if (!energy_active) {
+		return 0;
+	}
+	if (energy_source.cumulative) {
+		double v = energy_source.read();
+		energy_last_j = v < 0 ? energy_last_j : v - energy_origin;
+		return energy_last_j;
+	}
+	uint64_t now = oca_stable_now_ns();
+	std::lock_guard<std::mutex> lock(energy_lock);
+	return energy_joules + energy_last_w * (double)(now - energy_last_ns) / 1E9;
+}
+
+/*****************************************
+* Function Name : oca_energy_source_name
+* Description   : name of the open source, "none" if closed
+******************************************/
+const char *oca_energy_source_name() {
+	return energy_active ? energy_source.name.c_str() : "none";
+}
@@ -0,0 +1,54 @@
+/***********************************************************************************************************************
+* Copyright (C) 2024 Renesas Electronics Corporation. All rights reserved.
+***********************************************************************************************************************/
+/***********************************************************************************************************************
+* File Name    : oca_energy.h
+* Version      : 1.00
+* Description  : Energy around timed regions from Linux power sources (hwmon, power_supply, command, file, replay)
+***********************************************************************************************************************/
+
+#ifndef OCA_ENERGY_H
+#define OCA_ENERGY_H
+
+/*****************************************
+* Includes
+******************************************/
+#include <functional>
+#include <string>
+
+/*****************************************
+* Macros
+******************************************/
+/* Sampling period of power (W) sources; energy counters are read directly */
+#define OCA_ENERGY_PERIOD_MS    (10)
+#define OCA_ENERGY_CMD_PERIOD_MS (100)          /* one fork per sample */
+
+/* Power trace replayed by "auto" when the system has no sensor, a stand-in for testing the report path */
+#define OCA_ENERGY_REPLAY_FILE  "resources/oca_energy_replay.txt"
+
+/* Opt-in model without a sensor: idle power plus power per busy core (process CPU time), DRP not included */
+#define OCA_ENERGY_MODEL_IDLE_W (1.0)
+#define OCA_ENERGY_MODEL_CORE_W (0.5)
+
+/*****************************************
+* Typedefs
+******************************************/
+/* A power source. read returns joules since any origin (cumulative) or watts, negative on failure. */
+struct oca_energy_source {
+	std::string name;                   /* reported as the energy_source environment key */
+	bool cumulative;
+	int period_ms;                      /* sampling period of a power source */
+	std::function<double()> read;
+};
+
+/*****************************************
+* Functions
+******************************************/
+int oca_energy_open(const char *spec);
+int oca_energy_set_source(const oca_energy_source &source);
+void oca_energy_close();
+bool oca_energy_active();
+double oca_energy_now();
+const char *oca_energy_source_name();
+
+#endif
@@ -0,0 +1,591 @@
+/***********************************************************************************************************************
+* Copyright (C) 2024 Renesas Electronics Corporation. All rights reserved.
+***********************************************************************************************************************/
+/***********************************************************************************************************************
+* File Name    : oca_frame_ring.cpp
+* Version      : 1.00
+* Description  : Zero-copy shared-memory frame ring for multi-process consumers
+***********************************************************************************************************************/
+
+/*****************************************
+* Includes
+******************************************/
+#include "define.h"
+#include "oca_frame_ring.h"
+#include <algorithm>
+#include <climits>
+#include <iostream>
+#include <new>
+#include <signal.h>
+#include <thread>
+#include <linux/futex.h>
+#include <sys/syscall.h>
+
+/*****************************************
+* Macros
+******************************************/
+#define RING_SLOTS              (8)
+#define RING_BENCH_FRAMES       (300)
+#define RING_BENCH_CONSUMERS    (2)
+
+static_assert(std::atomic<uint64_t>::is_always_lock_free, "ring needs lock-free 64-bit atomics across processes");
+static_assert(std::atomic<uint32_t>::is_always_lock_free, "ring needs lock-free 32-bit atomics across processes");
+
+/*****************************************
+* Global Variables
+******************************************/
+static volatile sig_atomic_t ring_stop;
+
+/*****************************************
+* Function Name : ring_on_signal
+* Description   : SIGINT/SIGTERM handler for the producer and consumer loops
+******************************************/
+static void ring_on_signal(int) {
+	ring_stop = 1;
+}
+
+/*****************************************
+* Function Name : ring_frame_bytes
+* Description   : payload size of one frame
+******************************************/
+static size_t ring_frame_bytes(uint32_t width, uint32_t height, uint32_t format) {
+	return format == OCA_RING_FMT_NV21 ? (size_t)width * height * 3 / 2 : (size_t)width * height * 3;
+}
+
+/*****************************************
+* Function Name : ring_align
+* Description   : round n up to a multiple of a
+******************************************/
+static size_t ring_align(size_t n, size_t a) {
+	return (n + a - 1) / a * a;
+}
+
+/*****************************************
+* Function Name : ring_futex
+* Description   : futex(2) on the shared header word (not FUTEX_PRIVATE: waiters live in other processes)
+******************************************/
+static long ring_futex(std::atomic<uint32_t> *addr, int op, uint32_t val, const struct timespec *timeout) {
+	return syscall(SYS_futex, reinterpret_cast<uint32_t *>(addr), op, val, timeout, nullptr, 0);
+}
+
+/*****************************************
+* Function Name : oca_ring_now_ns
+* Description   : CLOCK_MONOTONIC in ns, comparable between processes
+******************************************/
+uint64_t oca_ring_now_ns() {
+	struct timespec ts;
+	clock_gettime(CLOCK_MONOTONIC, &ts);
+	return (uint64_t)ts.tv_sec * 1000000000ull + ts.tv_nsec;
+}
+
+/*****************************************
+* Function Name : oca_ring_map
+* Description   : map an initialized ring fd and set up the local view
+* Return value  : 0 on success, negative errno on failure
+******************************************/
+static int oca_ring_map(oca_ring &ring, int fd) {
+	struct stat st;
+	if (fstat(fd, &st) < 0 || (size_t)st.st_size < sizeof(oca_ring_header)) {
+		return -EINVAL;
+	}
+	void *p = mmap(nullptr, st.st_size, PROT_READ | PROT_WRITE, MAP_SHARED, fd, 0);
+	if (p == MAP_FAILED) {
+		return -errno;
+	}
+	auto *hdr = static_cast<oca_ring_header *>(p);
+	if (hdr->magic != OCA_RING_MAGIC || hdr->version != OCA_RING_VERSION || hdr->map_size != (uint64_t)st.st_size) {
+		munmap(p, st.st_size);
+		return -EPROTO;
+	}
+	/* The header comes from another process: the slot table and every payload must lie inside the mapping */
+	uint64_t count = hdr->slot_count, stride = hdr->slot_stride, offset = hdr->data_offset, size = hdr->map_size;
+	if ((hdr->format != OCA_RING_FMT_BGR && hdr->format != OCA_RING_FMT_NV21) || count == 0 ||
+		stride < ring_frame_bytes(hdr->width, hdr->height, hdr->format) || stride == 0 ||
+		offset < sizeof(oca_ring_header) + count * sizeof(oca_ring_slot) || offset > size ||
+		count > (size - offset) / stride) {
+		munmap(p, st.st_size);
+		return -EPROTO;
+	}
+	ring.fd = fd;
+	ring.hdr = hdr;
+	ring.slots = reinterpret_cast<oca_ring_slot *>(hdr + 1);
+	ring.data = static_cast<uint8_t *>(p) + hdr->data_offset;
+	return 0;
+}
+
+/*****************************************
+* Function Name : oca_ring_create
+* Description   : create and initialize a ring
+* Arguments     : ring = local view (output)
+*                 name = POSIX shm name for attach by name, or nullptr for an anonymous memfd
+*                        (share ring.fd over a Unix socket or fork); must not exist yet
+*                        so a live ring of another producer is never overwritten
+*                 slot_count = number of frame slots
+*                 width, height, format = frame geometry (OCA_RING_FMT_*)
+* Return value  : 0 on success, negative errno on failure (-EEXIST when the name is taken)
+******************************************/
+int oca_ring_create(oca_ring &ring, const char *name, uint32_t slot_count, uint32_t width, uint32_t height,
+					uint32_t format) {
+	size_t page = (size_t)sysconf(_SC_PAGESIZE);
+	size_t stride = ring_align(ring_frame_bytes(width, height, format), page);
+	size_t data_offset = ring_align(sizeof(oca_ring_header) + slot_count * sizeof(oca_ring_slot), page);
+	size_t map_size = data_offset + stride * slot_count;
+	int fd = name ? shm_open(name, O_CREAT | O_EXCL | O_RDWR, 0600) : memfd_create("oca_frame_ring", MFD_CLOEXEC);
+	if (fd < 0) {
+		return -errno;
+	}
+	void *p = MAP_FAILED;
+	if (ftruncate(fd, (off_t)map_size) == 0) {
+		p = mmap(nullptr, map_size, PROT_READ | PROT_WRITE, MAP_SHARED, fd, 0);
+	}
+	if (p == MAP_FAILED) {
+		int err = -errno;
+		close(fd);
+		if (name) {
+			shm_unlink(name);
+		}
+		return err;
+	}
+
+	auto *hdr = new(p) oca_ring_header();
+	hdr->version = OCA_RING_VERSION;
+	hdr->slot_count = slot_count;
+	hdr->format = format;
+	hdr->width = width;
+	hdr->height = height;
+	hdr->slot_stride = stride;
+	hdr->data_offset = data_offset;
+	hdr->map_size = map_size;
+	hdr->write_seq = 1;
+	auto *slots = reinterpret_cast<oca_ring_slot *>(hdr + 1);
+	for (uint32_t i = 0; i < slot_count; i++) {
+		new(&slots[i]) oca_ring_slot();
+	}
+	/* Publish the layout last so attachers never see a half-built header */
+	std::atomic_thread_fence(std::memory_order_release);
+	hdr->magic = OCA_RING_MAGIC;
+	munmap(p, map_size);
+
+	int ret = oca_ring_map(ring, fd);
+	if (ret < 0) {
+		close(fd);
+		if (name) {
+			shm_unlink(name);
+		}
+	}
+	return ret;
+}
+
+/*****************************************
+* Function Name : oca_ring_attach
+* Description   : attach to a ring created with a shm name
+* Return value  : 0 on success, negative errno on failure
+******************************************/
+int oca_ring_attach(oca_ring &ring, const char *name) {
+	int fd = shm_open(name, O_RDWR, 0);
+	if (fd < 0) {
+		return -errno;
+	}
+	int ret = oca_ring_map(ring, fd);
+	if (ret < 0) {
+		close(fd);
+	}
+	return ret;
+}
+
+/*****************************************
+* Function Name : oca_ring_attach_fd
+* Description   : attach to a ring from a received memfd/shm fd (the fd is duplicated)
+* Return value  : 0 on success, negative errno on failure
+******************************************/
+int oca_ring_attach_fd(oca_ring &ring, int fd) {
+	int own = fcntl(fd, F_DUPFD_CLOEXEC, 0);
+	if (own < 0) {
+		return -errno;
+	}
+	int ret = oca_ring_map(ring, own);
+	if (ret < 0) {
+		close(own);
+	}
+	return ret;
+}
+
+/*****************************************
+* Function Name : oca_ring_close
+* Description   : unmap the ring, optionally removing its shm name
+******************************************/
+void oca_ring_close(oca_ring &ring, const char *unlink_name) {
+	if (ring.hdr) {
+		munmap(ring.hdr, ring.hdr->map_size);
+	}
+	if (ring.fd >= 0) {
+		close(ring.fd);
+	}
+	if (unlink_name) {
+		shm_unlink(unlink_name);
+	}
+	ring = oca_ring();
+}
+
+/*****************************************
+* Function Name : oca_ring_reserve
+* Description   : claim the next sequence and its slot for writing.
+*                 Never blocks: if a consumer still holds the slot the sequence is
+*                 skipped (counted in dropped), which consumers see as a missed frame.
+* Arguments     : seq = claimed sequence (output)
+* Return value  : slot payload, or nullptr if the frame was dropped
+******************************************/
+uint8_t *oca_ring_reserve(oca_ring &ring, uint64_t *seq) {
+	uint64_t s = ring.hdr->write_seq.fetch_add(1, std::memory_order_acq_rel);
+	uint32_t idx = (uint32_t)(s % ring.hdr->slot_count);
+	uint32_t expected = 0;
+	if (!ring.slots[idx].ref.compare_exchange_strong(expected, OCA_RING_REF_WRITER, std::memory_order_acquire)) {
+		ring.hdr->dropped.fetch_add(1, std::memory_order_relaxed);
+		return nullptr;
+	}
+	*seq = s;
+	return ring.data + idx * ring.hdr->slot_stride;
+}
+
+/*****************************************
+* Function Name : oca_ring_publish
+* Description   : make a reserved slot visible to consumers and wake waiters
+******************************************/
+void oca_ring_publish(oca_ring &ring, uint64_t seq) {
+	oca_ring_slot &slot = ring.slots[seq % ring.hdr->slot_count];
+	slot.bytes = (uint32_t)ring_frame_bytes(ring.hdr->width, ring.hdr->height, ring.hdr->format);
+	slot.timestamp_ns = oca_ring_now_ns();
+	slot.seq.store(seq, std::memory_order_release);
+	slot.ref.store(0, std::memory_order_release);
+
+	uint64_t p = ring.hdr->published.load(std::memory_order_relaxed);
+	while (p < seq && !ring.hdr->published.compare_exchange_weak(p, seq, std::memory_order_release)) {
+	}
+	ring.hdr->futex.fetch_add(1);
+	if (ring.hdr->waiters.load() > 0) {
+		ring_futex(&ring.hdr->futex, FUTEX_WAKE, INT_MAX, nullptr);
+	}
+}
+
+/*****************************************
+* Function Name : oca_ring_acquire
+* Description   : take a reference on a published frame and wrap it as cv::Mat
+* Arguments     : seq = wanted sequence
+*                 frame = output, valid until oca_ring_release
+* Return value  : 0 on success
+*                 -EAGAIN if seq is not published yet
+*                 -ENOENT if seq was dropped or already overwritten
+******************************************/
+int oca_ring_acquire(oca_ring &ring, uint64_t seq, oca_ring_frame &frame) {
+	if (seq == 0 || seq > ring.hdr->published.load(std::memory_order_acquire)) {
+		return -EAGAIN;
+	}
+	uint32_t idx = (uint32_t)(seq % ring.hdr->slot_count);
+	oca_ring_slot &slot = ring.slots[idx];
+	uint32_t r = slot.ref.load(std::memory_order_relaxed);
+	do {
+		if (r & OCA_RING_REF_WRITER) {
+			return -ENOENT;
+		}
+	} while (!slot.ref.compare_exchange_weak(r, r + 1, std::memory_order_acquire, std::memory_order_relaxed));
+
+	if (slot.seq.load(std::memory_order_acquire) != seq) {
+		slot.ref.fetch_sub(1, std::memory_order_release);
+		return -ENOENT;
+	}
+	frame.seq = seq;
+	frame.timestamp_ns = slot.timestamp_ns;
+	frame.mat = oca_ring_mat(ring, ring.data + idx * ring.hdr->slot_stride);
+	return 0;
+}
+
+/*****************************************
+* Function Name : oca_ring_release
+* Description   : drop the reference taken by oca_ring_acquire
+******************************************/
+void oca_ring_release(oca_ring &ring, oca_ring_frame &frame) {
+	frame.mat.release();
+	ring.slots[frame.seq % ring.hdr->slot_count].ref.fetch_sub(1, std::memory_order_release);
+}
+
+/*****************************************
+* Function Name : oca_ring_latest
+* Description   : highest published sequence, 0 if none
+******************************************/
+uint64_t oca_ring_latest(const oca_ring &ring) {
+	return ring.hdr->published.load(std::memory_order_acquire);
+}
+
+/*****************************************
+* Function Name : oca_ring_wait
+* Description   : block until seq is published
+* Arguments     : seq = wanted sequence
+*                 timeout_ms = maximum wait
+* Return value  : 0 when published, -ETIMEDOUT otherwise
+******************************************/
+int oca_ring_wait(oca_ring &ring, uint64_t seq, int timeout_ms) {
+	uint64_t deadline = oca_ring_now_ns() + (uint64_t)timeout_ms * 1000000ull;
+	while (oca_ring_latest(ring) < seq) {
+		uint32_t f = ring.hdr->futex.load();
+		if (oca_ring_latest(ring) >= seq) {
+			break;
+		}
+		uint64_t now = oca_ring_now_ns();
+		if (now >= deadline) {
+			return -ETIMEDOUT;
+		}
+		struct timespec ts = {(time_t)((deadline - now) / 1000000000ull), (long)((deadline - now) % 1000000000ull)};
+		ring.hdr->waiters.fetch_add(1);
+		ring_futex(&ring.hdr->futex, FUTEX_WAIT, f, &ts);
+		ring.hdr->waiters.fetch_sub(1);
+	}
+	return 0;
+}
+
+/*****************************************
+* Function Name : oca_ring_mat
+* Description   : cv::Mat header over a slot payload (no copy)
+******************************************/
+cv::Mat oca_ring_mat(const oca_ring &ring, uint8_t *payload) {
+	if (ring.hdr->format == OCA_RING_FMT_NV21) {
+		return cv::Mat((int)(ring.hdr->height * 3 / 2), (int)ring.hdr->width, CV_8UC1, payload);
+	}
+	return cv::Mat((int)ring.hdr->height, (int)ring.hdr->width, CV_8UC3, payload);
+}
+
+/*****************************************
+* Function Name : oca_ring_produce
+* Description   : synthetic producer. Replays a raw NV21 file (looping) or a BGR image
+*                 into the named ring at a fixed rate until SIGINT/SIGTERM.
+* Arguments     : yuv_file = NV21 file, or nullptr to replay image_file as BGR
+*                 image_file = BGR source image
+*                 width, height = frame size
+*                 fps = publish rate
+* Return value  : 0 on success, -1 on error
+******************************************/
+int oca_ring_produce(const char *yuv_file, const std::string &image_file, uint32_t width, uint32_t height, int fps) {
+	uint32_t format = yuv_file ? OCA_RING_FMT_NV21 : OCA_RING_FMT_BGR;
+	std::streamsize bytes = (std::streamsize)ring_frame_bytes(width, height, format);
+	std::ifstream yuv;
+	cv::Mat image;
+	oca_ring ring;
+
+	if (yuv_file) {
+		yuv.open(yuv_file, std::ios::binary);
+		if (!yuv.is_open()) {
+			std::cerr << "Error: Cannot open " << yuv_file << std::endl;
+			return -1;
+		}
+	} else {
+		image = cv::imread(image_file, cv::IMREAD_COLOR);
+		if (image.empty()) {
+			std::cerr << "Error: Cannot read " << image_file << std::endl;
+			return -1;
+		}
+		cv::resize(image, image, {(int)width, (int)height});
+	}
+	int ret = oca_ring_create(ring, OCA_RING_NAME, RING_SLOTS, width, height, format);
+	if (ret == -EEXIST) {
+		std::cerr << "Error: " << OCA_RING_NAME << " already exists: another producer is running, or a killed one left"
+				  << " it behind (remove /dev/shm" << OCA_RING_NAME << ")" << std::endl;
+		return -1;
+	}
+	if (ret < 0) {
+		std::cerr << "Error: Cannot create " << OCA_RING_NAME << ": " << strerror(-ret) << std::endl;
+		return -1;
+	}
+
+	signal(SIGINT, ring_on_signal);
+	signal(SIGTERM, ring_on_signal);
+	printf("[RING] producing %s %ux%u at %dfps on %s\n", yuv_file ? "NV21" : "BGR", width, height, fps, OCA_RING_NAME);
+
+	struct timespec next;
+	clock_gettime(CLOCK_MONOTONIC, &next);
+	uint64_t period_ns = 1000000000ull / (uint64_t)std::max(fps, 1);
+	uint64_t report = oca_ring_now_ns() + 1000000000ull;
+	uint64_t frames = 0;
+	while (!ring_stop) {
+		uint64_t seq;
+		uint8_t *p = oca_ring_reserve(ring, &seq);
+		if (p) {
+			if (yuv_file) {
+				yuv.read(reinterpret_cast<char *>(p), bytes);
+				if (yuv.gcount() != bytes) {
+					yuv.clear();
+					yuv.seekg(0);
+					yuv.read(reinterpret_cast<char *>(p), bytes);
+				}
+				if (yuv.gcount() != bytes) {
+					std::cerr << "Error: " << yuv_file << " is shorter than one frame" << std::endl;
+					break;
+				}
+			} else {
+				image.copyTo(oca_ring_mat(ring, p));
+			}
+			oca_ring_publish(ring, seq);
+			frames++;
+		}
+
+		next.tv_nsec += (long)period_ns;
+		while (next.tv_nsec >= 1000000000L) {
+			next.tv_nsec -= 1000000000L;
+			next.tv_sec++;
+		}
+		clock_nanosleep(CLOCK_MONOTONIC, TIMER_ABSTIME, &next, nullptr);
+
+		if (oca_ring_now_ns() >= report) {
+			printf("[RING] published %llu dropped %llu\n", (unsigned long long)frames,
+				   (unsigned long long)ring.hdr->dropped.load());
+			report += 1000000000ull;
+		}
+	}
+	oca_ring_close(ring, OCA_RING_NAME);
+	return 0;
+}
+
+/*****************************************
+* Function Name : oca_ring_consume
+* Description   : attach to the named ring and report received fps, latency and
+*                 missed frames once per second until SIGINT/SIGTERM
+* Return value  : 0 on success, -1 on error
+******************************************/
+int oca_ring_consume() {
+	oca_ring ring;
+	int ret = oca_ring_attach(ring, OCA_RING_NAME);
+	if (ret < 0) {
+		std::cerr << "Error: Cannot attach " << OCA_RING_NAME << ": " << strerror(-ret) << std::endl;
+		return -1;
+	}
+	signal(SIGINT, ring_on_signal);
+	signal(SIGTERM, ring_on_signal);
+
+	uint64_t next = oca_ring_latest(ring) + 1;
+	uint64_t frames = 0, missed = 0;
+	double latency_us = 0;
+	uint64_t report = oca_ring_now_ns() + 1000000000ull;
+	while (!ring_stop) {
+		if (oca_ring_wait(ring, next, 100) == 0) {
+			oca_ring_frame frame;
+			ret = oca_ring_acquire(ring, next, frame);
+			if (ret == 0) {
+				oca_s = frame.mat.data[0]; //for suppress optimization
+				latency_us += (double)(oca_ring_now_ns() - frame.timestamp_ns) / 1E3;
+				oca_ring_release(ring, frame);
+				frames++;
+				next++;
+			} else if (ret == -ENOENT) {
+				missed++;
+				next++;
+			}
+		}
+		if (oca_ring_now_ns() >= report) {
+			printf("[RING] received %llu fps, latency %.1fusec, missed %llu\n", (unsigned long long)frames,
+				   frames ? latency_us / frames : 0.0, (unsigned long long)missed);
+			frames = missed = 0;
+			latency_us = 0;
+			report += 1000000000ull;
+		}
+	}
+	oca_ring_close(ring, nullptr);
+	return 0;
+}
+
+/*****************************************
+* Function Name : ring_bench_consumer
+* Description   : benchmark consumer. Zero-copy touches the slot in place,
+*                 copy mode clones it into a private cv::Mat first (the current pattern).
+******************************************/
+static void ring_bench_consumer(oca_ring &ring, uint64_t last, bool copy, std::vector<double> &latency_us,
+								uint64_t &missed) {
+	cv::Mat own;
+	uint64_t next = 1;
+	while (next <= last) {
+		if (oca_ring_wait(ring, next, 1000) < 0) {
+			break;
+		}
+		oca_ring_frame frame;
+		int ret = oca_ring_acquire(ring, next, frame);
+		if (ret == -ENOENT) {
+			missed++;
+			next++;
+			continue;
+		}
+		if (ret < 0) {
+			continue;
+		}
+		if (copy) {
+			frame.mat.copyTo(own);
+			oca_s = own.data[own.total() * own.elemSize() - 1]; //for suppress optimization
+		} else {
+			oca_s = frame.mat.data[frame.mat.total() * frame.mat.elemSize() - 1]; //for suppress optimization
+		}
+		latency_us.push_back((double)(oca_ring_now_ns() - frame.timestamp_ns) / 1E3);
+		oca_ring_release(ring, frame);
+		next++;
+	}
+}
+
+/*****************************************
+* Function Name : oca_ring_benchmark
+* Description   : throughput and publish-to-consumer latency of a memfd ring with
+*                 RING_BENCH_CONSUMERS consumers, zero-copy versus copy-out
+* Arguments     : image = BGR frame to publish
+* Return value  : -
+******************************************/
+void oca_ring_benchmark(const cv::Mat &image) {
+	printf("[RING] %dx%d(BGR) %d frames, %d consumers, %d slots\n", image.cols, image.rows, RING_BENCH_FRAMES,
+		   RING_BENCH_CONSUMERS, RING_SLOTS);
+	for (int copy = 0; copy < 2; copy++) {
+		oca_ring ring;
+		int ret = oca_ring_create(ring, nullptr, RING_SLOTS, image.cols, image.rows, OCA_RING_FMT_BGR);
+		if (ret < 0) {
+			std::cerr << "Error: Cannot create ring: " << strerror(-ret) << std::endl;
+			return;
+		}
+
+		std::vector<double> latency[RING_BENCH_CONSUMERS];
+		uint64_t missed[RING_BENCH_CONSUMERS] = {};
+		std::vector<std::thread> consumers;
+		for (int c = 0; c < RING_BENCH_CONSUMERS; c++) {
+			consumers.emplace_back(ring_bench_consumer, std::ref(ring), (uint64_t)RING_BENCH_FRAMES, copy != 0,
+								   std::ref(latency[c]), std::ref(missed[c]));
+		}
+
+		/* Single producer: wait for the slot instead of dropping so every sequence is delivered if consumers keep up */
+		uint64_t start = oca_ring_now_ns();
+		for (int i = 0; i < RING_BENCH_FRAMES; i++) {
+			uint64_t seq;
+			while (ring.slots[ring.hdr->write_seq.load() % RING_SLOTS].ref.load() != 0) {
+				std::this_thread::yield();
+			}
+			uint8_t *p = oca_ring_reserve(ring, &seq);
+			if (p) {
+				image.copyTo(oca_ring_mat(ring, p));
+				oca_ring_publish(ring, seq);
+			}
+		}
+		for (std::thread &t: consumers) {
+			t.join();
+		}
+		double elapsed_ms = (double)(oca_ring_now_ns() - start) / 1E6;
+
+		std::vector<double> all;
+		uint64_t miss = 0;
+		for (int c = 0; c < RING_BENCH_CONSUMERS; c++) {
+			all.insert(all.end(), latency[c].begin(), latency[c].end());
+			miss += missed[c];
+		}
+		std::sort(all.begin(), all.end());
+		double mean = 0;
+		for (double v: all) {
+			mean += v;
+		}
+		mean = all.empty() ? 0 : mean / all.size();
+		printf("[RING] %-9s %8.1f frames/s per consumer  latency mean %8.1f p50 %8.1f p99 %8.1f usec  missed %llu\n",
+			   copy ? "copy" : "zero-copy", all.size() / (double)RING_BENCH_CONSUMERS / (elapsed_ms / 1E3), mean,
+			   all.empty() ? 0 : all[all.size() / 2], all.empty() ? 0 : all[all.size() * 99 / 100],
+			   (unsigned long long)miss);
+		oca_ring_close(ring, nullptr);
+	}
+	printf("\n");
+}
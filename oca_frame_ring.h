@@ -0,0 +1,100 @@
+/***********************************************************************************************************************
+* Copyright (C) 2024 Renesas Electronics Corporation. All rights reserved.
+***********************************************************************************************************************/
+/***********************************************************************************************************************
+* File Name    : oca_frame_ring.h
+* Version      : 1.00
+* Description  : Zero-copy shared-memory frame ring for multi-process consumers
+***********************************************************************************************************************/
+
+#ifndef OCA_FRAME_RING_H
+#define OCA_FRAME_RING_H
+
+/*****************************************
+* Includes
+******************************************/
+#include <stdint.h>
+#include <atomic>
+#include <opencv2/opencv.hpp>
+
+/*****************************************
+* Macros
+******************************************/
+#define OCA_RING_MAGIC          (0x4f434152)    /* "OCAR" */
+#define OCA_RING_VERSION        (1)
+#define OCA_RING_NAME           "/oca_frame_ring"
+
+/* Frame format */
+#define OCA_RING_FMT_BGR        (0)     /* CV_8UC3, height rows */
+#define OCA_RING_FMT_NV21       (1)     /* CV_8UC1, height * 3 / 2 rows (Y plane + interleaved VU) */
+
+/* Slot reference word: upper bit is held by the producer while writing, lower bits count consumers */
+#define OCA_RING_REF_WRITER     (0x80000000u)
+
+/*****************************************
+* Typedefs
+******************************************/
+/* Per-slot control block, one cache line each */
+struct alignas(64) oca_ring_slot {
+	std::atomic<uint64_t> seq;          /* sequence stored in the slot, 0 = empty */
+	std::atomic<uint32_t> ref;          /* OCA_RING_REF_WRITER | consumer count */
+	uint32_t bytes;                     /* payload size */
+	uint64_t timestamp_ns;              /* CLOCK_MONOTONIC at publish */
+};
+
+/* Shared header at offset 0 of the mapping. Slot control blocks follow, then page-aligned payloads */
+struct alignas(64) oca_ring_header {
+	uint32_t magic;
+	uint32_t version;
+	uint32_t slot_count;
+	uint32_t format;
+	uint32_t width;
+	uint32_t height;
+	uint64_t slot_stride;               /* payload bytes per slot, page aligned */
+	uint64_t data_offset;               /* offset of slot 0 payload */
+	uint64_t map_size;
+	alignas(64) std::atomic<uint64_t> write_seq;    /* next sequence handed to a producer */
+	std::atomic<uint64_t> published;                /* highest published sequence */
+	std::atomic<uint64_t> dropped;                  /* reserves refused because the slot was held */
+	alignas(64) std::atomic<uint32_t> futex;        /* bumped on every publish */
+	std::atomic<uint32_t> waiters;
+};
+
+/* Process-local view of a ring */
+struct oca_ring {
+	int fd = -1;
+	oca_ring_header *hdr = nullptr;
+	oca_ring_slot *slots = nullptr;
+	uint8_t *data = nullptr;
+};
+
+/* Frame held by a consumer. mat wraps the slot payload directly */
+struct oca_ring_frame {
+	uint64_t seq = 0;
+	uint64_t timestamp_ns = 0;
+	cv::Mat mat;
+};
+
+/*****************************************
+* Functions
+******************************************/
+int oca_ring_create(oca_ring &ring, const char *name, uint32_t slot_count, uint32_t width, uint32_t height,
+					uint32_t format);
+int oca_ring_attach(oca_ring &ring, const char *name);
+int oca_ring_attach_fd(oca_ring &ring, int fd);
+void oca_ring_close(oca_ring &ring, const char *unlink_name);
+
+uint8_t *oca_ring_reserve(oca_ring &ring, uint64_t *seq);
+void oca_ring_publish(oca_ring &ring, uint64_t seq);
+int oca_ring_acquire(oca_ring &ring, uint64_t seq, oca_ring_frame &frame);
+void oca_ring_release(oca_ring &ring, oca_ring_frame &frame);
+uint64_t oca_ring_latest(const oca_ring &ring);
+int oca_ring_wait(oca_ring &ring, uint64_t seq, int timeout_ms);
+cv::Mat oca_ring_mat(const oca_ring &ring, uint8_t *payload);
+uint64_t oca_ring_now_ns();
+
+int oca_ring_produce(const char *yuv_file, const std::string &image_file, uint32_t width, uint32_t height, int fps);
+int oca_ring_consume();
+void oca_ring_benchmark(const cv::Mat &image);
+
+#endif
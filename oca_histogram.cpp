@@ -0,0 +1,106 @@
+/***********************************************************************************************************************
+* Copyright (C) 2024 Renesas Electronics Corporation. All rights reserved.
+***********************************************************************************************************************/
+/***********************************************************************************************************************
+* File Name    : oca_histogram.cpp
+* Version      : 1.00
+* Description  : HDR-style log-linear latency histogram with lock-free recording
+***********************************************************************************************************************/
+
+/*****************************************
+* Includes
+******************************************/
+#include "define.h"
+#include "oca_histogram.h"
+
+/*****************************************
+* Function Name : oca_hist_index
+* Description   : bucket of a value. Values below 2 * OCA_HIST_SUB_COUNT are exact; above, each power of
+*                 two [2^m, 2^(m+1)) is split into OCA_HIST_SUB_COUNT equal buckets.
+******************************************/
+int oca_hist_index(uint64_t value) {
+	if (value < 2 * OCA_HIST_SUB_COUNT) {
+		return (int)value;
+	}
+	int m = 63 - __builtin_clzll(value);
+	int shift = m - OCA_HIST_SUB_BITS;
+	int sub = (int)(value >> shift) - OCA_HIST_SUB_COUNT;
+	return 2 * OCA_HIST_SUB_COUNT + (m - OCA_HIST_SUB_BITS - 1) * OCA_HIST_SUB_COUNT + sub;
+}
+
+/*****************************************
+* Function Name : oca_hist_upper
+* Description   : highest value of a bucket, used for percentiles so they never under-report
+******************************************/
+uint64_t oca_hist_upper(int index) {
+	if (index < 2 * OCA_HIST_SUB_COUNT) {
+		return (uint64_t)index;
+	}
+	int k = index - 2 * OCA_HIST_SUB_COUNT;
+	int shift = k / OCA_HIST_SUB_COUNT + 1;
+	uint64_t sub = (uint64_t)(k % OCA_HIST_SUB_COUNT + OCA_HIST_SUB_COUNT);
+	return ((sub + 1) << shift) - 1;
+}
+
+/*****************************************
+* Function Name : oca_hist_reset
+* Description   : clear all counts
+******************************************/
+void oca_hist_reset(oca_histogram &h) {
+	for (std::atomic<uint64_t> &c: h.count) {
+		c.store(0, std::memory_order_relaxed);
+	}
+	h.total.store(0, std::memory_order_relaxed);
+	h.sum.store(0, std::memory_order_relaxed);
+	h.min.store(UINT64_MAX, std::memory_order_relaxed);
+	h.max.store(0, std::memory_order_relaxed);
+}
+
+/*****************************************
+* Function Name : oca_hist_record
+* Description   : add one value, wait-free apart from the min / max update
+******************************************/
+void oca_hist_record(oca_histogram &h, uint64_t value) {
+	h.count[oca_hist_index(value)].fetch_add(1, std::memory_order_relaxed);
+	h.total.fetch_add(1, std::memory_order_relaxed);
+	h.sum.fetch_add(value, std::memory_order_relaxed);
+	uint64_t v = h.min.load(std::memory_order_relaxed);
+	while (value < v && !h.min.compare_exchange_weak(v, value, std::memory_order_relaxed)) {
+	}
+	v = h.max.load(std::memory_order_relaxed);
+	while (value > v && !h.max.compare_exchange_weak(v, value, std::memory_order_relaxed)) {
+	}
+}
+
+/*****************************************
+* Function Name : oca_hist_percentile
+* Description   : value at a percentile (0..100), clamped to the recorded maximum
+* Return value  : 0 if empty
+******************************************/
+uint64_t oca_hist_percentile(const oca_histogram &h, double percentile) {
+	uint64_t total = h.total.load(std::memory_order_relaxed);
+	if (total == 0) {
+		return 0;
+	}
+	uint64_t target = (uint64_t)ceil(percentile / 100.0 * (double)total);
+	uint64_t seen = 0;
+	target = target < 1 ? 1 : target;
+	for (int i = 0; i < OCA_HIST_BUCKETS; i++) {
+		seen += h.count[i].load(std::memory_order_relaxed);
+		if (seen >= target) {
+			uint64_t v = oca_hist_upper(i);
+			uint64_t max = h.max.load(std::memory_order_relaxed);
+			return v < max ? v : max;
+		}
+	}
+	return h.max.load(std::memory_order_relaxed);
+}
+
+/*****************************************
+* Function Name : oca_hist_mean
+* Description   : exact mean of the recorded values
+******************************************/
+double oca_hist_mean(const oca_histogram &h) {
+	uint64_t total = h.total.load(std::memory_order_relaxed);
+	return total ? (double)h.sum.load(std::memory_order_relaxed) / (double)total : 0;
+}
@@ -0,0 +1,49 @@
+/***********************************************************************************************************************
+* Copyright (C) 2024 Renesas Electronics Corporation. All rights reserved.
+***********************************************************************************************************************/
+/***********************************************************************************************************************
+* File Name    : oca_histogram.h
+* Version      : 1.00
+* Description  : HDR-style log-linear latency histogram with lock-free recording
+***********************************************************************************************************************/
+
+#ifndef OCA_HISTOGRAM_H
+#define OCA_HISTOGRAM_H
+
+/*****************************************
+* Includes
+******************************************/
+#include <stdint.h>
+#include <atomic>
+
+/*****************************************
+* Macros
+******************************************/
+/* 2^7 linear sub-buckets per power of two: values are kept within 1/128 (0.8%) from 1ns to 2^64ns */
+#define OCA_HIST_SUB_BITS       (7)
+#define OCA_HIST_SUB_COUNT      (1 << OCA_HIST_SUB_BITS)
+#define OCA_HIST_BUCKETS        (2 * OCA_HIST_SUB_COUNT + (64 - OCA_HIST_SUB_BITS - 1) * OCA_HIST_SUB_COUNT)
+
+/*****************************************
+* Typedefs
+******************************************/
+/* Values in ns. oca_hist_record may be called from any thread; read after the writers are done */
+struct oca_histogram {
+	std::atomic<uint64_t> count[OCA_HIST_BUCKETS];
+	std::atomic<uint64_t> total;
+	std::atomic<uint64_t> sum;
+	std::atomic<uint64_t> min;
+	std::atomic<uint64_t> max;
+};
+
+/*****************************************
+* Functions
+******************************************/
+void oca_hist_reset(oca_histogram &h);
+void oca_hist_record(oca_histogram &h, uint64_t value);
+uint64_t oca_hist_percentile(const oca_histogram &h, double percentile);
+double oca_hist_mean(const oca_histogram &h);
+int oca_hist_index(uint64_t value);
+uint64_t oca_hist_upper(int index);
+
+#endif
@@ -0,0 +1,271 @@
+/***********************************************************************************************************************
+* Copyright (C) 2024 Renesas Electronics Corporation. All rights reserved.
+***********************************************************************************************************************/
+/***********************************************************************************************************************
+* File Name    : oca_incremental.cpp
+* Version      : 1.00
+* Description  : Dirty-region incremental processing: recompute filter outputs only for tiles that changed
+***********************************************************************************************************************/
+
+/*****************************************
+* Includes
+******************************************/
+#include "define.h"
+#include "oca_incremental.h"
+#include "oca_op_table.h"
+#include "oca_report.h"
+#include "oca_stable.h"
+#include <algorithm>
+#include <functional>
+#include <opencv2/core/hal/intrin.hpp>
+
+/*****************************************
+* Macros
+******************************************/
+#define INC_SPRITE_SIZE         (96)            /* moving objects of the synthetic sequence */
+#define INC_SPRITE_STEP         (8)             /* pixels per frame */
+
+/*****************************************
+* Typedefs
+******************************************/
+/* Op with the case parameters and its halo: the input margin one output pixel depends on */
+struct inc_op {
+	const oca_op_desc *desc;            /* case: name and circuits */
+	int halo;
+	bool gray;                          /* runs on the grayscale frame */
+	std::function<void(const cv::Mat &, cv::Mat &)> run;
+};
+
+/*****************************************
+* Function Name : row_sad
+* Description   : sum of absolute differences of one row
+******************************************/
+static uint32_t row_sad(const uint8_t *a, const uint8_t *b, int len) {
+	int i = 0;
+	uint32_t sad = 0;
+#if CV_SIMD128
+	/* Each u16 lane gains up to 2 * 255 per vector, so it holds 128 vectors (2048 bytes), above one tile row */
+	static_assert(OCA_INC_TILE * 4 <= 128 * 16, "row_sad: a tile row of up to 4 channels overflows the u16 lanes");
+	cv::v_uint16x8 acc = cv::v_setzero_u16();
+	for (; i <= len - 16; i += 16) {
+		cv::v_uint16x8 d0, d1;
+		cv::v_expand(cv::v_absdiff(cv::v_load(a + i), cv::v_load(b + i)), d0, d1);
+		acc = acc + d0 + d1;
+	}
+	cv::v_uint32x4 s0, s1;
+	cv::v_expand(acc, s0, s1);
+	sad = cv::v_reduce_sum(s0 + s1);
+#endif
+	for (; i < len; i++) {
+		sad += (uint32_t)std::abs((int)a[i] - (int)b[i]);
+	}
+	return sad;
+}
+
+/*****************************************
+* Function Name : oca_tile_diff
+* Description   : mark the OCA_INC_TILE tiles whose SAD between two 8-bit frames exceeds threshold,
+*                 tile rows in parallel
+* Arguments     : prev, cur = frames of the same size and type
+*                 threshold = SAD limit per tile
+*                 map = output
+******************************************/
+void oca_tile_diff(const cv::Mat &prev, const cv::Mat &cur, uint32_t threshold, oca_tile_map &map) {
+	CV_Assert(prev.size() == cur.size() && prev.type() == cur.type() && prev.depth() == CV_8U);
+	const int cn = cur.channels();
+	map.cols = (cur.cols + OCA_INC_TILE - 1) / OCA_INC_TILE;
+	map.rows = (cur.rows + OCA_INC_TILE - 1) / OCA_INC_TILE;
+	map.dirty.assign((size_t)map.cols * map.rows, 0);
+	cv::parallel_for_(cv::Range(0, map.rows), [&](const cv::Range &range) {
+		for (int ty = range.start; ty < range.end; ty++) {
+			int y1 = std::min(cur.rows, (ty + 1) * OCA_INC_TILE);
+			for (int tx = 0; tx < map.cols; tx++) {
+				int x0 = tx * OCA_INC_TILE * cn;
+				int len = std::min(cur.cols * cn, (tx + 1) * OCA_INC_TILE * cn) - x0;
+				uint32_t sad = 0;
+				for (int y = ty * OCA_INC_TILE; y < y1 && sad <= threshold; y++) {
+					sad += row_sad(prev.ptr<uint8_t>(y) + x0, cur.ptr<uint8_t>(y) + x0, len);
+				}
+				map.dirty[(size_t)ty * map.cols + tx] = (sad > threshold);
+			}
+		}
+	});
+	map.count = (int)std::count(map.dirty.begin(), map.dirty.end(), 1);
+}
+
+/*****************************************
+* Function Name : oca_tile_regions
+* Description   : grow the dirty tiles by the halo, since a changed input pixel changes the output up to halo
+*                 pixels away, then merge horizontally adjacent tiles into runs. inner = output area to patch,
+*                 outer = inner grown by halo and clipped to the frame, the input to recompute it from
+******************************************/
+void oca_tile_regions(const oca_tile_map &map, cv::Size size, int halo, std::vector<cv::Rect> &inner,
+					  std::vector<cv::Rect> &outer) {
+	const cv::Rect frame(0, 0, size.width, size.height);
+	const int grow = (halo + OCA_INC_TILE - 1) / OCA_INC_TILE;
+	std::vector<uint8_t> affected(map.dirty.size(), 0);
+	inner.clear();
+	outer.clear();
+	for (int ty = 0; ty < map.rows; ty++) {
+		for (int tx = 0; tx < map.cols; tx++) {
+			if (!map.dirty[(size_t)ty * map.cols + tx]) {
+				continue;
+			}
+			for (int y = std::max(0, ty - grow); y <= std::min(map.rows - 1, ty + grow); y++) {
+				for (int x = std::max(0, tx - grow); x <= std::min(map.cols - 1, tx + grow); x++) {
+					affected[(size_t)y * map.cols + x] = 1;
+				}
+			}
+		}
+	}
+	for (int ty = 0; ty < map.rows; ty++) {
+		for (int tx = 0; tx < map.cols;) {
+			if (!affected[(size_t)ty * map.cols + tx]) {
+				tx++;
+				continue;
+			}
+			int end = tx;
+			while (end < map.cols && affected[(size_t)ty * map.cols + end]) {
+				end++;
+			}
+			cv::Rect r(tx * OCA_INC_TILE, ty * OCA_INC_TILE, (end - tx) * OCA_INC_TILE, OCA_INC_TILE);
+			r &= frame;
+			inner.push_back(r);
+			outer.push_back(cv::Rect(r.x - halo, r.y - halo, r.width + 2 * halo, r.height + 2 * halo) & frame);
+			tx = end;
+		}
+	}
+}
+
+/*****************************************
+* Function Name : make_frame
+* Description   : frame k of the synthetic sequence: the static image with two patches moving across it
+******************************************/
+static void make_frame(const cv::Mat &background, int k, cv::Mat &frame) {
+	background.copyTo(frame);
+	const int s = INC_SPRITE_SIZE;
+	const int span = background.cols - s;
+	cv::Rect a((k * INC_SPRITE_STEP) % span, background.rows / 3, s, s);
+	cv::Rect b(span - (k * INC_SPRITE_STEP) % span, background.rows * 2 / 3, s, s);
+	background(cv::Rect(0, 0, s, s)).copyTo(frame(a));
+	background(cv::Rect(background.cols - s, background.rows - s, s, s)).copyTo(frame(b));
+}
+
+/*****************************************
+* Function Name : elapsed_ms
+* Description   : msec since t0
+******************************************/
+static double elapsed_ms(uint64_t t0) {
+	return (double)(oca_stable_now_ns() - t0) / 1E6;
+}
+
+/*****************************************
+* Function Name : oca_incremental_benchmark
+* Description   : on a synthetic mostly-static sequence, compare full-frame recompute with recomputing only
+*                 dirty tiles (plus halo) into a persistent output, on the CPU and OCA paths. The first
+*                 frame is always computed in full. Reports dirty tiles, pixels processed, latency and the
+*                 max difference between the patched and the full-frame output, which must be 0.
+* Arguments     : image = FHD BGR frame used as the static background
+*                 OCA_f = OCA_Activate function list
+*                 frames = sequence length
+* Return value  : 0 on success, -1 if a patched output differs from the full-frame output
+******************************************/
+int oca_incremental_benchmark(const cv::Mat &image, unsigned long *OCA_f, int frames) {
+	/* 3x3 morphology: one pixel of halo per iteration, two passes for an opening */
+	constexpr int dilate_n = oca_case<OCA_CASE_DILATE>.iterations;
+	constexpr int erode_n = oca_case<OCA_CASE_ERODE>.iterations;
+	constexpr int open_n = oca_case<OCA_CASE_MORPHOLOGY>.iterations;
+	const inc_op ops[] = {
+		{&oca_op_table[OCA_CASE_GAUSSIAN], 3, false,
+			[](const cv::Mat &s, cv::Mat &d) { cv::GaussianBlur(s, d, {7, 7}, 0, 0); }},
+		{&oca_op_table[OCA_CASE_SOBEL], 1, false,
+			[](const cv::Mat &s, cv::Mat &d) { cv::Sobel(s, d, -1, 1, 0); }},
+		{&oca_op_table[OCA_CASE_DILATE], dilate_n, false,
+			[](const cv::Mat &s, cv::Mat &d) { cv::dilate(s, d, cv::Mat(), cv::Point(-1, -1), dilate_n); }},
+		{&oca_op_table[OCA_CASE_ERODE], erode_n, false,
+			[](const cv::Mat &s, cv::Mat &d) { cv::erode(s, d, cv::Mat(), cv::Point(-1, -1), erode_n); }},
+		{&oca_op_table[OCA_CASE_MORPHOLOGY], 2 * open_n, false,
+			[](const cv::Mat &s, cv::Mat &d) {
+				cv::morphologyEx(s, d, cv::MORPH_OPEN, cv::Mat(), cv::Point(-1, -1), open_n);
+			}},
+		{&oca_op_table[OCA_CASE_A_THRESHOLD], 49, true,
+			[](const cv::Mat &s, cv::Mat &d) {
+				cv::adaptiveThreshold(s, d, 0xFF, cv::ADAPTIVE_THRESH_MEAN_C, cv::THRESH_BINARY, 99, 0);
+			}},
+	};
+	cv::Mat frame, prev, gray, prev_gray;
+	oca_tile_map map;
+	std::vector<cv::Rect> inner, outer;
+	int ret = 0;
+
+	printf("[INC] %d frames, %dx%d tiles of %dpx, two %dpx objects moving %dpx/frame\n", frames,
+		   (image.cols + OCA_INC_TILE - 1) / OCA_INC_TILE, (image.rows + OCA_INC_TILE - 1) / OCA_INC_TILE,
+		   OCA_INC_TILE, INC_SPRITE_SIZE, INC_SPRITE_STEP);
+	printf("[INC] %-18s path  dirty%%  pixels%%  diff ms  incr ms   full ms  speedup  max diff\n", "op");
+	for (const inc_op &op: ops) {
+		for (int p = OCA_REPORT_CPU; p <= OCA_REPORT_OCA; p++) {
+			cv::Mat full, patched, part;
+			double full_ms = 0, inc_ms = 0, diff_ms = 0, max_diff = 0;
+			uint64_t dirty = 0, tiles = 0, pixels = 0, total = 0;
+
+			oca_op_activate(OCA_f, *op.desc, (p == OCA_REPORT_OCA) ? OPENCVA_FUNC_ENABLE : OPENCVA_FUNC_DISABLE);
+
+			for (int k = 0; k < frames; k++) {
+				make_frame(image, k, frame);
+				const cv::Mat *in = &frame;
+				if (op.gray) {
+					cv::cvtColor(frame, gray, cv::COLOR_BGR2GRAY);
+					in = &gray;
+				}
+
+				/* Full-frame recompute, also the reference */
+				uint64_t t0 = oca_stable_now_ns();
+				op.run(*in, full);
+				full_ms += elapsed_ms(t0);
+
+				if (k == 0) {
+					full.copyTo(patched);
+				} else {
+					/* Incremental: diff, then recompute the dirty runs from their halo-grown input */
+					t0 = oca_stable_now_ns();
+					oca_tile_diff(op.gray ? prev_gray : prev, *in, OCA_INC_SAD_THRESHOLD, map);
+					double d_ms = elapsed_ms(t0);
+					oca_tile_regions(map, in->size(), op.halo, inner, outer);
+					for (size_t i = 0; i < inner.size(); i++) {
+						op.run((*in)(outer[i]), part);
+						cv::Rect r(inner[i].x - outer[i].x, inner[i].y - outer[i].y, inner[i].width, inner[i].height);
+						part(r).copyTo(patched(inner[i]));
+						pixels += (uint64_t)outer[i].area();
+					}
+					inc_ms += elapsed_ms(t0);
+					diff_ms += d_ms;
+					dirty += (uint64_t)map.count;
+					tiles += map.dirty.size();
+					total += (uint64_t)in->total();
+					max_diff = std::max(max_diff, cv::norm(full, patched, cv::NORM_INF));
+				}
+				frame.copyTo(prev);
+				if (op.gray) {
+					gray.copyTo(prev_gray);
+				}
+			}
+			oca_s = patched.data[0];                   //for suppress optimization
+
+			/* Steady-state frames only: the first frame is a full compute on both sides */
+			int n = std::max(1, frames - 1);
+			double full_avg = full_ms / frames;
+			double inc_avg = inc_ms / n;
+			printf("[INC] %-18s %s %7.2f %8.2f %8.3f %8.3f %9.3f %8.2f %9.0f\n", op.desc->name, oca_report_path_name(p),
+				   tiles ? dirty * 100.0 / tiles : 0, total ? pixels * 100.0 / total : 0, diff_ms / n, inc_avg,
+				   full_avg, inc_avg > 0 ? full_avg / inc_avg : 0, max_diff);
+			if (max_diff > 0) {
+				std::cerr << "Error: " << op.desc->name << " " << oca_report_path_name(p)
+						  << " patched output differs from the full frame" << std::endl;
+				ret = -1;
+			}
+		}
+		oca_op_activate(OCA_f, *op.desc, OPENCVA_FUNC_DISABLE);
+	}
+	printf("[INC] pixels%% = input pixels recomputed incl. halo; incr ms includes the tile diff\n\n");
+	return ret;
+}
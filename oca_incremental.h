@@ -0,0 +1,46 @@
+/***********************************************************************************************************************
+* Copyright (C) 2024 Renesas Electronics Corporation. All rights reserved.
+***********************************************************************************************************************/
+/***********************************************************************************************************************
+* File Name    : oca_incremental.h
+* Version      : 1.00
+* Description  : Dirty-region incremental processing: recompute filter outputs only for tiles that changed
+***********************************************************************************************************************/
+
+#ifndef OCA_INCREMENTAL_H
+#define OCA_INCREMENTAL_H
+
+/*****************************************
+* Includes
+******************************************/
+#include <stdint.h>
+#include <vector>
+#include <opencv2/opencv.hpp>
+
+/*****************************************
+* Macros
+******************************************/
+#define OCA_INC_TILE            (64)            /* tile edge in pixels */
+#define OCA_INC_SAD_THRESHOLD   (0)             /* tile SAD above this is dirty; 0 = any change, required for an exact output */
+#define OCA_INC_FRAMES          (60)            /* synthetic sequence length */
+
+/*****************************************
+* Typedefs
+******************************************/
+/* Tile change map of one frame */
+struct oca_tile_map {
+	int cols;                           /* tiles per row */
+	int rows;                           /* tile rows */
+	std::vector<uint8_t> dirty;         /* rows * cols, 1 = changed */
+	int count;                          /* dirty tiles */
+};
+
+/*****************************************
+* Functions
+******************************************/
+void oca_tile_diff(const cv::Mat &prev, const cv::Mat &cur, uint32_t threshold, oca_tile_map &map);
+void oca_tile_regions(const oca_tile_map &map, cv::Size size, int halo, std::vector<cv::Rect> &inner,
+					  std::vector<cv::Rect> &outer);
+int oca_incremental_benchmark(const cv::Mat &image, unsigned long *OCA_f, int frames);
+
+#endif
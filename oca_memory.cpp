@@ -0,0 +1,266 @@
+/***********************************************************************************************************************
+* Copyright (C) 2024 Renesas Electronics Corporation. All rights reserved.
+***********************************************************************************************************************/
+/***********************************************************************************************************************
+* File Name    : oca_memory.cpp
+* Version      : 1.00
+* Description  : Memory accounting around timed calls: heap allocations (malloc hooks), peak RSS and DRP mappings
+***********************************************************************************************************************/
+
+/*****************************************
+* Includes
+******************************************/
+#include <malloc.h>
+#include "define.h"
+#include "oca_memory.h"
+#include <algorithm>
+#include <atomic>
+
+/*****************************************
+* Typedefs
+******************************************/
+/* One counter per cache line, so threads updating different counters do not share a line */
+template <typename T> struct alignas(64) mem_counter {
+	std::atomic<T> v{0};
+};
+
+/*****************************************
+* Global Variables
+******************************************/
+/* Constant-initialized, so usable by allocations made before main */
+static mem_counter<uint64_t> mem_allocs;
+static mem_counter<uint64_t> mem_alloc_bytes;
+static mem_counter<int64_t> mem_live;
+static mem_counter<int64_t> mem_peak;
+/* Off by default: a hooked call then costs one relaxed load */
+static std::atomic<bool> mem_counting{false};
+
+/*****************************************
+* Function Name : note_alloc
+* Description   : count an allocation and raise the peak of the live heap
+******************************************/
+static inline void note_alloc(void *p) {
+	if (!p || !mem_counting.load(std::memory_order_relaxed)) {
+		return;
+	}
+	int64_t n = (int64_t)malloc_usable_size(p);
+	mem_allocs.v.fetch_add(1, std::memory_order_relaxed);
+	mem_alloc_bytes.v.fetch_add((uint64_t)n, std::memory_order_relaxed);
+	int64_t live = mem_live.v.fetch_add(n, std::memory_order_relaxed) + n;
+	int64_t peak = mem_peak.v.load(std::memory_order_relaxed);
+	while (live > peak && !mem_peak.v.compare_exchange_weak(peak, live, std::memory_order_relaxed)) {
+	}
+}
+
+/*****************************************
+* Function Name : note_free
+* Description   : remove a block from the live heap. Blocks allocated while counting was off are
+*                 subtracted too, which shifts the live heap but not the per-region deltas.
+******************************************/
+static inline void note_free(void *p) {
+	if (p && mem_counting.load(std::memory_order_relaxed)) {
+		mem_live.v.fetch_sub((int64_t)malloc_usable_size(p), std::memory_order_relaxed);
+	}
+}
+
+#if defined(__GLIBC__)
+/*****************************************
+* malloc hooks
+* The executable's definitions interpose the C library allocator for every shared object, so
+* cv::fastMalloc and operator new (which call malloc) are counted too. glibc only: the real
+* allocator is reached through its __libc_* entry points. Counting is enabled by oca_memory_count.
+******************************************/
+extern "C" {
+void *__libc_malloc(size_t size);
+void *__libc_calloc(size_t n, size_t size);
+void *__libc_realloc(void *p, size_t size);
+void *__libc_memalign(size_t align, size_t size);
+void *__libc_valloc(size_t size);
+void *__libc_pvalloc(size_t size);
+void __libc_free(void *p);
+
+void *malloc(size_t size) {
+	void *p = __libc_malloc(size);
+	note_alloc(p);
+	return p;
+}
+
+void *calloc(size_t n, size_t size) {
+	void *p = __libc_calloc(n, size);
+	note_alloc(p);
+	return p;
+}
+
+void *realloc(void *p, size_t size) {
+	bool counting = mem_counting.load(std::memory_order_relaxed);
+	size_t old = (p && counting) ? malloc_usable_size(p) : 0;
+	void *q = __libc_realloc(p, size);
+	if (counting && (q || size == 0)) {
+		/* Moved, resized or freed: the old block leaves the live heap */
+		mem_live.v.fetch_sub((int64_t)old, std::memory_order_relaxed);
+	}
+	note_alloc(q);
+	return q;
+}
+
+void *reallocarray(void *p, size_t n, size_t size) {
+	size_t bytes;
+	if (__builtin_mul_overflow(n, size, &bytes)) {
+		errno = ENOMEM;
+		return nullptr;
+	}
+	return realloc(p, bytes);
+}
+
+void *memalign(size_t align, size_t size) {
+	void *p = __libc_memalign(align, size);
+	note_alloc(p);
+	return p;
+}
+
+void *aligned_alloc(size_t align, size_t size) {
+	return memalign(align, size);
+}
+
+void *valloc(size_t size) {
+	void *p = __libc_valloc(size);
+	note_alloc(p);
+	return p;
+}
+
+void *pvalloc(size_t size) {
+	void *p = __libc_pvalloc(size);
+	note_alloc(p);
+	return p;
+}
+
+int posix_memalign(void **out, size_t align, size_t size) {
+	if (align < sizeof(void *) || (align & (align - 1)) != 0) {
+		return EINVAL;
+	}
+	void *p = memalign(align, size);
+	if (!p) {
+		return ENOMEM;
+	}
+	*out = p;
+	return 0;
+}
+
+void free(void *p) {
+	note_free(p);
+	__libc_free(p);
+}
+}
+#endif
+
+/*****************************************
+* Function Name : oca_memory_hooked
+* Description   : true if the allocator is interposed (glibc)
+******************************************/
+bool oca_memory_hooked() {
+#if defined(__GLIBC__)
+	return true;
+#else
+	return false;
+#endif
+}
+
+/*****************************************
+* Function Name : oca_memory_count
+* Description   : switch heap counting on or off. Off, the hooks only forward to the C library.
+******************************************/
+void oca_memory_count(bool on) {
+	mem_counting.store(on && oca_memory_hooked(), std::memory_order_relaxed);
+}
+
+/*****************************************
+* Function Name : oca_memory_counting
+* Description   : true if heap allocations are counted
+******************************************/
+bool oca_memory_counting() {
+	return mem_counting.load(std::memory_order_relaxed);
+}
+
+/*****************************************
+* Function Name : read_status
+* Description   : VmRSS and VmHWM of the process in kB, -1 if unreadable
+******************************************/
+static void read_status(long &rss_kb, long &hwm_kb) {
+	char line[128];
+	FILE *f = fopen("/proc/self/status", "r");
+	rss_kb = -1;
+	hwm_kb = -1;
+	if (!f) {
+		return;
+	}
+	while (fgets(line, sizeof(line), f)) {
+		if (strncmp(line, "VmRSS:", 6) == 0) {
+			rss_kb = atol(line + 6);
+		} else if (strncmp(line, "VmHWM:", 6) == 0) {
+			hwm_kb = atol(line + 6);
+		}
+	}
+	fclose(f);
+}
+
+/*****************************************
+* Function Name : oca_memory_drp_kb
+* Description   : size of the OCA_DRP_DEVICE mappings of the process (DRP input / output / work buffers)
+* Return value  : kB, 0 if nothing is mapped, -1 if the maps are unreadable
+******************************************/
+long oca_memory_drp_kb() {
+	char line[512];
+	FILE *f = fopen("/proc/self/maps", "r");
+	long kb = 0;
+	if (!f) {
+		return -1;
+	}
+	while (fgets(line, sizeof(line), f)) {
+		unsigned long begin, end;
+		if (strstr(line, OCA_DRP_DEVICE) && sscanf(line, "%lx-%lx", &begin, &end) == 2) {
+			kb += (long)((end - begin) / 1024);
+		}
+	}
+	fclose(f);
+	return kb;
+}
+
+/*****************************************
+* Function Name : oca_memory_begin
+* Description   : start of a measured region. Resets the peak RSS (clear_refs 5, Linux 4.0+) and the
+*                 heap peak; the heap counters are read last so the /proc reads are not counted.
+* Arguments     : mark = output
+******************************************/
+void oca_memory_begin(oca_memory_mark &mark) {
+	int fd = open("/proc/self/clear_refs", O_WRONLY);
+	if (fd >= 0) {
+		/* If not reset, the delta is only seen where the old peak is exceeded */
+		ssize_t ret = write(fd, "5", 1);
+		(void)ret;
+		close(fd);
+	}
+	read_status(mark.rss_kb, mark.hwm_kb);
+	mark.live = mem_live.v.load(std::memory_order_relaxed);
+	mem_peak.v.store(mark.live, std::memory_order_relaxed);
+	mark.allocs = mem_allocs.v.load(std::memory_order_relaxed);
+	mark.alloc_bytes = mem_alloc_bytes.v.load(std::memory_order_relaxed);
+}
+
+/*****************************************
+* Function Name : oca_memory_end
+* Description   : end of a measured region
+* Arguments     : mark = state from oca_memory_begin
+*                 usage = output
+******************************************/
+void oca_memory_end(const oca_memory_mark &mark, oca_memory_usage &usage) {
+	long rss_kb, hwm_kb;
+	usage.allocs = (int64_t)(mem_allocs.v.load(std::memory_order_relaxed) - mark.allocs);
+	usage.alloc_bytes = (int64_t)(mem_alloc_bytes.v.load(std::memory_order_relaxed) - mark.alloc_bytes);
+	usage.heap_peak = mem_peak.v.load(std::memory_order_relaxed) - mark.live;
+	if (!oca_memory_counting()) {
+		usage.allocs = usage.alloc_bytes = usage.heap_peak = -1;
+	}
+	read_status(rss_kb, hwm_kb);
+	usage.rss_peak_kb = (hwm_kb < 0 || mark.rss_kb < 0) ? -1 : std::max(0L, hwm_kb - std::max(mark.rss_kb, mark.hwm_kb));
+	usage.drp_kb = oca_memory_drp_kb();
+}
@@ -0,0 +1,49 @@
+/***********************************************************************************************************************
+* Copyright (C) 2024 Renesas Electronics Corporation. All rights reserved.
+***********************************************************************************************************************/
+/***********************************************************************************************************************
+* File Name    : oca_memory.h
+* Version      : 1.00
+* Description  : Memory accounting around timed calls: heap allocations (malloc hooks), peak RSS and DRP mappings
+***********************************************************************************************************************/
+
+#ifndef OCA_MEMORY_H
+#define OCA_MEMORY_H
+
+/*****************************************
+* Includes
+******************************************/
+#include <stdint.h>
+
+/*****************************************
+* Typedefs
+******************************************/
+/* State at the start of a measured region */
+struct oca_memory_mark {
+	uint64_t allocs;
+	uint64_t alloc_bytes;
+	int64_t live;                       /* live heap bytes */
+	long rss_kb;                        /* VmRSS */
+	long hwm_kb;                        /* VmHWM, equal to rss_kb when the peak could be reset */
+};
+
+/* Usage of one measured region, -1 = not available */
+struct oca_memory_usage {
+	int64_t allocs;                     /* heap allocations, all threads */
+	int64_t alloc_bytes;                /* usable bytes of those allocations */
+	int64_t heap_peak;                  /* peak live heap above the start */
+	long rss_peak_kb;                   /* peak RSS above the start */
+	long drp_kb;                        /* DRP device memory mapped into the process at the end */
+};
+
+/*****************************************
+* Functions
+******************************************/
+bool oca_memory_hooked();
+void oca_memory_count(bool on);
+bool oca_memory_counting();
+void oca_memory_begin(oca_memory_mark &mark);
+void oca_memory_end(const oca_memory_mark &mark, oca_memory_usage &usage);
+long oca_memory_drp_kb();
+
+#endif
@@ -0,0 +1,116 @@
+/***********************************************************************************************************************
+* Copyright (C) 2024 Renesas Electronics Corporation. All rights reserved.
+***********************************************************************************************************************/
+/***********************************************************************************************************************
+* File Name    : oca_microbench.cpp
+* Version      : 1.00
+* Description  : Google Benchmark microbenchmarks of the 15 benchmark ops on the CPU and OCA paths across frame sizes
+***********************************************************************************************************************/
+
+/*****************************************
+* Includes
+******************************************/
+/*Definition of Macros & other variables*/
+#include "define.h"
+/*Simulated OCA backend hooks*/
+#include "oca_sim.h"
+/*Case descriptor table*/
+#include "oca_op_table.h"
+#include <filesystem>
+#include <functional>
+#include <benchmark/benchmark.h>
+/*OpenCV*/
+#include <opencv2/opencv.hpp>
+
+/*****************************************
+* Macros
+******************************************/
+#define MB_INPUT                "resources/image.png"   /* scaled to every size, random pixels if missing */
+
+/*****************************************
+* Global Variables
+******************************************/
+static cv::Mat mb_image;                /* FHD BGR source frame */
+static unsigned long mb_OCA_f[DRP_FUNC_NUM];
+
+/* Frame sizes: VGA, HD, FHD */
+static const int mb_sizes[][2] = {{640, 480}, {1280, 720}, {1920, 1080}};
+
+/*****************************************
+* Function Name : mb_run
+* Description   : benchmark body: one case on one path at state.range(0) x state.range(1), built by
+*                 oca_case_setup. dilate / erode / morphologyEx run one iteration, so a call is one pass
+*                 over the frame. Reports bytes/s over input + output and pixels/s over the input frame.
+******************************************/
+static void mb_run(benchmark::State &state, int c, int path) {
+	const oca_op_desc &op = oca_op_table[c];
+#if !OCA_SIM
+	if (path == OCA_REPORT_OCA && access(OCA_DRP_DEVICE, F_OK) != 0) {
+		state.SkipWithError(OCA_DRP_DEVICE " not available");
+		return;
+	}
+#endif
+	cv::Mat bgr;
+	oca_case_data data;
+	cv::resize(mb_image, bgr, cv::Size((int)state.range(0), (int)state.range(1)), 0, 0, cv::INTER_AREA);
+	std::function<void()> call = oca_case_setups[c](bgr, data, 1);
+
+	oca_op_activate(mb_OCA_f, op, path == OCA_REPORT_OCA ? OPENCVA_FUNC_ENABLE : OPENCVA_FUNC_DISABLE);
+	call();                                     /* untimed: output allocation and first-call effects */
+	for (auto _: state) {
+		OCA_SIM_BEGIN();
+		call();
+		for (int d: op.drp) {
+			if (path == OCA_REPORT_OCA && d >= 0) {
+				OCA_SIM_CHARGE(d, data.in, data.out, 1);
+			}
+		}
+		OCA_SIM_END();
+		benchmark::DoNotOptimize(data.dst.data);
+		benchmark::ClobberMemory();
+	}
+	oca_op_activate(mb_OCA_f, op, OPENCVA_FUNC_DISABLE);
+
+	state.SetBytesProcessed((int64_t)state.iterations() * (int64_t)(data.in + data.out));
+	state.counters["pixels"] = benchmark::Counter((double)state.iterations() * (double)bgr.total(),
+												  benchmark::Counter::kIsRate);
+}
+
+/*****************************************
+* Function Name : main
+* Description   : register <op>/<cpu|oca>/w:<width>/h:<height> for every op, path and size and run the
+*                 ones selected by the Google Benchmark flags, e.g. --benchmark_filter=GaussianBlur/oca
+******************************************/
+int main(int argc, char **argv) {
+	static const char *const path_name[OCA_REPORT_CPU_OCA_NUM] = {"cpu", "oca"};
+
+	benchmark::Initialize(&argc, argv);
+	if (benchmark::ReportUnrecognizedArguments(argc, argv)) {
+		return -1;
+	}
+
+	if (std::filesystem::exists(MB_INPUT)) {
+		mb_image = cv::imread(MB_INPUT, cv::IMREAD_COLOR);
+	}
+	if (mb_image.empty()) {
+		mb_image.create(1080, 1920, CV_8UC3);
+		cv::randu(mb_image, cv::Scalar::all(0), cv::Scalar::all(255));
+	}
+	for (unsigned long &i: mb_OCA_f) {
+		i = OPENCVA_FUNC_NOCHANGE;
+	}
+
+	for (int c = 0; c < OCA_CASE_NUM; c++) {
+		for (int p = OCA_REPORT_CPU; p <= OCA_REPORT_OCA; p++) {
+			std::string name = std::string(oca_op_table[c].name) + "/" + path_name[p];
+			benchmark::internal::Benchmark *b = benchmark::RegisterBenchmark(name.c_str(), mb_run, c, p);
+			for (const int *s: mb_sizes) {
+				b->Args({s[0], s[1]});
+			}
+			/* OpenCV runs its own worker threads: wall clock, not the main thread's CPU time */
+			b->ArgNames({"w", "h"})->UseRealTime()->Unit(benchmark::kMillisecond);
+		}
+	}
+	benchmark::RunSpecifiedBenchmarks();
+	return 0;
+}
@@ -0,0 +1,407 @@
+/***********************************************************************************************************************
+* Copyright (C) 2024 Renesas Electronics Corporation. All rights reserved.
+***********************************************************************************************************************/
+/***********************************************************************************************************************
+* File Name    : oca_op_table.h
+* Version      : 1.00
+* Description  : Compile-time descriptor table of the benchmark cases: DRP circuits, formats and byte costs,
+*                with the per-case OpenCV call, activation, simulator charging and report registration resolved
+*                at compile time
+***********************************************************************************************************************/
+
+#ifndef OCA_OP_TABLE_H
+#define OCA_OP_TABLE_H
+
+/*****************************************
+* Includes
+******************************************/
+#include <stddef.h>
+#include <array>
+#include <functional>
+#include <utility>
+#include "define.h"
+#include "oca_report.h"
+#include "oca_sim.h"
+#include "oca_trace.h"
+#include <opencv2/opencv.hpp>
+
+/*****************************************
+* Macros
+******************************************/
+/* Pixel formats */
+#define OCA_FMT_BGR             (0)             /* CV_8UC3 */
+#define OCA_FMT_YUYV            (1)             /* CV_8UC2, 4:2:2 packed */
+#define OCA_FMT_NV              (2)             /* Y plane + interleaved 4:2:0 chroma plane */
+#define OCA_FMT_GRAY            (3)             /* CV_8UC1 */
+#define OCA_FMT_F32             (4)             /* CV_32FC1 */
+#define OCA_FMT_NUM             (5)
+
+#define OCA_OP_MAX_DRP          (2)             /* circuits per case */
+
+/* Benchmark cases [1] .. [15], index into oca_op_table */
+#define OCA_CASE_RESIZE         (0)
+#define OCA_CASE_CVT_YUV2BGR    (1)
+#define OCA_CASE_CVT_NV2BGR     (2)
+#define OCA_CASE_GAUSSIAN       (3)
+#define OCA_CASE_DILATE         (4)
+#define OCA_CASE_ERODE          (5)
+#define OCA_CASE_MORPHOLOGY     (6)
+#define OCA_CASE_FILTER2D       (7)
+#define OCA_CASE_SOBEL          (8)
+#define OCA_CASE_A_THRESHOLD    (9)
+#define OCA_CASE_TMPLEATMATCH   (10)
+#define OCA_CASE_AFFINE         (11)
+#define OCA_CASE_PERSPECTIVE    (12)
+#define OCA_CASE_PYR_DOWN       (13)
+#define OCA_CASE_PYR_UP         (14)
+#define OCA_CASE_NUM            (15)
+
+/*****************************************
+* Typedefs
+******************************************/
+struct oca_op_desc {
+	const char *name;                   /* OpenCV function name */
+	int drp[OCA_OP_MAX_DRP];            /* circuits, -1 = unused */
+	int iterations;                     /* passes of each circuit over the data */
+	int in_fmt;
+	int in_w;
+	int in_h;
+	int out_fmt;
+	int out_w;
+	int out_h;
+};
+
+/* Inputs and output of one call, built outside the timed region */
+struct oca_case_data {
+	cv::Mat src;
+	cv::Mat aux;                        /* chroma plane / template / warp matrix, empty otherwise */
+	cv::Mat dst;
+	size_t in;                          /* bytes read per call */
+	size_t out;                         /* bytes written per call */
+};
+
+/* oca_case_setup<C> of a case chosen at run time */
+typedef std::function<void()> (*oca_case_setup_fn)(const cv::Mat &bgr, oca_case_data &d, int iterations);
+
+/*****************************************
+* Global Variables
+******************************************/
+/* Bits per pixel of each format */
+inline constexpr int oca_fmt_bits[OCA_FMT_NUM] = {24, 16, 12, 8, 32};
+
+/* The cases as run by oca_sample. cvtColor and cvtColorTwoPlane share circuit 2. */
+inline constexpr oca_op_desc oca_op_table[OCA_CASE_NUM] = {
+	{"resize",            {DRP_FUNC_RESIZE, -1},                 1, OCA_FMT_BGR,  1920, 1080, OCA_FMT_BGR,  1024, 768},
+	{"cvtColor",          {DRP_FUNC_CVT_YUV2BGR, -1},            1, OCA_FMT_YUYV, 1920, 1080, OCA_FMT_BGR,  1920, 1080},
+	{"cvtColorTwoPlane",  {DRP_FUNC_CVT_NV2BGR, -1},             1, OCA_FMT_NV,   1920, 1080, OCA_FMT_BGR,  1920, 1080},
+	{"GaussianBlur",      {DRP_FUNC_GAUSSIAN, -1},               1, OCA_FMT_BGR,  1920, 1080, OCA_FMT_BGR,  1920, 1080},
+	{"dilate",            {DRP_FUNC_DILATE, -1},               200, OCA_FMT_BGR,  1920, 1080, OCA_FMT_BGR,  1920, 1080},
+	{"erode",             {DRP_FUNC_ERODE, -1},                100, OCA_FMT_BGR,  1920, 1080, OCA_FMT_BGR,  1920, 1080},
+	{"morphologyEx",      {DRP_FUNC_ERODE, DRP_FUNC_DILATE},    50, OCA_FMT_BGR,  1920, 1080, OCA_FMT_BGR,  1920, 1080},
+	{"filter2D",          {DRP_FUNC_FILTER2D, -1},               1, OCA_FMT_BGR,  1920, 1080, OCA_FMT_BGR,  1920, 1080},
+	{"Sobel",             {DRP_FUNC_SOBEL, -1},                  1, OCA_FMT_BGR,  1920, 1080, OCA_FMT_BGR,  1920, 1080},
+	{"adaptiveThreshold", {DRP_FUNC_A_THRESHOLD, -1},            1, OCA_FMT_GRAY, 1920, 1080, OCA_FMT_GRAY, 1920, 1080},
+	{"matchTemplate",     {DRP_FUNC_TMPLEATMATCH, -1},           1, OCA_FMT_BGR,   640,  360, OCA_FMT_F32,   625, 345},
+	{"warpAffine",        {DRP_FUNC_AFFINE, -1},                 1, OCA_FMT_BGR,  1920, 1080, OCA_FMT_BGR,  1920, 1080},
+	{"warpPerspective",   {DRP_FUNC_PERSPECTIVE, -1},            1, OCA_FMT_BGR,  1920, 1080, OCA_FMT_BGR,  1920, 1080},
+	{"pyrDown",           {DRP_FUNC_PYR_DOWN, -1},               1, OCA_FMT_BGR,  1920, 1080, OCA_FMT_BGR,   960, 540},
+	{"pyrUp",             {DRP_FUNC_PYR_UP, -1},                 1, OCA_FMT_BGR,   960,  540, OCA_FMT_BGR,  1920, 1080},
+};
+
+/*****************************************
+* Functions
+******************************************/
+/* Bytes of a w x h frame */
+constexpr size_t oca_fmt_bytes(int fmt, int w, int h) {
+	return (size_t)w * (size_t)h * (size_t)oca_fmt_bits[fmt] / 8;
+}
+
+/* Largest output of all cases, for sizing the shared output buffer */
+constexpr size_t oca_case_max_out_bytes() {
+	size_t m = 0;
+	for (const oca_op_desc &d: oca_op_table) {
+		size_t b = oca_fmt_bytes(d.out_fmt, d.out_w, d.out_h);
+		m = b > m ? b : m;
+	}
+	return m;
+}
+
+/* Every case names a circuit first, only known circuits and formats */
+constexpr bool oca_op_table_valid() {
+	for (const oca_op_desc &d: oca_op_table) {
+		if (d.drp[0] < 0 || d.iterations < 1) {
+			return false;
+		}
+		for (int c: d.drp) {
+			if (c >= DRP_FUNC_NUM) {
+				return false;
+			}
+		}
+		if (d.in_fmt < 0 || d.in_fmt >= OCA_FMT_NUM || d.out_fmt < 0 || d.out_fmt >= OCA_FMT_NUM) {
+			return false;
+		}
+	}
+	return true;
+}
+static_assert(oca_op_table_valid(), "oca_op_table: bad circuit, iteration count or format");
+
+/* Case timing a circuit on its own: a single circuit, not already timed by an earlier case */
+constexpr bool oca_case_single_circuit(int c) {
+	if (oca_op_table[c].drp[1] >= 0) {
+		return false;
+	}
+	for (int k = 0; k < c; k++) {
+		if (oca_op_table[k].drp[0] == oca_op_table[c].drp[0]) {
+			return false;
+		}
+	}
+	return true;
+}
+
+/* Per-case constants */
+template <int C> inline constexpr oca_op_desc oca_case = oca_op_table[C];
+template <int C> inline constexpr size_t oca_case_in_bytes = oca_fmt_bytes(oca_case<C>.in_fmt, oca_case<C>.in_w,
+																			oca_case<C>.in_h);
+template <int C> inline constexpr size_t oca_case_out_bytes = oca_fmt_bytes(oca_case<C>.out_fmt, oca_case<C>.out_w,
+																			 oca_case<C>.out_h);
+template <int C> inline constexpr int oca_case_circuits = (oca_case<C>.drp[1] >= 0) ? 2 : 1;
+template <int C> inline constexpr int oca_case_passes = oca_case<C>.iterations * oca_case_circuits<C>;
+
+/*****************************************
+* Function Name : oca_filter2d_kernel
+* Description   : 3x3 sharpen kernel of case [8] filter2D
+******************************************/
+inline const cv::Mat &oca_filter2d_kernel() {
+	static float k[9] = {-0.2, -0.2, -0.2, -0.2, 2.6, -0.2, -0.2, -0.2, -0.2};
+	static const cv::Mat kernel(3, 3, CV_32FC1, k);
+	return kernel;
+}
+
+/*****************************************
+* Function Name : oca_case_matrix
+* Description   : warp matrix of case [12] warpAffine / [13] warpPerspective, for a frame of the given size.
+*                 The case matrices are for FHD; other sizes get the same warp in scaled coordinates.
+******************************************/
+template <int C> inline cv::Mat oca_case_matrix(cv::Size size) {
+	static_assert(C == OCA_CASE_AFFINE || C == OCA_CASE_PERSPECTIVE, "not a warp case");
+	float m[9] = {0.7071, -0.7071, 649, 0.7071, 0.7071, 510, 0, 0, 1};
+	if constexpr (C == OCA_CASE_PERSPECTIVE) {
+		const float p[9] = {0.5, 0.2, 20, -0.1, 0.8, 50, -0.001, 0.001, 1.0};
+		std::copy(p, p + 9, m);
+	}
+	/* S * M * S^-1 with S = diag(sx, sy, 1) */
+	const float sx = (float)size.width / oca_case<C>.in_w, sy = (float)size.height / oca_case<C>.in_h;
+	const float s[3] = {sx, sy, 1};
+	cv::Mat out(C == OCA_CASE_AFFINE ? 2 : 3, 3, CV_32FC1);
+	for (int r = 0; r < out.rows; r++) {
+		for (int c = 0; c < 3; c++) {
+			out.at<float>(r, c) = m[r * 3 + c] * s[r] / s[c];
+		}
+	}
+	return out;
+}
+
+/*****************************************
+* Function Name : oca_bgr_to_yuyv
+* Description   : YUYV frame from a BGR image, coefficients as in case [2] (odd last column dropped)
+******************************************/
+inline void oca_bgr_to_yuyv(const cv::Mat &bgr, cv::Mat &yuyv) {
+	yuyv.create(bgr.rows, bgr.cols & ~1, CV_8UC2);
+	for (int y = 0; y < yuyv.rows; y++) {
+		const cv::Vec3b *in = bgr.ptr<cv::Vec3b>(y);
+		unsigned char *out = yuyv.ptr<unsigned char>(y);
+		for (int x = 0; x < yuyv.cols; x += 2) {
+			float r0 = in[x][2], g0 = in[x][1], b0 = in[x][0];
+			float r1 = in[x + 1][2], g1 = in[x + 1][1], b1 = in[x + 1][0];
+			out[x * 2 + 0] = cv::saturate_cast<unsigned char>(r0 * 0.299f + g0 * 0.587f + b0 * 0.114f);
+			out[x * 2 + 1] = cv::saturate_cast<unsigned char>((r0 + r1) * (-0.169f) / 2.0f +
+				(g0 + g1) * (-0.331f) / 2.0f + (b0 + b1) * 0.500f / 2.0f + 128.0f);
+			out[x * 2 + 2] = cv::saturate_cast<unsigned char>(r1 * 0.299f + g1 * 0.587f + b1 * 0.114f);
+			out[x * 2 + 3] = cv::saturate_cast<unsigned char>((r0 + r1) * 0.500f / 2.0f +
+				(g0 + g1) * (-0.419f) / 2.0f + (b0 + b1) * (-0.081f) / 2.0f + 128.0f);
+		}
+	}
+}
+
+/*****************************************
+* Function Name : oca_case_run
+* Description   : the OpenCV call of case C with its parameters. Output sizes follow the input, so the
+*                 call also runs on frames other than the case size.
+* Arguments     : src = input in the case format
+*                 aux = chroma plane (cvtColorTwoPlane), template (matchTemplate), matrix (warps, see
+*                       oca_case_matrix), unused otherwise
+*                 dst = output
+*                 iterations = dilate / erode / morphologyEx iterations
+******************************************/
+template <int C> inline void oca_case_run(const cv::Mat &src, const cv::Mat &aux, cv::Mat &dst,
+										  int iterations = oca_case<C>.iterations) {
+	static_assert(C >= 0 && C < OCA_CASE_NUM, "unknown case");
+	(void)aux;
+	(void)iterations;
+	if constexpr (C == OCA_CASE_RESIZE) {
+		cv::Size size(src.cols * oca_case<C>.out_w / oca_case<C>.in_w, src.rows * oca_case<C>.out_h / oca_case<C>.in_h);
+		cv::resize(src, dst, size, 0, 0, cv::INTER_LINEAR);
+	} else if constexpr (C == OCA_CASE_CVT_YUV2BGR) {
+		cv::cvtColor(src, dst, cv::COLOR_YUV2BGR_YUYV);
+	} else if constexpr (C == OCA_CASE_CVT_NV2BGR) {
+		cv::cvtColorTwoPlane(src, aux, dst, cv::COLOR_YUV2RGB_NV21);
+	} else if constexpr (C == OCA_CASE_GAUSSIAN) {
+		cv::GaussianBlur(src, dst, {7, 7}, 0, 0);
+	} else if constexpr (C == OCA_CASE_DILATE) {
+		cv::dilate(src, dst, cv::Mat(), cv::Point(-1, -1), iterations);
+	} else if constexpr (C == OCA_CASE_ERODE) {
+		cv::erode(src, dst, cv::Mat(), cv::Point(-1, -1), iterations);
+	} else if constexpr (C == OCA_CASE_MORPHOLOGY) {
+		cv::morphologyEx(src, dst, cv::MORPH_OPEN, cv::Mat(), cv::Point(-1, -1), iterations);
+	} else if constexpr (C == OCA_CASE_FILTER2D) {
+		cv::filter2D(src, dst, -1, oca_filter2d_kernel());
+	} else if constexpr (C == OCA_CASE_SOBEL) {
+		cv::Sobel(src, dst, -1, 1, 0);
+	} else if constexpr (C == OCA_CASE_A_THRESHOLD) {
+		cv::adaptiveThreshold(src, dst, 0xFF, cv::ADAPTIVE_THRESH_MEAN_C, cv::THRESH_BINARY, 99, 0);
+	} else if constexpr (C == OCA_CASE_TMPLEATMATCH) {
+		cv::matchTemplate(src, aux, dst, cv::TM_SQDIFF);
+	} else if constexpr (C == OCA_CASE_AFFINE) {
+		cv::warpAffine(src, dst, aux, src.size());
+	} else if constexpr (C == OCA_CASE_PERSPECTIVE) {
+		cv::warpPerspective(src, dst, aux, src.size());
+	} else if constexpr (C == OCA_CASE_PYR_DOWN) {
+		cv::pyrDown(src, dst);
+	} else {
+		cv::pyrUp(src, dst);
+	}
+}
+
+/*****************************************
+* Function Name : oca_case_setup
+* Description   : build the inputs of case C from a BGR frame of any size, as the case builds them from its
+*                 FHD image, and return the call to time
+* Arguments     : bgr = BGR frame, scaled stand-in for the case's FHD input
+*                 d = inputs, output and bytes per call; must outlive the returned call
+*                 iterations = passed to oca_case_run
+* Return value  : the call
+******************************************/
+template <int C> inline std::function<void()> oca_case_setup(const cv::Mat &bgr, oca_case_data &d, int iterations) {
+	const int w = bgr.cols & ~1, h = bgr.rows & ~1;
+	d.aux = cv::Mat();
+	if constexpr (C == OCA_CASE_CVT_YUV2BGR) {
+		oca_bgr_to_yuyv(bgr, d.src);
+	} else if constexpr (C == OCA_CASE_CVT_NV2BGR) {
+		/* YV12 is the Y plane followed by the V and U planes; NV21 interleaves them as VU */
+		cv::Mat yv12;
+		cv::cvtColor(bgr(cv::Rect(0, 0, w, h)), yv12, cv::COLOR_BGR2YUV_YV12);
+		cv::Mat v(h / 2, w / 2, CV_8UC1, yv12.ptr<uint8_t>(h));
+		cv::Mat u(h / 2, w / 2, CV_8UC1, yv12.ptr<uint8_t>(h) + (size_t)w * h / 4);
+		d.src = yv12.rowRange(0, h).clone();
+		cv::merge(std::vector<cv::Mat>{v, u}, d.aux);
+	} else if constexpr (C == OCA_CASE_A_THRESHOLD) {
+		cv::cvtColor(bgr, d.src, cv::COLOR_BGR2GRAY);
+	} else if constexpr (C == OCA_CASE_TMPLEATMATCH) {
+		/* 640x360 region at (800, 400) of the FHD frame, 16x16 template at (1200, 560) */
+		const double sx = (double)bgr.cols / 1920, sy = (double)bgr.rows / 1080;
+		d.src = bgr(cv::Rect((int)(800 * sx), (int)(400 * sy), (int)(640 * sx), (int)(360 * sy))).clone();
+		d.aux = bgr(cv::Rect((int)(1200 * sx), (int)(560 * sy), 16, 16)).clone();
+	} else if constexpr (C == OCA_CASE_AFFINE || C == OCA_CASE_PERSPECTIVE) {
+		d.src = bgr;
+		d.aux = oca_case_matrix<C>(bgr.size());
+	} else if constexpr (C == OCA_CASE_PYR_UP) {
+		cv::pyrDown(bgr, d.src);
+	} else {
+		d.src = bgr;
+	}
+	d.in = oca_fmt_bytes(oca_case<C>.in_fmt, d.src.cols, d.src.rows);
+	d.out = oca_fmt_bytes(oca_case<C>.out_fmt, d.src.cols * oca_case<C>.out_w / oca_case<C>.in_w,
+						  d.src.rows * oca_case<C>.out_h / oca_case<C>.in_h);
+	return [&d, iterations] { oca_case_run<C>(d.src, d.aux, d.dst, iterations); };
+}
+
+/* oca_case_setup of every case, indexed by OCA_CASE_* */
+template <size_t... C>
+constexpr std::array<oca_case_setup_fn, OCA_CASE_NUM> oca_case_setup_list(std::index_sequence<C...>) {
+	return {&oca_case_setup<(int)C>...};
+}
+inline constexpr std::array<oca_case_setup_fn, OCA_CASE_NUM> oca_case_setups =
+	oca_case_setup_list(std::make_index_sequence<OCA_CASE_NUM>());
+
+/*****************************************
+* Function Name : oca_activate
+* Description   : apply the OCA_Activate function list, then return every entry to NOCHANGE so the next
+*                 activation only touches the circuits it sets
+******************************************/
+inline void oca_activate(unsigned long *OCA_f) {
+	OCA_TRACE_BEGIN("OCA_Activate", OCA_TRACE_CAT_ACTIVATE);
+	OCA_Activate(&OCA_f[0]);
+	OCA_TRACE_END("OCA_Activate", OCA_TRACE_CAT_ACTIVATE);
+	for (int i = 0; i < DRP_FUNC_NUM; i++) {
+		OCA_f[i] = OPENCVA_FUNC_NOCHANGE;
+	}
+}
+
+/*****************************************
+* Function Name : oca_op_set
+* Description   : set the activation state of the circuits of an op in the OCA_Activate function list
+******************************************/
+inline void oca_op_set(unsigned long *OCA_f, const oca_op_desc &op, unsigned long state) {
+	for (int c: op.drp) {
+		if (c >= 0) {
+			OCA_f[c] = state;
+		}
+	}
+}
+
+/*****************************************
+* Function Name : oca_op_activate
+* Description   : set the circuits of an op to state and apply the function list
+******************************************/
+inline void oca_op_activate(unsigned long *OCA_f, const oca_op_desc &op, unsigned long state) {
+	oca_op_set(OCA_f, op, state);
+	oca_activate(OCA_f);
+}
+
+/*****************************************
+* Function Name : oca_case_set
+* Description   : set the activation state of the circuits of case C in the OCA_Activate function list
+******************************************/
+template <int C> inline void oca_case_set(unsigned long *OCA_f, unsigned long state) {
+	static_assert(C >= 0 && C < OCA_CASE_NUM, "unknown case");
+	OCA_f[oca_case<C>.drp[0]] = state;
+	if constexpr (oca_case_circuits<C> > 1) {
+		OCA_f[oca_case<C>.drp[1]] = state;
+	}
+}
+
+/*****************************************
+* Function Name : oca_case_activate
+* Description   : set the circuits of case C to state and apply the function list
+******************************************/
+template <int C> inline void oca_case_activate(unsigned long *OCA_f, unsigned long state) {
+	oca_case_set<C>(OCA_f, state);
+	oca_activate(OCA_f);
+}
+
+/*****************************************
+* Function Name : oca_case_charge
+* Description   : charge the simulated latency of every circuit of case C (OCA_SIM builds)
+******************************************/
+template <int C> inline void oca_case_charge() {
+	OCA_SIM_CHARGE(oca_case<C>.drp[0], oca_case_in_bytes<C>, oca_case_out_bytes<C>, oca_case<C>.iterations);
+	if constexpr (oca_case_circuits<C> > 1) {
+		OCA_SIM_CHARGE(oca_case<C>.drp[1], oca_case_in_bytes<C>, oca_case_out_bytes<C>, oca_case<C>.iterations);
+	}
+}
+
+/*****************************************
+* Function Name : oca_case_report
+* Description   : register case C with the report
+******************************************/
+template <int C> inline void oca_case_report() {
+	if constexpr (oca_case_circuits<C> > 1) {
+		oca_report_add_case(oca_case<C>.name, {oca_case<C>.drp[0], oca_case<C>.drp[1]}, oca_case_in_bytes<C>,
+							oca_case_out_bytes<C>, oca_case_passes<C>);
+	} else {
+		oca_report_add_case(oca_case<C>.name, {oca_case<C>.drp[0]}, oca_case_in_bytes<C>, oca_case_out_bytes<C>,
+							oca_case_passes<C>);
+	}
+}
+
+#endif
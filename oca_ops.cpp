@@ -0,0 +1,48 @@
+/***********************************************************************************************************************
+* Copyright (C) 2024 Renesas Electronics Corporation. All rights reserved.
+***********************************************************************************************************************/
+/***********************************************************************************************************************
+* File Name    : oca_ops.cpp
+* Version      : 1.00
+* Description  : One call per DRP circuit with the benchmark case parameters, for the profiling modes
+***********************************************************************************************************************/
+
+/*****************************************
+* Includes
+******************************************/
+#include "define.h"
+#include "oca_ops.h"
+
+/*****************************************
+* Function Name : oca_ops
+* Description   : one call per circuit, the case calls of oca_op_table.h (dilate / erode one iteration)
+******************************************/
+const std::vector<oca_op> &oca_ops() {
+	static const std::vector<oca_op> ops = [] {
+		std::vector<oca_op> v;
+		for (int c = 0; c < OCA_CASE_NUM; c++) {
+			if (oca_case_single_circuit(c)) {
+				oca_case_setup_fn setup = oca_case_setups[c];
+				v.push_back({&oca_op_table[c], [setup](const cv::Mat &bgr, oca_case_data &d) {
+					return setup(bgr, d, 1);
+				}});
+			}
+		}
+		return v;
+	}();
+	return ops;
+}
+
+/*****************************************
+* Function Name : oca_op_find
+* Description   : op by OpenCV function name
+* Return value  : nullptr if unknown
+******************************************/
+const oca_op *oca_op_find(const char *name) {
+	for (const oca_op &op: oca_ops()) {
+		if (strcmp(op.desc->name, name) == 0) {
+			return &op;
+		}
+	}
+	return nullptr;
+}
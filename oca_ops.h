@@ -0,0 +1,38 @@
+/***********************************************************************************************************************
+* Copyright (C) 2024 Renesas Electronics Corporation. All rights reserved.
+***********************************************************************************************************************/
+/***********************************************************************************************************************
+* File Name    : oca_ops.h
+* Version      : 1.00
+* Description  : One call per DRP circuit with the benchmark case parameters, for the profiling modes
+***********************************************************************************************************************/
+
+#ifndef OCA_OPS_H
+#define OCA_OPS_H
+
+/*****************************************
+* Includes
+******************************************/
+#include <functional>
+#include <vector>
+#include <opencv2/opencv.hpp>
+#include "oca_op_table.h"
+
+/*****************************************
+* Typedefs
+******************************************/
+/* setup(bgr, data) builds the inputs from a BGR frame and returns the call to time, see oca_case_setup */
+typedef std::function<std::function<void()>(const cv::Mat &, oca_case_data &)> oca_op_setup;
+
+struct oca_op {
+	const oca_op_desc *desc;            /* case: name and circuit */
+	oca_op_setup setup;
+};
+
+/*****************************************
+* Functions
+******************************************/
+const std::vector<oca_op> &oca_ops();
+const oca_op *oca_op_find(const char *name);
+
+#endif
@@ -0,0 +1,192 @@
+/***********************************************************************************************************************
+* Copyright (C) 2024 Renesas Electronics Corporation. All rights reserved.
+***********************************************************************************************************************/
+/***********************************************************************************************************************
+* File Name    : oca_paced.cpp
+* Version      : 1.00
+* Description  : Deadline-paced real-time mode: ops released on an absolute frame schedule, jitter / deadline misses
+***********************************************************************************************************************/
+
+/*****************************************
+* Includes
+******************************************/
+#include "define.h"
+#include "oca_paced.h"
+#include "oca_histogram.h"
+#include "oca_ops.h"
+#include "oca_report.h"
+#include "oca_sim.h"
+#include <algorithm>
+#include <iostream>
+#include <sstream>
+
+/*****************************************
+* Global Variables
+******************************************/
+/* Large (about 60KB each), kept out of the stack */
+static oca_histogram paced_jitter[OCA_REPORT_CPU_OCA_NUM];
+static oca_histogram paced_latency[OCA_REPORT_CPU_OCA_NUM];
+
+/*****************************************
+* Function Name : mono_ns
+* Description   : CLOCK_MONOTONIC in ns, the clock clock_nanosleep sleeps on
+******************************************/
+static uint64_t mono_ns() {
+	struct timespec ts;
+	clock_gettime(CLOCK_MONOTONIC, &ts);
+	return (uint64_t)ts.tv_sec * 1000000000ull + (uint64_t)ts.tv_nsec;
+}
+
+/*****************************************
+* Function Name : sleep_until
+* Description   : absolute sleep; returns at once when the time has passed
+******************************************/
+static void sleep_until(uint64_t ns) {
+	struct timespec ts;
+	ts.tv_sec = (time_t)(ns / 1000000000ull);
+	ts.tv_nsec = (long)(ns % 1000000000ull);
+	while (clock_nanosleep(CLOCK_MONOTONIC, TIMER_ABSTIME, &ts, nullptr) == EINTR) {
+	}
+}
+
+/*****************************************
+* Function Name : write_histograms
+* Description   : every non-empty bucket of both paths with its cumulative percentile
+* Return value  : 0 on success, -1 on error
+******************************************/
+static int write_histograms(const std::filesystem::path &file_name) {
+	std::ofstream file(file_name);
+	if (!file.is_open()) {
+		return -1;
+	}
+	file << "path,metric,upper_us,count,percentile\n";
+	for (int p = OCA_REPORT_CPU; p <= OCA_REPORT_OCA; p++) {
+		const oca_histogram *hist[2] = {&paced_jitter[p], &paced_latency[p]};
+		const char *metric[2] = {"jitter", "latency"};
+		for (int m = 0; m < 2; m++) {
+			uint64_t total = hist[m]->total.load(std::memory_order_relaxed);
+			uint64_t seen = 0;
+			for (int i = 0; i < OCA_HIST_BUCKETS && total > 0; i++) {
+				uint64_t n = hist[m]->count[i].load(std::memory_order_relaxed);
+				if (n == 0) {
+					continue;
+				}
+				seen += n;
+				file << oca_report_path_name(p) << "," << metric[m] << "," << std::fixed << std::setprecision(3)
+					 << (double)oca_hist_upper(i) / 1E3 << "," << n << "," << std::setprecision(4)
+					 << (double)seen * 100.0 / (double)total << "\n";
+			}
+		}
+	}
+	return file.good() ? 0 : -1;
+}
+
+/*****************************************
+* Function Name : oca_paced_benchmark
+* Description   : release the ops once per frame period on an absolute CLOCK_MONOTONIC schedule (frame k at
+*                 start + k * period, deadline at the next release), first with the circuits disabled, then
+*                 enabled. A frame that is late starts as soon as the previous one completes; frames are
+*                 never dropped, so lateness accumulates as backlog.
+* Arguments     : image = FHD BGR frame
+*                 OCA_f = OCA_Activate function list
+*                 fps = release rate
+*                 ops = comma-separated op names run in order per frame (oca_ops.h)
+*                 frames = frames per path
+*                 dir = results directory
+* Return value  : 0 on success, -1 on error
+******************************************/
+int oca_paced_benchmark(const cv::Mat &image, unsigned long *OCA_f, double fps, const char *ops, int frames,
+						const std::filesystem::path &dir) {
+	std::vector<const oca_op *> list;
+	std::stringstream names(ops);
+	std::string name;
+	while (std::getline(names, name, ',')) {
+		const oca_op *op = oca_op_find(name.c_str());
+		if (!op) {
+			std::cerr << "Error: unknown op " << name << ", one of:";
+			for (const oca_op &o: oca_ops()) {
+				std::cerr << " " << o.desc->name;
+			}
+			std::cerr << std::endl;
+			return -1;
+		}
+		list.push_back(op);
+	}
+	if (list.empty() || fps <= 0 || frames <= 0) {
+		std::cerr << "Error: --paced needs a rate > 0, ops and frames > 0" << std::endl;
+		return -1;
+	}
+
+	/* Inputs are built once; sized before setup, the runners keep references into them */
+	std::vector<oca_case_data> data(list.size());
+	std::vector<std::function<void()>> run(list.size());
+	for (size_t i = 0; i < list.size(); i++) {
+		run[i] = list[i]->setup(image, data[i]);
+	}
+	const uint64_t period = (uint64_t)(1E9 / fps);
+
+	printf("[PACED] %.2ffps (period %.3fmsec, deadline = next release), %d frames, ops %s\n", fps, period / 1E6,
+		   frames, ops);
+	for (int p = OCA_REPORT_CPU; p <= OCA_REPORT_OCA; p++) {
+		uint64_t misses = 0, late = 0, max_backlog = 0;
+		for (const oca_op *op: list) {
+			oca_op_set(OCA_f, *op->desc, (p == OCA_REPORT_OCA) ? OPENCVA_FUNC_ENABLE : OPENCVA_FUNC_DISABLE);
+		}
+		oca_activate(OCA_f);
+		for (std::function<void()> &r: run) {
+			r();                                /* first call is not a real-time frame */
+		}
+		oca_hist_reset(paced_jitter[p]);
+		oca_hist_reset(paced_latency[p]);
+
+		uint64_t start = mono_ns();
+		for (int k = 0; k < frames; k++) {
+			uint64_t release = start + (uint64_t)(k + 1) * period;
+			sleep_until(release);
+			uint64_t wake = mono_ns();
+			uint64_t delay = wake > release ? wake - release : 0;
+			uint64_t backlog = delay / period;
+			OCA_SIM_BEGIN();
+			for (size_t i = 0; i < run.size(); i++) {
+				run[i]();
+				if (p == OCA_REPORT_OCA) {
+					OCA_SIM_CHARGE(list[i]->desc->drp[0], data[i].in, data[i].out, 1);
+				}
+			}
+			OCA_SIM_END();
+			uint64_t done = mono_ns();
+			oca_s = data[0].dst.data ? data[0].dst.data[0] : 0;  //for suppress optimization
+
+			oca_hist_record(paced_jitter[p], delay);
+			oca_hist_record(paced_latency[p], done - release);
+			misses += (done - release > period);
+			late += (backlog > 0);
+			max_backlog = std::max(max_backlog, backlog);
+		}
+
+		const oca_histogram &j = paced_jitter[p];
+		const oca_histogram &l = paced_latency[p];
+		printf("[PACED] %s deadline misses %llu/%d (%.2f%%), late starts %llu, max backlog %llu frames\n",
+			   oca_report_path_name(p), (unsigned long long)misses, frames, misses * 100.0 / frames,
+			   (unsigned long long)late, (unsigned long long)max_backlog);
+		printf("[PACED] %s release jitter usec  p50 %9.1f  p99 %9.1f  p99.9 %9.1f  max %9.1f\n",
+			   oca_report_path_name(p),
+			   oca_hist_percentile(j, 50) / 1E3, oca_hist_percentile(j, 99) / 1E3, oca_hist_percentile(j, 99.9) / 1E3,
+			   j.max.load() / 1E3);
+		printf("[PACED] %s latency msec  mean %8.3f  p50 %8.3f  p90 %8.3f  p99 %8.3f  p99.9 %8.3f  max %8.3f\n",
+			   oca_report_path_name(p), oca_hist_mean(l) / 1E6, oca_hist_percentile(l, 50) / 1E6,
+			   oca_hist_percentile(l, 90) / 1E6, oca_hist_percentile(l, 99) / 1E6, oca_hist_percentile(l, 99.9) / 1E6,
+			   l.max.load() / 1E6);
+	}
+	for (const oca_op *op: list) {
+		oca_op_set(OCA_f, *op->desc, OPENCVA_FUNC_DISABLE);
+	}
+	oca_activate(OCA_f);
+
+	if (write_histograms(dir / OCA_PACED_CSV) < 0) {
+		std::cerr << "Error: Cannot write " << dir / OCA_PACED_CSV << std::endl;
+		return -1;
+	}
+	printf("[PACED] histograms: %s\n\n", (dir / OCA_PACED_CSV).c_str());
+	return 0;
+}
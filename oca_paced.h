@@ -0,0 +1,33 @@
+/***********************************************************************************************************************
+* Copyright (C) 2024 Renesas Electronics Corporation. All rights reserved.
+***********************************************************************************************************************/
+/***********************************************************************************************************************
+* File Name    : oca_paced.h
+* Version      : 1.00
+* Description  : Deadline-paced real-time mode: ops released on an absolute frame schedule, jitter / deadline misses
+***********************************************************************************************************************/
+
+#ifndef OCA_PACED_H
+#define OCA_PACED_H
+
+/*****************************************
+* Includes
+******************************************/
+#include <filesystem>
+#include <opencv2/opencv.hpp>
+
+/*****************************************
+* Macros
+******************************************/
+#define OCA_PACED_FPS           (30.0)
+#define OCA_PACED_OPS           "GaussianBlur"
+#define OCA_PACED_FRAMES        (300)
+#define OCA_PACED_CSV           "oca_paced.csv"     /* histograms, written to the results directory */
+
+/*****************************************
+* Functions
+******************************************/
+int oca_paced_benchmark(const cv::Mat &image, unsigned long *OCA_f, double fps, const char *ops, int frames,
+						const std::filesystem::path &dir);
+
+#endif
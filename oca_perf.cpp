@@ -0,0 +1,235 @@
+/***********************************************************************************************************************
+* Copyright (C) 2024 Renesas Electronics Corporation. All rights reserved.
+***********************************************************************************************************************/
+/***********************************************************************************************************************
+* File Name    : oca_perf.cpp
+* Version      : 1.00
+* Description  : Hardware / software performance counters around timed regions (perf_event_open counter groups)
+***********************************************************************************************************************/
+
+/*****************************************
+* Includes
+******************************************/
+#include "define.h"
+#include "oca_perf.h"
+#include <dirent.h>
+#include <linux/perf_event.h>
+#include <sys/syscall.h>
+
+/*****************************************
+* Macros
+******************************************/
+/* Hardware and software events are separate groups: a group is scheduled as a whole on the PMU */
+#define PERF_GROUP_HW           (0)
+#define PERF_GROUP_SW           (1)
+#define PERF_GROUP_NUM          (2)
+
+/*****************************************
+* Typedefs
+******************************************/
+/* One counter group opened on one thread */
+struct perf_group {
+	int leader;
+	int fd[OCA_PERF_NUM];               /* member fds, fd[0] = leader */
+	int counter[OCA_PERF_NUM];          /* counter id of each member, in read order */
+	int members;
+};
+
+/*****************************************
+* Global Variables
+******************************************/
+static std::vector<perf_group> perf_groups;
+static bool perf_valid[OCA_PERF_NUM];
+
+/*****************************************
+* Function Name : perf_attr
+* Description   : perf_event_attr of a counter
+******************************************/
+static struct perf_event_attr perf_attr(int counter) {
+	struct perf_event_attr attr = {};
+	attr.size = sizeof(attr);
+	attr.read_format = PERF_FORMAT_GROUP | PERF_FORMAT_TOTAL_TIME_ENABLED | PERF_FORMAT_TOTAL_TIME_RUNNING;
+	attr.disabled = 1;
+	attr.exclude_hv = 1;
+	switch (counter) {
+		case OCA_PERF_CYCLES:
+			attr.type = PERF_TYPE_HARDWARE;
+			attr.config = PERF_COUNT_HW_CPU_CYCLES;
+			break;
+		case OCA_PERF_INSTRUCTIONS:
+			attr.type = PERF_TYPE_HARDWARE;
+			attr.config = PERF_COUNT_HW_INSTRUCTIONS;
+			break;
+		case OCA_PERF_L1D_MISSES:
+			attr.type = PERF_TYPE_HW_CACHE;
+			attr.config = PERF_COUNT_HW_CACHE_L1D | (PERF_COUNT_HW_CACHE_OP_READ << 8) |
+						  (PERF_COUNT_HW_CACHE_RESULT_MISS << 16);
+			break;
+		case OCA_PERF_LLC_MISSES:
+			attr.type = PERF_TYPE_HW_CACHE;
+			attr.config = PERF_COUNT_HW_CACHE_LL | (PERF_COUNT_HW_CACHE_OP_READ << 8) |
+						  (PERF_COUNT_HW_CACHE_RESULT_MISS << 16);
+			break;
+		case OCA_PERF_BRANCH_MISSES:
+			attr.type = PERF_TYPE_HARDWARE;
+			attr.config = PERF_COUNT_HW_BRANCH_MISSES;
+			break;
+		case OCA_PERF_CTX_SWITCHES:
+			attr.type = PERF_TYPE_SOFTWARE;
+			attr.config = PERF_COUNT_SW_CONTEXT_SWITCHES;
+			break;
+		default:
+			attr.type = PERF_TYPE_SOFTWARE;
+			attr.config = PERF_COUNT_SW_PAGE_FAULTS;
+			break;
+	}
+	return attr;
+}
+
+/*****************************************
+* Function Name : perf_open_counter
+* Description   : open one counter on a thread. Falls back to user-space only counting when
+*                 perf_event_paranoid forbids kernel counting.
+* Return value  : fd, or negative errno
+******************************************/
+static int perf_open_counter(int counter, pid_t tid, int group_fd) {
+	struct perf_event_attr attr = perf_attr(counter);
+	attr.disabled = group_fd < 0 ? 1 : 0;
+	int fd = (int)syscall(SYS_perf_event_open, &attr, tid, -1, group_fd, PERF_FLAG_FD_CLOEXEC);
+	if (fd < 0 && (errno == EACCES || errno == EPERM)) {
+		attr.exclude_kernel = 1;
+		fd = (int)syscall(SYS_perf_event_open, &attr, tid, -1, group_fd, PERF_FLAG_FD_CLOEXEC);
+	}
+	return fd < 0 ? -errno : fd;
+}
+
+/*****************************************
+* Function Name : oca_perf_open
+* Description   : open the counter groups on every thread of the process. Call after the
+*                 OpenCV worker threads exist (after the first parallel call) so their work is counted.
+* Return value  : 0 if at least one counter is available, negative errno otherwise
+******************************************/
+int oca_perf_open() {
+	static const int group_of[OCA_PERF_NUM] = {PERF_GROUP_HW, PERF_GROUP_HW, PERF_GROUP_HW, PERF_GROUP_HW,
+											   PERF_GROUP_HW, PERF_GROUP_SW, PERF_GROUP_SW};
+	bool probed[OCA_PERF_NUM] = {};
+	int last_err = -ENOENT;
+	DIR *dir = opendir("/proc/self/task");
+	struct dirent *ent;
+
+	oca_perf_close();
+	if (!dir) {
+		return -errno;
+	}
+	while ((ent = readdir(dir)) != nullptr) {
+		pid_t tid = (pid_t)atoi(ent->d_name);
+		if (tid <= 0) {
+			continue;
+		}
+		for (int g = 0; g < PERF_GROUP_NUM; g++) {
+			perf_group group = {-1, {}, {}, 0};
+			for (int c = 0; c < OCA_PERF_NUM; c++) {
+				/* Counters that failed on the first thread are not retried on the others */
+				if (group_of[c] != g || (probed[c] && !perf_valid[c])) {
+					continue;
+				}
+				int fd = perf_open_counter(c, tid, group.leader);
+				probed[c] = true;
+				if (fd < 0) {
+					last_err = fd;
+					continue;
+				}
+				perf_valid[c] = true;
+				if (group.leader < 0) {
+					group.leader = fd;
+				}
+				group.fd[group.members] = fd;
+				group.counter[group.members++] = c;
+			}
+			if (group.leader >= 0) {
+				perf_groups.push_back(group);
+			}
+		}
+	}
+	closedir(dir);
+	return perf_groups.empty() ? last_err : 0;
+}
+
+/*****************************************
+* Function Name : oca_perf_close
+* Description   : close all counters
+******************************************/
+void oca_perf_close() {
+	for (const perf_group &group: perf_groups) {
+		for (int i = 0; i < group.members; i++) {
+			close(group.fd[i]);
+		}
+	}
+	perf_groups.clear();
+	for (bool &v: perf_valid) {
+		v = false;
+	}
+}
+
+/*****************************************
+* Function Name : oca_perf_active
+* Description   : true if counters are open
+******************************************/
+bool oca_perf_active() {
+	return !perf_groups.empty();
+}
+
+/*****************************************
+* Function Name : oca_perf_valid
+* Description   : true if a counter could be opened
+******************************************/
+bool oca_perf_valid(int counter) {
+	return counter >= 0 && counter < OCA_PERF_NUM && perf_valid[counter];
+}
+
+/*****************************************
+* Function Name : oca_perf_start
+* Description   : reset and enable all groups
+******************************************/
+void oca_perf_start() {
+	for (const perf_group &group: perf_groups) {
+		ioctl(group.leader, PERF_EVENT_IOC_RESET, PERF_IOC_FLAG_GROUP);
+		ioctl(group.leader, PERF_EVENT_IOC_ENABLE, PERF_IOC_FLAG_GROUP);
+	}
+}
+
+/*****************************************
+* Function Name : oca_perf_stop
+* Description   : disable all groups and sum them over the threads. Values are scaled
+*                 when the PMU multiplexed a group.
+******************************************/
+void oca_perf_stop(oca_perf_sample &sample) {
+	for (const perf_group &group: perf_groups) {
+		ioctl(group.leader, PERF_EVENT_IOC_DISABLE, PERF_IOC_FLAG_GROUP);
+	}
+	sample = oca_perf_sample();
+	for (int c = 0; c < OCA_PERF_NUM; c++) {
+		sample.valid[c] = perf_valid[c];
+	}
+	for (const perf_group &group: perf_groups) {
+		uint64_t buf[3 + OCA_PERF_NUM];
+		ssize_t n = read(group.leader, buf, sizeof(buf));
+		if (n < (ssize_t)(3 * sizeof(uint64_t)) || buf[0] != (uint64_t)group.members) {
+			continue;
+		}
+		double scale = (buf[2] > 0 && buf[2] < buf[1]) ? (double)buf[1] / (double)buf[2] : 1.0;
+		for (int i = 0; i < group.members; i++) {
+			sample.value[group.counter[i]] += (uint64_t)((double)buf[3 + i] * scale);
+		}
+	}
+}
+
+/*****************************************
+* Function Name : oca_perf_name
+* Description   : report key of a counter
+******************************************/
+const char *oca_perf_name(int counter) {
+	static const char *const name[OCA_PERF_NUM] = {"cycles", "instructions", "l1d_misses", "llc_misses",
+												   "branch_misses", "context_switches", "page_faults"};
+	return (counter >= 0 && counter < OCA_PERF_NUM) ? name[counter] : "unknown";
+}
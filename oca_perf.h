@@ -0,0 +1,51 @@
+/***********************************************************************************************************************
+* Copyright (C) 2024 Renesas Electronics Corporation. All rights reserved.
+***********************************************************************************************************************/
+/***********************************************************************************************************************
+* File Name    : oca_perf.h
+* Version      : 1.00
+* Description  : Hardware / software performance counters around timed regions (perf_event_open counter groups)
+***********************************************************************************************************************/
+
+#ifndef OCA_PERF_H
+#define OCA_PERF_H
+
+/*****************************************
+* Includes
+******************************************/
+#include <stdint.h>
+
+/*****************************************
+* Macros
+******************************************/
+/* Counters */
+#define OCA_PERF_CYCLES         (0)
+#define OCA_PERF_INSTRUCTIONS   (1)
+#define OCA_PERF_L1D_MISSES     (2)
+#define OCA_PERF_LLC_MISSES     (3)
+#define OCA_PERF_BRANCH_MISSES  (4)
+#define OCA_PERF_CTX_SWITCHES   (5)
+#define OCA_PERF_PAGE_FAULTS    (6)
+#define OCA_PERF_NUM            (7)
+
+/*****************************************
+* Typedefs
+******************************************/
+/* Counter values of one region, summed over all threads of the process */
+struct oca_perf_sample {
+	uint64_t value[OCA_PERF_NUM];
+	bool valid[OCA_PERF_NUM];           /* false = counter not available on this system */
+};
+
+/*****************************************
+* Functions
+******************************************/
+int oca_perf_open();
+void oca_perf_close();
+bool oca_perf_active();
+bool oca_perf_valid(int counter);
+void oca_perf_start();
+void oca_perf_stop(oca_perf_sample &sample);
+const char *oca_perf_name(int counter);
+
+#endif
@@ -0,0 +1,151 @@
+/***********************************************************************************************************************
+* Copyright (C) 2024 Renesas Electronics Corporation. All rights reserved.
+***********************************************************************************************************************/
+/***********************************************************************************************************************
+* File Name    : oca_planar.cpp
+* Version      : 1.00
+* Description  : Planar (one CV_8UC1 plane per channel) execution path for the CPU filters
+***********************************************************************************************************************/
+
+/*****************************************
+* Includes
+******************************************/
+#include "define.h"
+#include "oca_planar.h"
+#include "oca_op_table.h"
+#include "oca_stable.h"
+#include <algorithm>
+#include <functional>
+
+/*****************************************
+* Typedefs
+******************************************/
+/* Pipeline stage: a per-channel filter, so the planar result equals the interleaved one */
+struct planar_stage {
+	const oca_op_desc *desc;            /* case: name and circuit */
+	std::function<void(const cv::Mat &, cv::Mat &)> run;
+};
+
+/*****************************************
+* Function Name : oca_planar_split
+* Description   : deinterleave a CV_8UC3 frame into OCA_PLANAR_PLANES contiguous CV_8UC1 planes
+******************************************/
+void oca_planar_split(const cv::Mat &bgr, cv::Mat *planes) {
+	cv::split(bgr, planes);
+}
+
+/*****************************************
+* Function Name : oca_planar_merge
+* Description   : interleave OCA_PLANAR_PLANES planes back into a CV_8UC3 frame
+******************************************/
+void oca_planar_merge(const cv::Mat *planes, cv::Mat &bgr) {
+	cv::merge(planes, OCA_PLANAR_PLANES, bgr);
+}
+
+/*****************************************
+* Function Name : run_planes
+* Description   : apply a stage to every plane, one plane per task. OpenCV runs nested parallel regions
+*                 serially, so each plane is filtered single-threaded on its own core.
+******************************************/
+static void run_planes(const planar_stage &stage, const cv::Mat *src, cv::Mat *dst) {
+	cv::parallel_for_(cv::Range(0, OCA_PLANAR_PLANES), [&](const cv::Range &range) {
+		for (int c = range.start; c < range.end; c++) {
+			stage.run(src[c], dst[c]);
+		}
+	}, OCA_PLANAR_PLANES);
+}
+
+/*****************************************
+* Function Name : median_ms
+* Description   : median latency of samples calls after one untimed call, msec
+******************************************/
+static double median_ms(const std::function<void()> &run, int samples) {
+	std::vector<double> t(samples);
+	run();                                      /* untimed: output allocation and first-call effects */
+	for (double &v: t) {
+		uint64_t t0 = oca_stable_now_ns();
+		run();
+		v = (double)(oca_stable_now_ns() - t0) / 1E6;
+	}
+	std::sort(t.begin(), t.end());
+	return t[t.size() / 2];
+}
+
+/*****************************************
+* Function Name : oca_planar_benchmark
+* Description   : time GaussianBlur, dilate, filter2D and Sobel on the CPU per stage and chained as one
+*                 pipeline, on the interleaved frame and on planes. The planar pipeline is timed with the
+*                 split and merge, and without the merge for consumers that accept planes.
+* Arguments     : image = FHD BGR frame
+*                 OCA_f = OCA_Activate function list, the stage circuits are disabled while timing
+*                 iterations = timed runs per measurement (at least OCA_PLANAR_MIN_SAMPLES)
+* Return value  : 0 on success
+******************************************/
+int oca_planar_benchmark(const cv::Mat &image, unsigned long *OCA_f, int iterations) {
+	const planar_stage stages[] = {
+		{&oca_op_table[OCA_CASE_GAUSSIAN],
+			[](const cv::Mat &s, cv::Mat &d) { cv::GaussianBlur(s, d, {7, 7}, 0, 0); }},
+		{&oca_op_table[OCA_CASE_DILATE],
+			[](const cv::Mat &s, cv::Mat &d) { cv::dilate(s, d, cv::Mat()); }},
+		{&oca_op_table[OCA_CASE_FILTER2D],
+			[](const cv::Mat &s, cv::Mat &d) { cv::filter2D(s, d, -1, oca_filter2d_kernel()); }},
+		{&oca_op_table[OCA_CASE_SOBEL],
+			[](const cv::Mat &s, cv::Mat &d) { cv::Sobel(s, d, -1, 1, 0); }},
+	};
+	const int n = (int)(sizeof(stages) / sizeof(stages[0]));
+	const int samples = std::max(iterations, OCA_PLANAR_MIN_SAMPLES);
+	cv::Mat a, b, out;
+	cv::Mat pa[OCA_PLANAR_PLANES], pb[OCA_PLANAR_PLANES], pc[OCA_PLANAR_PLANES];
+
+	for (const planar_stage &s: stages) {
+		oca_op_set(OCA_f, *s.desc, OPENCVA_FUNC_DISABLE);
+	}
+	oca_activate(OCA_f);
+
+	printf("[PLANAR] CPU, %d threads, %d samples, median msec\n", cv::getNumThreads(), samples);
+	printf("[PLANAR] %-14s %12s %12s %8s\n", "stage", "interleaved", "planar", "speedup");
+	oca_planar_split(image, pa);
+	for (const planar_stage &s: stages) {
+		double t_int = median_ms([&] { s.run(image, b); }, samples);
+		double t_pl = median_ms([&] { run_planes(s, pa, pb); }, samples);
+		printf("[PLANAR] %-14s %12.3f %12.3f %8.2f\n", s.desc->name, t_int, t_pl, t_pl > 0 ? t_int / t_pl : 0);
+	}
+
+	/* Chained pipeline, ping-pong buffers */
+	double t_int = median_ms([&] {
+		const cv::Mat *src = &image;
+		for (int i = 0; i < n; i++) {
+			cv::Mat &dst = (i & 1) ? b : a;
+			stages[i].run(*src, dst);
+			src = &dst;
+		}
+		oca_s = src->data[0];                   //for suppress optimization
+	}, samples);
+	double t_split = median_ms([&] { oca_planar_split(image, pa); }, samples);
+	double t_chain = median_ms([&] {
+		const cv::Mat *src = pa;
+		for (int i = 0; i < n; i++) {
+			cv::Mat *dst = (i & 1) ? pc : pb;
+			run_planes(stages[i], src, dst);
+			src = dst;
+		}
+		oca_s = src[0].data[0];                 //for suppress optimization
+	}, samples);
+	const cv::Mat *last = (n & 1) ? pb : pc;
+	double t_merge = median_ms([&] { oca_planar_merge(last, out); }, samples);
+
+	/* Same per-channel filters: the merged planar output must equal the interleaved one */
+	const cv::Mat &ref = (n & 1) ? a : b;
+	double max_diff = cv::norm(ref, out, cv::NORM_INF);
+
+	double t_pl = t_split + t_chain + t_merge;
+	double t_pl_keep = t_split + t_chain;
+	printf("[PLANAR] pipeline %d stages:\n", n);
+	printf("[PLANAR]   interleaved            %9.3f msec %7.1f fps\n", t_int, 1E3 / t_int);
+	printf("[PLANAR]   planar split+merge     %9.3f msec %7.1f fps  (split %.3f, stages %.3f, merge %.3f)\n",
+		   t_pl, 1E3 / t_pl, t_split, t_chain, t_merge);
+	printf("[PLANAR]   planar, planar output  %9.3f msec %7.1f fps\n", t_pl_keep, 1E3 / t_pl_keep);
+	printf("[PLANAR]   speedup %.2f (split+merge), %.2f (planar output); max diff %.0f\n\n",
+		   t_int / t_pl, t_int / t_pl_keep, max_diff);
+	return 0;
+}
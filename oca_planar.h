@@ -0,0 +1,31 @@
+/***********************************************************************************************************************
+* Copyright (C) 2024 Renesas Electronics Corporation. All rights reserved.
+***********************************************************************************************************************/
+/***********************************************************************************************************************
+* File Name    : oca_planar.h
+* Version      : 1.00
+* Description  : Planar (one CV_8UC1 plane per channel) execution path for the CPU filters
+***********************************************************************************************************************/
+
+#ifndef OCA_PLANAR_H
+#define OCA_PLANAR_H
+
+/*****************************************
+* Includes
+******************************************/
+#include <opencv2/opencv.hpp>
+
+/*****************************************
+* Macros
+******************************************/
+#define OCA_PLANAR_PLANES       (3)
+#define OCA_PLANAR_MIN_SAMPLES  (3)             /* timed runs per measurement, median reported */
+
+/*****************************************
+* Functions
+******************************************/
+void oca_planar_split(const cv::Mat &bgr, cv::Mat *planes);
+void oca_planar_merge(const cv::Mat *planes, cv::Mat &bgr);
+int oca_planar_benchmark(const cv::Mat &image, unsigned long *OCA_f, int iterations);
+
+#endif
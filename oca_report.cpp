@@ -0,0 +1,846 @@
+/***********************************************************************************************************************
+* Copyright (C) 2024 Renesas Electronics Corporation. All rights reserved.
+***********************************************************************************************************************/
+/***********************************************************************************************************************
+* File Name    : oca_report.cpp
+* Version      : 1.00
+* Description  : Per-case timing collection and machine-readable results (JSON / CSV) with environment metadata
+***********************************************************************************************************************/
+
+/*****************************************
+* Includes
+******************************************/
+#include "define.h"
+#include "oca_report.h"
+#include "oca_sim.h"
+#include "oca_trace.h"
+#include <algorithm>
+#include <iostream>
+#include <sstream>
+#include <sys/utsname.h>
+#include <opencv2/opencv.hpp>
+
+/*****************************************
+* Global Variables
+******************************************/
+static std::vector<oca_report_case> report_cases;
+static uint64_t report_start_ns;
+static double report_start_j;                  /* energy at the start of the sample */
+static oca_stable_state report_state;          /* cpufreq / thermal state at the start of the sample */
+static oca_memory_mark report_mem;              /* heap / RSS state at the start of the sample */
+static int report_iterations = 1;
+static oca_roofline report_roofline;            /* bandwidth reference, valid only after a probe */
+static const char *report_trace_name = "";     /* op of the current case, a string literal */
+static cv::Mat report_reference;                /* CPU output of the current case */
+static std::filesystem::path report_heatmap_dir;   /* empty = no heatmaps */
+
+/*****************************************
+* Function Name : close_case
+* Description   : record the state at the end of the current case and report disturbed samples
+******************************************/
+static void close_case() {
+	if (report_cases.empty()) {
+		return;
+	}
+	oca_report_case &c = report_cases.back();
+	report_reference.release();
+	oca_stable_snapshot(c.sys_after);
+	for (int p = 0; p < OCA_REPORT_PATH_NUM; p++) {
+		if (c.rejected[p] || c.unstable[p]) {
+			printf("[STABLE] %s %s: %zu samples re-run, %zu kept with frequency change or throttling"
+				   " (%ld -> %ld kHz, %.1f -> %.1f C)\n", c.op.c_str(), oca_report_path_name(p), c.rejected[p],
+				   c.unstable[p], c.sys_before.cur_khz, c.sys_after.cur_khz, c.sys_before.temp_mc / 1E3,
+				   c.sys_after.temp_mc / 1E3);
+		}
+	}
+}
+
+/*****************************************
+* Function Name : oca_report_add_case
+* Description   : start a new case; following samples are recorded into it
+* Arguments     : op = OpenCV function name (string literal, also used as the trace event name)
+*                 drp = circuits used by the OCA path
+*                 in_bytes, out_bytes = image data read / written by one pass
+*                 passes = passes over the image per call
+******************************************/
+void oca_report_add_case(const char *op, std::initializer_list<int> drp, size_t in_bytes, size_t out_bytes,
+						 int passes) {
+	oca_report_case c{};
+	close_case();
+	report_trace_name = op;
+	c.index = (int)report_cases.size() + 1;
+	c.op = op;
+	c.drp = drp;
+	c.in_bytes = in_bytes;
+	c.out_bytes = out_bytes;
+	c.passes = passes;
+	oca_stable_snapshot(c.sys_before);
+	report_cases.push_back(c);
+}
+
+/*****************************************
+* Function Name : oca_report_next
+* Description   : loop condition of a timed path: true until iterations samples are kept
+* Arguments     : path = OCA_REPORT_CPU / OCA_REPORT_OCA / OCA_REPORT_FIX
+*                 iterations = samples to keep
+******************************************/
+bool oca_report_next(int path, int iterations) {
+	report_iterations = iterations;
+	return !report_cases.empty() && report_cases.back().msec[path].size() < (size_t)iterations;
+}
+
+/*****************************************
+* Function Name : oca_report_start
+* Description   : start of one timed call
+* Arguments     : path = OCA_REPORT_CPU / OCA_REPORT_OCA / OCA_REPORT_FIX
+******************************************/
+void oca_report_start(int path) {
+	(void)path;
+	OCA_TRACE_BEGIN(report_trace_name, oca_report_path_name(path));
+	oca_stable_snapshot(report_state);
+	oca_memory_begin(report_mem);
+	if (oca_perf_active()) {
+		oca_perf_start();
+	}
+	report_start_j = oca_energy_now();
+	report_start_ns = oca_stable_now_ns();
+	OCA_SIM_BEGIN();
+}
+
+/*****************************************
+* Function Name : oca_report_stop
+* Description   : end of one timed call, the sample is added to the current case
+* Arguments     : path = OCA_REPORT_CPU / OCA_REPORT_OCA / OCA_REPORT_FIX
+******************************************/
+void oca_report_stop(int path) {
+	oca_perf_sample sample;
+	oca_stable_state state;
+	oca_memory_usage mem;
+	OCA_SIM_END();
+	uint64_t end_ns = oca_stable_now_ns();
+	double end_j = oca_energy_now();
+	if (oca_perf_active()) {
+		oca_perf_stop(sample);
+	}
+	oca_memory_end(report_mem, mem);
+	OCA_TRACE_END(report_trace_name, oca_report_path_name(path));
+	if (report_cases.empty()) {
+		return;
+	}
+	oca_report_case &c = report_cases.back();
+
+	/* Re-run samples disturbed by DVFS or throttling while the retry budget lasts */
+	oca_stable_snapshot(state);
+	if (oca_stable_changed(report_state, state)) {
+		if (c.rejected[path] < OCA_REPORT_RETRIES * (size_t)report_iterations) {
+			c.rejected[path]++;
+			return;
+		}
+		c.unstable[path]++;
+	}
+	if (c.msec[path].empty()) {
+		c.mem[path] = mem;
+	} else {
+		oca_memory_usage &m = c.mem[path];
+		m.allocs += mem.allocs;
+		m.alloc_bytes += mem.alloc_bytes;
+		m.heap_peak = std::max(m.heap_peak, mem.heap_peak);
+		m.rss_peak_kb = std::max(m.rss_peak_kb, mem.rss_peak_kb);
+		m.drp_kb = std::max(m.drp_kb, mem.drp_kb);
+	}
+	c.msec[path].push_back((double)(end_ns - report_start_ns) / 1E6);
+	if (oca_perf_active()) {
+		for (int k = 0; k < OCA_PERF_NUM; k++) {
+			c.perf[path].value[k] += sample.value[k];
+			c.perf[path].valid[k] = sample.valid[k];
+		}
+		c.perf_n[path]++;
+	}
+	if (oca_energy_active()) {
+		c.energy_j[path] += end_j - report_start_j;
+		c.energy_n[path]++;
+	}
+}
+
+/*****************************************
+* Function Name : oca_report_set_heatmap_dir
+* Description   : directory for the difference heatmap of the first failed check per case and path
+******************************************/
+void oca_report_set_heatmap_dir(const std::filesystem::path &dir) {
+	report_heatmap_dir = dir;
+}
+
+/*****************************************
+* Function Name : oca_report_reference
+* Description   : keep the CPU output of the current case for oca_report_accuracy (one buffer, reused)
+******************************************/
+void oca_report_reference(const cv::Mat &ref) {
+	ref.copyTo(report_reference);
+}
+
+/*****************************************
+* Function Name : accuracy_add
+* Description   : count one accuracy check of a case and keep the worst values
+******************************************/
+static void accuracy_add(oca_report_case &c, int path, const oca_accuracy &a) {
+	oca_accuracy &w = c.acc[path];
+	if (c.acc_n[path] == 0) {
+		w = a;
+	} else {
+		w.max_abs = std::max(w.max_abs, a.max_abs);
+		w.max_rel = std::max(w.max_rel, a.max_rel);
+		w.mismatched = std::max(w.mismatched, a.mismatched);
+		w.psnr = std::min(w.psnr, a.psnr);
+		w.argmin_match = w.argmin_match && a.argmin_match;
+		w.pass = w.pass && a.pass;
+	}
+	c.acc_n[path]++;
+	c.acc_failed[path] += !a.pass;
+}
+
+/*****************************************
+* Function Name : oca_report_accuracy
+* Description   : compare an output of the current case against the CPU reference in memory, outside the
+*                 timed region. Call after every timed call to validate all iterations.
+* Arguments     : path = OCA_REPORT_OCA / OCA_REPORT_FIX
+*                 out = output of the path
+******************************************/
+void oca_report_accuracy(int path, const cv::Mat &out) {
+	oca_accuracy a;
+	if (report_cases.empty() || report_reference.empty()) {
+		return;
+	}
+	oca_report_case &c = report_cases.back();
+	const oca_tolerance &tol = oca_accuracy_tolerance(c.op.c_str());
+	bool mismatch = oca_accuracy_compare(report_reference, out, tol, a, nullptr) < 0;
+	if (mismatch) {
+		a.pass = false;
+		a.max_abs = a.max_rel = INFINITY;
+		a.psnr = 0;
+	}
+	/* A size or type mismatch has no heatmap; the second compare must not overwrite a */
+	if (!a.pass && !mismatch && c.acc_failed[path] == 0 && !report_heatmap_dir.empty()) {
+		cv::Mat heatmap;
+		oca_accuracy scratch;
+		if (oca_accuracy_compare(report_reference, out, tol, scratch, &heatmap) == 0) {
+			std::filesystem::path file = report_heatmap_dir /
+				("OCA" + std::to_string(c.index) + "_" + oca_report_path_name(path) + "_diff.png");
+			cv::imwrite(file, heatmap);
+		}
+	}
+
+	accuracy_add(c, path, a);
+}
+
+/*****************************************
+* Function Name : oca_report_exact
+* Description   : bit-exactness check of the current case, counted with its accuracy checks: every element
+*                 of out must equal ref
+* Arguments     : path = OCA_REPORT_OCA / OCA_REPORT_FIX
+*                 ref = reference for out, computed by the caller
+*                 out = output of the path
+* Return value  : largest element difference, INFINITY on a size or type mismatch
+******************************************/
+double oca_report_exact(int path, const cv::Mat &ref, const cv::Mat &out) {
+	static const oca_tolerance exact = {"", 0, 0, 0, 0, false};
+	oca_accuracy a;
+	if (oca_accuracy_compare(ref, out, exact, a, nullptr) < 0) {
+		a.pass = false;
+		a.max_abs = a.max_rel = INFINITY;
+		a.psnr = 0;
+	}
+	if (!report_cases.empty()) {
+		accuracy_add(report_cases.back(), path, a);
+	}
+	return a.max_abs;
+}
+
+/*****************************************
+* Function Name : oca_report_median
+* Description   : median of the current case on one path
+* Return value  : msec, 0 when there are no samples
+******************************************/
+double oca_report_median(int path) {
+	return report_cases.empty() ? 0 : oca_report_summary(report_cases.back().msec[path]).median;
+}
+
+/*****************************************
+* Function Name : oca_report_summary
+* Description   : summary statistics of a sample set
+******************************************/
+oca_report_stats oca_report_summary(std::vector<double> samples) {
+	oca_report_stats s = {};
+	s.n = samples.size();
+	if (s.n == 0) {
+		return s;
+	}
+	std::sort(samples.begin(), samples.end());
+	s.min = samples.front();
+	s.max = samples.back();
+	s.median = (s.n & 1) ? samples[s.n / 2] : (samples[s.n / 2 - 1] + samples[s.n / 2]) / 2;
+	s.p90 = samples[std::min(s.n - 1, (size_t)ceil(0.9 * (double)s.n) - 1)];
+	for (double v: samples) {
+		s.mean += v;
+	}
+	s.mean /= (double)s.n;
+	for (double v: samples) {
+		s.stddev += (v - s.mean) * (v - s.mean);
+	}
+	s.stddev = s.n > 1 ? sqrt(s.stddev / (double)(s.n - 1)) : 0;
+	return s;
+}
+
+/*****************************************
+* Function Name : oca_report_path_name
+* Description   : key used for a path in the reports
+******************************************/
+const char *oca_report_path_name(int path) {
+	static const char *const name[OCA_REPORT_PATH_NUM] = {"cpu", "oca", "fix"};
+	return (path >= 0 && path < OCA_REPORT_PATH_NUM) ? name[path] : "unknown";
+}
+
+/*****************************************
+* Function Name : read_line
+* Description   : first line of a text file (sysfs / procfs), empty if unreadable
+******************************************/
+static std::string read_line(const char *path) {
+	std::ifstream file(path);
+	std::string line;
+	std::getline(file, line);
+	/* device-tree strings are NUL terminated */
+	line.erase(std::find(line.begin(), line.end(), '\0'), line.end());
+	return line;
+}
+
+/*****************************************
+* Function Name : os_release
+* Description   : PRETTY_NAME from /etc/os-release (BSP / image version)
+******************************************/
+static std::string os_release() {
+	std::ifstream file("/etc/os-release");
+	std::string line;
+	while (std::getline(file, line)) {
+		if (line.rfind("PRETTY_NAME=", 0) == 0) {
+			line = line.substr(12);
+			line.erase(std::remove(line.begin(), line.end(), '"'), line.end());
+			return line;
+		}
+	}
+	return "";
+}
+
+/*****************************************
+* Function Name : json_string
+* Description   : quote and escape a string for JSON
+******************************************/
+static std::string json_string(const std::string &s) {
+	std::string out = "\"";
+	for (char c: s) {
+		switch (c) {
+			case '"': out += "\\\""; break;
+			case '\\': out += "\\\\"; break;
+			case '\n': out += "\\n"; break;
+			case '\t': out += "\\t"; break;
+			case '\r': break;
+			default:
+				if ((unsigned char)c < 0x20) {
+					char buf[8];
+					snprintf(buf, sizeof(buf), "\\u%04x", c);
+					out += buf;
+				} else {
+					out += c;
+				}
+				break;
+		}
+	}
+	return out + "\"";
+}
+
+/*****************************************
+* Function Name : number
+* Description   : fixed-point text of a value, shared by both writers. Non-finite values print as 0, so
+*                 values that can be infinite are written as null (JSON) / inf (CSV) by the caller.
+******************************************/
+static std::string number(double v) {
+	char buf[32];
+	snprintf(buf, sizeof(buf), "%.6f", std::isfinite(v) ? v : 0.0);
+	return buf;
+}
+
+/*****************************************
+* Function Name : perf_per_call
+* Description   : mean counter value per timed call, negative if not collected
+******************************************/
+static double perf_per_call(const oca_report_case &c, int path, int counter) {
+	if (c.perf_n[path] == 0 || !c.perf[path].valid[counter]) {
+		return -1;
+	}
+	return (double)c.perf[path].value[counter] / (double)c.perf_n[path];
+}
+
+/*****************************************
+* Function Name : mem_per_call
+* Description   : mean allocations and allocated bytes per timed call, negative if not counted
+******************************************/
+static void mem_per_call(const oca_report_case &c, int path, double &allocs, double &bytes) {
+	const oca_memory_usage &m = c.mem[path];
+	double n = (double)c.msec[path].size();
+	allocs = (m.allocs < 0 || n == 0) ? -1 : (double)m.allocs / n;
+	bytes = (m.alloc_bytes < 0 || n == 0) ? -1 : (double)m.alloc_bytes / n;
+}
+
+/*****************************************
+* Function Name : mismatch_pct
+* Description   : largest mismatched fraction of one check, percent
+******************************************/
+static double mismatch_pct(const oca_report_case &c, int path) {
+	return c.acc[path].total ? (double)c.acc[path].mismatched * 100.0 / (double)c.acc[path].total : 0;
+}
+
+/*****************************************
+* Function Name : perf_derived
+* Description   : IPC and image bytes moved per cycle over all passes (as gbps), negative if not collected
+******************************************/
+static void perf_derived(const oca_report_case &c, int path, double &ipc, double &bytes_per_cycle) {
+	double cycles = perf_per_call(c, path, OCA_PERF_CYCLES);
+	double instructions = perf_per_call(c, path, OCA_PERF_INSTRUCTIONS);
+	ipc = (cycles > 0 && instructions >= 0) ? instructions / cycles : -1;
+	bytes_per_cycle = cycles > 0 ? (double)c.passes * (double)(c.in_bytes + c.out_bytes) / cycles : -1;
+}
+
+/*****************************************
+* Function Name : energy_per_frame
+* Description   : mean energy per timed call (mJ), mean power (W) and calls per joule, negative if not measured
+******************************************/
+static void energy_per_frame(const oca_report_case &c, int path, double &mj, double &watts, double &frames_per_j) {
+	double sec = 0;
+	for (double v: c.msec[path]) {
+		sec += v / 1E3;
+	}
+	mj = watts = frames_per_j = -1;
+	if (c.energy_n[path] == 0 || c.energy_n[path] != c.msec[path].size()) {
+		return;
+	}
+	mj = c.energy_j[path] * 1E3 / (double)c.energy_n[path];
+	watts = sec > 0 ? c.energy_j[path] / sec : -1;
+	frames_per_j = mj > 0 ? 1E3 / mj : -1;
+}
+
+/*****************************************
+* Function Name : gbps
+* Description   : achieved image bandwidth of one call, GB/s
+******************************************/
+static double gbps(const oca_report_case &c, double msec) {
+	return msec > 0 ? (double)c.passes * (double)(c.in_bytes + c.out_bytes) / (msec * 1E6) : 0;
+}
+
+/*****************************************
+* Function Name : pct_peak
+* Description   : achieved bandwidth in percent of the probed peak, negative without a probe
+******************************************/
+static double pct_peak(const oca_report_case &c, double msec) {
+	return (report_roofline.valid && report_roofline.peak > 0) ? gbps(c, msec) / report_roofline.peak * 100 : -1;
+}
+
+/*****************************************
+* Function Name : json_state
+* Description   : cpufreq / thermal snapshot as a JSON object
+******************************************/
+static std::string json_state(const oca_stable_state &st) {
+	char buf[192];
+	snprintf(buf, sizeof(buf), "{\"cur_khz\": %ld, \"max_khz\": %ld, \"transitions\": %ld, \"cooling\": %ld, "
+			 "\"temp_mc\": %ld}", st.cur_khz, st.max_khz, st.transitions, st.cooling, st.temp_mc);
+	return buf;
+}
+
+/*****************************************
+* Function Name : oca_report_environment
+* Description   : key / value pairs describing the board and software stack
+******************************************/
+static std::vector<std::pair<std::string, std::string>> oca_report_environment() {
+	std::vector<std::pair<std::string, std::string>> env;
+	struct utsname u;
+	char host[256] = "";
+	char date[32] = "";
+	time_t now = time(nullptr);
+	strftime(date, sizeof(date), "%Y-%m-%dT%H:%M:%SZ", gmtime(&now));
+	gethostname(host, sizeof(host) - 1);
+
+	env.push_back({"date", date});
+	env.push_back({"hostname", host});
+	env.push_back({"model", read_line("/proc/device-tree/model")});
+	env.push_back({"os", os_release()});
+	if (uname(&u) == 0) {
+		env.push_back({"kernel", std::string(u.sysname) + " " + u.release + " " + u.version});
+		env.push_back({"machine", u.machine});
+	}
+	env.push_back({"cores_online", std::to_string(sysconf(_SC_NPROCESSORS_ONLN))});
+	env.push_back({"cpufreq_governor", read_line("/sys/devices/system/cpu/cpu0/cpufreq/scaling_governor")});
+	env.push_back({"cpufreq_cur_khz", read_line("/sys/devices/system/cpu/cpu0/cpufreq/scaling_cur_freq")});
+	env.push_back({"cpufreq_max_khz", read_line("/sys/devices/system/cpu/cpu0/cpufreq/scaling_max_freq")});
+	env.push_back({"clock", "CLOCK_MONOTONIC_RAW"});
+	env.push_back({"pinned_cpu", std::to_string(oca_stable_cpu())});
+	env.push_back({"sched", oca_stable_sched()});
+	env.push_back({"opencv_version", CV_VERSION});
+	env.push_back({"opencv_threads", std::to_string(cv::getNumThreads())});
+	std::string counters;
+	for (int k = 0; k < OCA_PERF_NUM; k++) {
+		if (oca_perf_valid(k)) {
+			counters += (counters.empty() ? "" : " ") + std::string(oca_perf_name(k));
+		}
+	}
+	env.push_back({"perf_counters", counters});
+	env.push_back({"heap_hooks", oca_memory_counting() ? "malloc" : oca_memory_hooked() ? "off" : "none"});
+	env.push_back({"energy_source", oca_energy_source_name()});
+#if OCA_SIM
+	env.push_back({"oca", "simulated"});
+#else
+	env.push_back({"oca", access(OCA_DRP_DEVICE, R_OK | W_OK) == 0 ? "available" : "unavailable"});
+#endif
+	return env;
+}
+
+/*****************************************
+* Function Name : write_json
+* Description   : full report: environment, OpenCV build information, samples and statistics
+******************************************/
+static int write_json(const std::filesystem::path &file_name, int iterations,
+					  const std::vector<std::pair<std::string, std::string>> &env) {
+	std::ofstream file(file_name);
+	if (!file.is_open()) {
+		return -1;
+	}
+	file << "{\n";
+	file << "  \"schema\": " << OCA_REPORT_SCHEMA << ",\n";
+	file << "  \"iterations\": " << iterations << ",\n";
+	if (report_roofline.valid) {
+		file << "  \"roofline\": {\"threads\": " << report_roofline.threads << ", \"peak_gbps\": "
+			 << number(report_roofline.peak);
+		for (int k = 0; k < OCA_ROOFLINE_KERNEL_NUM; k++) {
+			file << ", " << json_string(std::string(oca_roofline_kernel_name(k)) + "_1t_gbps") << ": "
+				 << number(report_roofline.single[k]) << ", "
+				 << json_string(std::string(oca_roofline_kernel_name(k)) + "_mt_gbps") << ": "
+				 << number(report_roofline.multi[k]);
+		}
+		file << "},\n";
+	}
+	file << "  \"environment\": {\n";
+	for (const auto &kv: env) {
+		file << "    " << json_string(kv.first) << ": " << json_string(kv.second) << ",\n";
+	}
+	file << "    \"opencv_build\": " << json_string(cv::getBuildInformation()) << "\n";
+	file << "  },\n";
+	file << "  \"cases\": [";
+	for (size_t i = 0; i < report_cases.size(); i++) {
+		const oca_report_case &c = report_cases[i];
+		double cpu = oca_report_summary(c.msec[OCA_REPORT_CPU]).median;
+		file << (i ? "," : "") << "\n    {\n";
+		file << "      \"index\": " << c.index << ",\n";
+		file << "      \"op\": " << json_string(c.op) << ",\n";
+		file << "      \"drp\": [";
+		for (size_t k = 0; k < c.drp.size(); k++) {
+			file << (k ? ", " : "") << c.drp[k];
+		}
+		file << "],\n";
+		file << "      \"in_bytes\": " << c.in_bytes << ",\n";
+		file << "      \"out_bytes\": " << c.out_bytes << ",\n";
+		file << "      \"passes\": " << c.passes << ",\n";
+		file << "      \"system\": {\"before\": " << json_state(c.sys_before) << ", \"after\": "
+			 << json_state(c.sys_after) << "},\n";
+		file << "      \"paths\": {";
+		bool first = true;
+		for (int p = 0; p < OCA_REPORT_PATH_NUM; p++) {
+			if (c.msec[p].empty()) {
+				continue;
+			}
+			oca_report_stats s = oca_report_summary(c.msec[p]);
+			file << (first ? "" : ",") << "\n        " << json_string(oca_report_path_name(p)) << ": {\n";
+			file << "          \"n\": " << s.n << ", \"min_ms\": " << number(s.min) << ", \"median_ms\": "
+				 << number(s.median) << ", \"mean_ms\": " << number(s.mean) << ", \"stddev_ms\": " << number(s.stddev)
+				 << ", \"p90_ms\": " << number(s.p90) << ", \"max_ms\": " << number(s.max) << ",\n";
+			file << "          \"speedup\": " << number(s.median > 0 ? cpu / s.median : 0) << ", \"rejected\": "
+				 << c.rejected[p] << ", \"unstable\": " << c.unstable[p] << ",\n";
+			double pct = pct_peak(c, s.median);
+			file << "          \"gbps\": " << number(gbps(c, s.median)) << ", \"pct_peak\": "
+				 << (pct < 0 ? "null" : number(pct)) << ",\n";
+			if (c.acc_n[p] > 0) {
+				const oca_accuracy &a = c.acc[p];
+				file << "          \"accuracy\": {\"checks\": " << c.acc_n[p] << ", \"failed\": " << c.acc_failed[p]
+					 << ", \"max_abs_diff\": " << (std::isfinite(a.max_abs) ? number(a.max_abs) : "null")
+					 << ", \"max_rel_err\": " << (std::isfinite(a.max_rel) ? number(a.max_rel) : "null")
+					 << ", \"max_mismatch_pct\": " << number(mismatch_pct(c, p)) << ", \"min_psnr_db\": "
+					 << (std::isinf(a.psnr) ? "null" : number(a.psnr)) << ", \"argmin_match\": "
+					 << (a.argmin_match ? "true" : "false") << "},\n";
+			}
+			double allocs, bytes;
+			mem_per_call(c, p, allocs, bytes);
+			file << "          \"memory\": {\"allocs_per_call\": " << (allocs < 0 ? "null" : number(allocs))
+				 << ", \"alloc_bytes_per_call\": " << (bytes < 0 ? "null" : number(bytes)) << ", \"heap_peak_bytes\": "
+				 << (c.mem[p].heap_peak < 0 ? "null" : std::to_string(c.mem[p].heap_peak)) << ", \"rss_peak_kb\": "
+				 << (c.mem[p].rss_peak_kb < 0 ? "null" : std::to_string(c.mem[p].rss_peak_kb)) << ", \"drp_kb\": "
+				 << (c.mem[p].drp_kb < 0 ? "null" : std::to_string(c.mem[p].drp_kb)) << "},\n";
+			double mj, watts, fpj;
+			energy_per_frame(c, p, mj, watts, fpj);
+			if (mj >= 0) {
+				file << "          \"energy\": {\"mj_per_frame\": " << number(mj) << ", \"avg_w\": "
+					 << (watts < 0 ? "null" : number(watts)) << ", \"frames_per_j\": "
+					 << (fpj < 0 ? "null" : number(fpj)) << "},\n";
+			}
+			if (c.perf_n[p] > 0) {
+				double ipc, bpc;
+				perf_derived(c, p, ipc, bpc);
+				file << "          \"counters\": {";
+				for (int k = 0; k < OCA_PERF_NUM; k++) {
+					double v = perf_per_call(c, p, k);
+					file << json_string(oca_perf_name(k)) << ": " << (v < 0 ? "null" : number(v)) << ", ";
+				}
+				file << "\"ipc\": " << (ipc < 0 ? "null" : number(ipc)) << ", \"bytes_per_cycle\": "
+					 << (bpc < 0 ? "null" : number(bpc)) << "},\n";
+			}
+			file << "          \"samples_ms\": [";
+			for (size_t k = 0; k < c.msec[p].size(); k++) {
+				file << (k ? ", " : "") << number(c.msec[p][k]);
+			}
+			file << "]\n        }";
+			first = false;
+		}
+		file << "\n      }\n    }";
+	}
+	file << "\n  ]\n}\n";
+	return file.good() ? 0 : -1;
+}
+
+/*****************************************
+* Function Name : write_csv
+* Description   : one row per case and path; environment as leading '#' comment lines
+******************************************/
+static int write_csv(const std::filesystem::path &file_name, int iterations,
+					 const std::vector<std::pair<std::string, std::string>> &env) {
+	std::ofstream file(file_name);
+	if (!file.is_open()) {
+		return -1;
+	}
+	file << "# schema: " << OCA_REPORT_SCHEMA << "\n";
+	file << "# iterations: " << iterations << "\n";
+	for (const auto &kv: env) {
+		file << "# " << kv.first << ": " << kv.second << "\n";
+	}
+	file << "case,op,drp,in_bytes,out_bytes,path,n,min_ms,median_ms,mean_ms,stddev_ms,p90_ms,max_ms,speedup,rejected,unstable,gbps,pct_peak,"
+		 << "acc_checks,acc_failed,max_abs_diff,max_rel_err,max_mismatch_pct,min_psnr_db,"
+		 << "allocs_per_call,alloc_bytes_per_call,heap_peak_bytes,rss_peak_kb,drp_kb,"
+		 << "mj_per_frame,avg_w,frames_per_j,";
+	for (int k = 0; k < OCA_PERF_NUM; k++) {
+		file << oca_perf_name(k) << ",";
+	}
+	file << "ipc,bytes_per_cycle,samples_ms\n";
+	for (const oca_report_case &c: report_cases) {
+		double cpu = oca_report_summary(c.msec[OCA_REPORT_CPU]).median;
+		std::string drp;
+		for (size_t k = 0; k < c.drp.size(); k++) {
+			drp += (k ? ";" : "") + std::to_string(c.drp[k]);
+		}
+		for (int p = 0; p < OCA_REPORT_PATH_NUM; p++) {
+			if (c.msec[p].empty()) {
+				continue;
+			}
+			oca_report_stats s = oca_report_summary(c.msec[p]);
+			file << c.index << "," << c.op << "," << drp << "," << c.in_bytes << "," << c.out_bytes << ","
+				 << oca_report_path_name(p) << "," << s.n << "," << number(s.min) << "," << number(s.median) << ","
+				 << number(s.mean) << "," << number(s.stddev) << "," << number(s.p90) << "," << number(s.max) << ","
+				 << number(s.median > 0 ? cpu / s.median : 0) << "," << c.rejected[p] << "," << c.unstable[p] << ","
+				 << number(gbps(c, s.median)) << "," << (pct_peak(c, s.median) < 0 ? "" : number(pct_peak(c, s.median)))
+				 << ",";
+			/* Accuracy, memory and counters per call, empty when not collected */
+			if (c.acc_n[p] > 0) {
+				const oca_accuracy &a = c.acc[p];
+				file << c.acc_n[p] << "," << c.acc_failed[p] << ","
+					 << (std::isfinite(a.max_abs) ? number(a.max_abs) : "inf") << ","
+					 << (std::isfinite(a.max_rel) ? number(a.max_rel) : "inf") << ","
+					 << number(mismatch_pct(c, p)) << ","
+					 << (std::isinf(a.psnr) ? "inf" : number(a.psnr)) << ",";
+			} else {
+				file << ",,,,,,";
+			}
+			double allocs, bytes;
+			mem_per_call(c, p, allocs, bytes);
+			file << (allocs < 0 ? "" : number(allocs)) << "," << (bytes < 0 ? "" : number(bytes)) << ","
+				 << (c.mem[p].heap_peak < 0 ? "" : std::to_string(c.mem[p].heap_peak)) << ","
+				 << (c.mem[p].rss_peak_kb < 0 ? "" : std::to_string(c.mem[p].rss_peak_kb)) << ","
+				 << (c.mem[p].drp_kb < 0 ? "" : std::to_string(c.mem[p].drp_kb)) << ",";
+			double mj, watts, fpj;
+			energy_per_frame(c, p, mj, watts, fpj);
+			file << (mj < 0 ? "" : number(mj)) << "," << (watts < 0 ? "" : number(watts)) << ","
+				 << (fpj < 0 ? "" : number(fpj)) << ",";
+			double ipc, bpc;
+			perf_derived(c, p, ipc, bpc);
+			for (int k = 0; k < OCA_PERF_NUM; k++) {
+				double v = perf_per_call(c, p, k);
+				file << (v < 0 ? "" : number(v)) << ",";
+			}
+			file << (ipc < 0 ? "" : number(ipc)) << "," << (bpc < 0 ? "" : number(bpc)) << ",";
+			for (size_t k = 0; k < c.msec[p].size(); k++) {
+				file << (k ? ";" : "") << number(c.msec[p][k]);
+			}
+			file << "\n";
+		}
+	}
+	return file.good() ? 0 : -1;
+}
+
+/*****************************************
+* Function Name : print_perf
+* Description   : counter summary per case and path, when counters were collected
+******************************************/
+static void print_perf() {
+	bool header = false;
+	for (const oca_report_case &c: report_cases) {
+		for (int p = 0; p < OCA_REPORT_PATH_NUM; p++) {
+			if (c.perf_n[p] == 0) {
+				continue;
+			}
+			if (!header) {
+				printf("[PERF] per call     %12s %12s %6s %8s %10s %10s %10s %6s %8s\n", "cycles", "instr", "IPC",
+					   "B/cycle", "L1D miss", "LLC miss", "br miss", "ctxsw", "faults");
+				header = true;
+			}
+			double ipc, bpc;
+			perf_derived(c, p, ipc, bpc);
+			printf("[PERF] %2d %-12s %s", c.index, c.op.c_str(), oca_report_path_name(p));
+			printf(" %12.0f %12.0f %6.2f %8.3f", perf_per_call(c, p, OCA_PERF_CYCLES),
+				   perf_per_call(c, p, OCA_PERF_INSTRUCTIONS), ipc, bpc);
+			printf(" %10.0f %10.0f %10.0f %6.0f %8.0f\n", perf_per_call(c, p, OCA_PERF_L1D_MISSES),
+				   perf_per_call(c, p, OCA_PERF_LLC_MISSES), perf_per_call(c, p, OCA_PERF_BRANCH_MISSES),
+				   perf_per_call(c, p, OCA_PERF_CTX_SWITCHES), perf_per_call(c, p, OCA_PERF_PAGE_FAULTS));
+		}
+	}
+	if (header) {
+		printf("[PERF] -1 = counter not available\n");
+	}
+}
+
+/*****************************************
+* Function Name : print_accuracy
+* Description   : worst comparison against the CPU output per case and path
+******************************************/
+static void print_accuracy() {
+	bool header = false;
+	for (const oca_report_case &c: report_cases) {
+		for (int p = 0; p < OCA_REPORT_PATH_NUM; p++) {
+			if (c.acc_n[p] == 0) {
+				continue;
+			}
+			if (!header) {
+				printf("[ACC] vs cpu                max diff  max rel err  mismatch%%  min PSNR  argmin  failed\n");
+				header = true;
+			}
+			const oca_accuracy &a = c.acc[p];
+			printf("[ACC] %2d %-18s %s %9.3f %12.3g %10.3f %8.1fdB %7s %3zu/%zu\n", c.index, c.op.c_str(),
+				   oca_report_path_name(p), a.max_abs, a.max_rel, mismatch_pct(c, p), a.psnr,
+				   a.argmin_match ? "ok" : "DIFF", c.acc_failed[p], c.acc_n[p]);
+		}
+	}
+}
+
+/*****************************************
+* Function Name : print_memory
+* Description   : memory footprint per case and path
+******************************************/
+static void print_memory() {
+	printf("[MEM] per call          allocs    alloc KB heap peak KB rss peak KB  DRP KB\n");
+	for (const oca_report_case &c: report_cases) {
+		for (int p = 0; p < OCA_REPORT_PATH_NUM; p++) {
+			if (c.msec[p].empty()) {
+				continue;
+			}
+			double allocs, bytes;
+			mem_per_call(c, p, allocs, bytes);
+			printf("[MEM] %2d %-12s %s %8.1f %11.1f %12.1f %11ld %7ld\n", c.index, c.op.c_str(),
+				   oca_report_path_name(p), allocs, bytes / 1024, (double)c.mem[p].heap_peak / 1024,
+				   c.mem[p].rss_peak_kb, c.mem[p].drp_kb);
+		}
+	}
+	printf("[MEM] heap and RSS are process-wide (all threads), -1 = not available%s\n",
+		   oca_memory_counting() ? "" : ", heap counting needs --mem");
+}
+
+/*****************************************
+* Function Name : print_energy
+* Description   : energy per call and perf-per-watt per case and path, when a source was open
+******************************************/
+static void print_energy() {
+	bool header = false;
+	for (const oca_report_case &c: report_cases) {
+		double cpu, w, f;
+		energy_per_frame(c, OCA_REPORT_CPU, cpu, w, f);
+		for (int p = 0; p < OCA_REPORT_PATH_NUM; p++) {
+			double mj, watts, fpj;
+			energy_per_frame(c, p, mj, watts, fpj);
+			if (mj < 0) {
+				continue;
+			}
+			if (!header) {
+				printf("[ENERGY] source %s\n", oca_energy_source_name());
+				printf("[ENERGY] per call              mJ    avg W  frames/J  vs cpu\n");
+				header = true;
+			}
+			printf("[ENERGY] %2d %-18s %s %9.3f %8.3f %9.2f %6.2fx\n", c.index, c.op.c_str(),
+				   oca_report_path_name(p), mj, watts, fpj, (cpu > 0 && mj > 0) ? cpu / mj : 0);
+		}
+	}
+}
+
+/*****************************************
+* Function Name : print_roofline
+* Description   : achieved bandwidth per case and path against the probed peak
+******************************************/
+static void print_roofline() {
+	if (!report_roofline.valid) {
+		return;
+	}
+	printf("[ROOF] peak %.2fGB/s, image bytes moved per call / median time\n", report_roofline.peak);
+	for (const oca_report_case &c: report_cases) {
+		for (int p = 0; p < OCA_REPORT_PATH_NUM; p++) {
+			if (c.msec[p].empty()) {
+				continue;
+			}
+			double median = oca_report_summary(c.msec[p]).median;
+			printf("[ROOF] %2d %-18s %s %8.3fGB/s %6.1f%%\n", c.index, c.op.c_str(), oca_report_path_name(p),
+				   gbps(c, median), pct_peak(c, median));
+		}
+	}
+}
+
+/*****************************************
+* Function Name : oca_report_set_roofline
+* Description   : bandwidth reference for the efficiency columns
+******************************************/
+void oca_report_set_roofline(const oca_roofline &roofline) {
+	report_roofline = roofline;
+}
+
+/*****************************************
+* Function Name : oca_report_write
+* Description   : write OCA_REPORT_JSON and OCA_REPORT_CSV for all recorded cases
+* Arguments     : dir = results directory
+*                 iterations = timed calls per case and path
+* Return value  : 0 on success, -1 on error
+******************************************/
+int oca_report_write(const std::filesystem::path &dir, int iterations) {
+	close_case();
+	std::vector<std::pair<std::string, std::string>> env = oca_report_environment();
+	if (write_json(dir / OCA_REPORT_JSON, iterations, env) < 0) {
+		std::cerr << "Error: Cannot write " << dir / OCA_REPORT_JSON << std::endl;
+		return -1;
+	}
+	if (write_csv(dir / OCA_REPORT_CSV, iterations, env) < 0) {
+		std::cerr << "Error: Cannot write " << dir / OCA_REPORT_CSV << std::endl;
+		return -1;
+	}
+	print_accuracy();
+	print_memory();
+	print_perf();
+	print_energy();
+	print_roofline();
+	printf("[REPORT] %s, %s\n", (dir / OCA_REPORT_JSON).c_str(), (dir / OCA_REPORT_CSV).c_str());
+	return 0;
+}
@@ -0,0 +1,97 @@
+/***********************************************************************************************************************
+* Copyright (C) 2024 Renesas Electronics Corporation. All rights reserved.
+***********************************************************************************************************************/
+/***********************************************************************************************************************
+* File Name    : oca_report.h
+* Version      : 1.00
+* Description  : Per-case timing collection and machine-readable results (JSON / CSV) with environment metadata
+***********************************************************************************************************************/
+
+#ifndef OCA_REPORT_H
+#define OCA_REPORT_H
+
+/*****************************************
+* Includes
+******************************************/
+#include <filesystem>
+#include <initializer_list>
+#include <string>
+#include <vector>
+#include "oca_report_file.h"
+#include "oca_perf.h"
+#include "oca_stable.h"
+#include "oca_roofline.h"
+#include "oca_memory.h"
+#include "oca_accuracy.h"
+#include "oca_energy.h"
+
+/*****************************************
+* Macros
+******************************************/
+/* Measured paths */
+#define OCA_REPORT_CPU          (0)
+#define OCA_REPORT_OCA          (1)
+#define OCA_REPORT_FIX          (2)     /* fixed-point CPU fallback */
+#define OCA_REPORT_PATH_NUM     (3)
+#define OCA_REPORT_CPU_OCA_NUM  (2)     /* CPU and OCA only, as compared by the profiling modes */
+
+/* Samples taken while the CPU frequency changed or the CPU was throttled are re-run,
+   up to OCA_REPORT_RETRIES times the iteration count per path, then kept and flagged */
+#define OCA_REPORT_RETRIES      (2)
+
+/*****************************************
+* Typedefs
+******************************************/
+/* Summary of the samples of one path */
+struct oca_report_stats {
+	size_t n;
+	double min;
+	double median;
+	double mean;
+	double stddev;
+	double p90;
+	double max;
+};
+
+/* One benchmark case */
+struct oca_report_case {
+	int index;                                  /* [n] of the case */
+	std::string op;
+	std::vector<int> drp;                       /* DRP circuits used by the OCA path */
+	size_t in_bytes;
+	size_t out_bytes;
+	int passes;                                 /* passes over the image per call (morphology iterations) */
+	std::vector<double> msec[OCA_REPORT_PATH_NUM];
+	oca_perf_sample perf[OCA_REPORT_PATH_NUM];  /* counter sums over perf_n samples */
+	size_t perf_n[OCA_REPORT_PATH_NUM];
+	size_t rejected[OCA_REPORT_PATH_NUM];       /* samples discarded and re-run */
+	size_t unstable[OCA_REPORT_PATH_NUM];       /* kept samples with a frequency change / throttling */
+	oca_memory_usage mem[OCA_REPORT_PATH_NUM];  /* allocs / alloc_bytes summed over the kept samples, the rest max */
+	oca_accuracy acc[OCA_REPORT_PATH_NUM];      /* worst result over all checks against the CPU output */
+	size_t acc_n[OCA_REPORT_PATH_NUM];
+	size_t acc_failed[OCA_REPORT_PATH_NUM];
+	double energy_j[OCA_REPORT_PATH_NUM];       /* summed over energy_n kept samples */
+	size_t energy_n[OCA_REPORT_PATH_NUM];
+	oca_stable_state sys_before;                /* cpufreq / thermal state around the case */
+	oca_stable_state sys_after;
+};
+
+/*****************************************
+* Functions
+******************************************/
+void oca_report_add_case(const char *op, std::initializer_list<int> drp, size_t in_bytes, size_t out_bytes,
+						 int passes = 1);
+void oca_report_set_roofline(const oca_roofline &roofline);
+void oca_report_set_heatmap_dir(const std::filesystem::path &dir);
+void oca_report_reference(const cv::Mat &ref);
+void oca_report_accuracy(int path, const cv::Mat &out);
+double oca_report_exact(int path, const cv::Mat &ref, const cv::Mat &out);
+bool oca_report_next(int path, int iterations);
+void oca_report_start(int path);
+void oca_report_stop(int path);
+double oca_report_median(int path);
+oca_report_stats oca_report_summary(std::vector<double> samples);
+const char *oca_report_path_name(int path);
+int oca_report_write(const std::filesystem::path &dir, int iterations);
+
+#endif
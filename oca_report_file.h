@@ -0,0 +1,21 @@
+/***********************************************************************************************************************
+* Copyright (C) 2024 Renesas Electronics Corporation. All rights reserved.
+***********************************************************************************************************************/
+/***********************************************************************************************************************
+* File Name    : oca_report_file.h
+* Version      : 1.00
+* Description  : Result file names and schema version, shared by oca_sample and the OpenCV-free oca_compare
+***********************************************************************************************************************/
+
+#ifndef OCA_REPORT_FILE_H
+#define OCA_REPORT_FILE_H
+
+/*****************************************
+* Macros
+******************************************/
+/* Output files, written to the results directory */
+#define OCA_REPORT_JSON         "oca_results.json"
+#define OCA_REPORT_CSV          "oca_results.csv"
+#define OCA_REPORT_SCHEMA       (7)
+
+#endif
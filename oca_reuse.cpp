@@ -0,0 +1,274 @@
+/***********************************************************************************************************************
+* Copyright (C) 2024 Renesas Electronics Corporation. All rights reserved.
+***********************************************************************************************************************/
+/***********************************************************************************************************************
+* File Name    : oca_reuse.cpp
+* Version      : 1.00
+* Description  : Buffer planning for op chains: in-place execution and ping-pong reuse instead of one output per op
+***********************************************************************************************************************/
+
+/*****************************************
+* Includes
+******************************************/
+#include "define.h"
+#include "oca_reuse.h"
+#include "oca_memory.h"
+#include "oca_op_table.h"
+#include "oca_perf.h"
+#include "oca_report.h"
+#include "oca_stable.h"
+#include <algorithm>
+#include <string>
+#include <sys/resource.h>
+#include <unistd.h>
+
+/*****************************************
+* Macros
+******************************************/
+#define REUSE_LAYOUT_PER_OP     (0)             /* a fresh output per op and frame, all kept to the end */
+#define REUSE_LAYOUT_PLANNED    (1)
+#define REUSE_LAYOUT_NUM        (2)
+
+#define REUSE_LINE_BYTES        (64)            /* bytes moved per LLC miss */
+
+/*****************************************
+* Typedefs
+******************************************/
+/* One layout on one path, per frame */
+struct reuse_result {
+	double msec;                        /* median */
+	double allocs;
+	double alloc_mb;
+	double faults;                      /* minor page faults */
+	double footprint_mb;                /* distinct intermediate buffers */
+	double read_mb;                     /* step inputs */
+	double write_mb;                    /* step outputs plus pages zero-filled on first touch */
+	double llc_mb;                      /* LLC misses * line size, -1 without --perf */
+	cv::Mat out;                        /* last frame's result */
+};
+
+/*****************************************
+* Function Name : oca_reuse_plan_chain
+* Description   : assign an output buffer to every step of a linear chain. A step that may alias its input
+*                 writes into the buffer it reads, unless that is the caller's input frame. Otherwise it takes
+*                 a buffer of matching size and type that is not being read, and only if none exists a new one.
+*                 Output shapes are found by running the chain once.
+* Return value  : number of buffers
+******************************************/
+int oca_reuse_plan_chain(const std::vector<oca_reuse_step> &steps, const cv::Mat &input, oca_reuse_plan &plan) {
+	cv::Mat cur = input, next;
+	int reading = -1;                           /* buffer read by the current step, -1 = input frame */
+	plan = oca_reuse_plan();
+	for (const oca_reuse_step &s: steps) {
+		s.run(cur, next);
+		int b = -1;
+		if (s.inplace != OCA_REUSE_DISTINCT && reading >= 0) {
+			b = reading;
+		} else {
+			for (size_t k = 0; k < plan.size.size() && b < 0; k++) {
+				if ((int)k != reading && plan.size[k] == next.size() && plan.type[k] == next.type()) {
+					b = (int)k;
+				}
+			}
+			if (b < 0) {
+				b = (int)plan.size.size();
+				plan.size.push_back(next.size());
+				plan.type.push_back(next.type());
+			}
+		}
+		plan.out.push_back(b);
+		reading = b;
+		cur = next;
+		next = cv::Mat();
+	}
+	return (int)plan.size.size();
+}
+
+/*****************************************
+* Function Name : minor_faults
+* Description   : minor page faults of the process so far: first touches of fresh pages, zero-filled by the kernel
+******************************************/
+static long minor_faults() {
+	struct rusage ru;
+	getrusage(RUSAGE_SELF, &ru);
+	return ru.ru_minflt;
+}
+
+/*****************************************
+* Function Name : run_layout
+* Description   : time samples frames of the chain with one buffer layout
+******************************************/
+static void run_layout(const std::vector<oca_reuse_step> &steps, const oca_reuse_plan &plan, int layout,
+					   const cv::Mat &image, int samples, reuse_result &r) {
+	std::vector<cv::Mat> pool(plan.size.size());
+	std::vector<double> t(samples);
+	oca_memory_mark mark;
+	oca_memory_usage usage;
+
+	auto frame = [&] {
+		if (layout == REUSE_LAYOUT_PER_OP) {
+			std::vector<cv::Mat> outs(steps.size());
+			const cv::Mat *src = &image;
+			for (size_t i = 0; i < steps.size(); i++) {
+				steps[i].run(*src, outs[i]);
+				src = &outs[i];
+			}
+			r.out = outs.back();
+		} else {
+			const cv::Mat *src = &image;
+			for (size_t i = 0; i < steps.size(); i++) {
+				cv::Mat &dst = pool[plan.out[i]];
+				steps[i].run(*src, dst);
+				src = &dst;
+			}
+			r.out = pool[plan.out.back()];
+		}
+		oca_s = r.out.data[0];                 //for suppress optimization
+	};
+
+	/* Planned buffers are allocated once, outside the timed frames */
+	for (size_t k = 0; k < pool.size(); k++) {
+		pool[k].create(plan.size[k], plan.type[k]);
+		pool[k].setTo(cv::Scalar::all(0));
+	}
+	r.footprint_mb = r.read_mb = r.write_mb = 0;
+	cv::Mat cur = image, next;
+	for (const oca_reuse_step &s: steps) {
+		s.run(cur, next);
+		r.read_mb += (double)(cur.total() * cur.elemSize()) / 1E6;
+		r.write_mb += (double)(next.total() * next.elemSize()) / 1E6;
+		if (layout == REUSE_LAYOUT_PER_OP) {
+			r.footprint_mb += (double)(next.total() * next.elemSize()) / 1E6;
+		}
+		cur = next;
+		next = cv::Mat();
+	}
+	if (layout == REUSE_LAYOUT_PLANNED) {
+		for (const cv::Mat &m: pool) {
+			r.footprint_mb += (double)(m.total() * m.elemSize()) / 1E6;
+		}
+	}
+
+	frame();                                    /* untimed: first-call effects */
+	bool llc = oca_perf_active() && oca_perf_valid(OCA_PERF_LLC_MISSES);
+	oca_perf_sample perf = {};
+	long faults = minor_faults();
+	oca_memory_begin(mark);
+	if (llc) {
+		oca_perf_start();
+	}
+	for (double &v: t) {
+		uint64_t t0 = oca_stable_now_ns();
+		frame();
+		v = (double)(oca_stable_now_ns() - t0) / 1E6;
+	}
+	if (llc) {
+		oca_perf_stop(perf);
+	}
+	oca_memory_end(mark, usage);
+	r.faults = (double)(minor_faults() - faults) / samples;
+	r.write_mb += r.faults * (double)sysconf(_SC_PAGESIZE) / 1E6;
+	r.llc_mb = llc ? (double)perf.value[OCA_PERF_LLC_MISSES] * REUSE_LINE_BYTES / samples / 1E6 : -1;
+	r.allocs = usage.allocs >= 0 ? (double)usage.allocs / samples : -1;
+	r.alloc_mb = usage.alloc_bytes >= 0 ? (double)usage.alloc_bytes / samples / 1E6 : -1;
+	r.out = r.out.clone();
+	std::sort(t.begin(), t.end());
+	r.msec = t[t.size() / 2];
+}
+
+/*****************************************
+* Function Name : set_circuits
+* Description   : set the circuits of all steps and apply the function list
+******************************************/
+static void set_circuits(const std::vector<oca_reuse_step> &steps, unsigned long *OCA_f, unsigned long state) {
+	for (const oca_reuse_step &s: steps) {
+		if (s.desc) {
+			oca_op_set(OCA_f, *s.desc, state);
+		}
+	}
+	oca_activate(OCA_f);
+}
+
+/*****************************************
+* Function Name : oca_reuse_benchmark
+* Description   : run a chain of case ops on the CPU and OCA paths, once with a fresh output per op (the
+*                 pattern of the cases) and once with the planned buffers. Reports latency, allocations,
+*                 page faults, the intermediate footprint and the memory traffic per frame, and checks both
+*                 give the same result.
+* Arguments     : image = FHD BGR frame
+*                 OCA_f = OCA_Activate function list
+*                 iterations = timed frames (at least OCA_REUSE_MIN_SAMPLES)
+* Return value  : 0 on success
+******************************************/
+int oca_reuse_benchmark(const cv::Mat &image, unsigned long *OCA_f, int iterations) {
+	static float k_persp[9] = {0.5, 0.2, 20, -0.1, 0.8, 50, -0.001, 0.001, 1.0};
+	const cv::Mat persp(3, 3, CV_32FC1, k_persp);
+	const cv::Mat affine = cv::getRotationMatrix2D(cv::Point2f(image.cols / 2.0f, image.rows / 2.0f), 45, 1);
+	const std::vector<oca_reuse_step> steps = {
+		{"GaussianBlur", &oca_op_table[OCA_CASE_GAUSSIAN], OCA_REUSE_LINEBUF,
+			[](const cv::Mat &s, cv::Mat &d) { cv::GaussianBlur(s, d, {7, 7}, 0, 0); }},
+		{"warpAffine", &oca_op_table[OCA_CASE_AFFINE], OCA_REUSE_DISTINCT,
+			[&affine](const cv::Mat &s, cv::Mat &d) { cv::warpAffine(s, d, affine, s.size()); }},
+		{"filter2D", &oca_op_table[OCA_CASE_FILTER2D], OCA_REUSE_LINEBUF,
+			[](const cv::Mat &s, cv::Mat &d) { cv::filter2D(s, d, -1, oca_filter2d_kernel()); }},
+		{"warpPerspective", &oca_op_table[OCA_CASE_PERSPECTIVE], OCA_REUSE_DISTINCT,
+			[&persp](const cv::Mat &s, cv::Mat &d) { cv::warpPerspective(s, d, persp, s.size()); }},
+		{"dilate", &oca_op_table[OCA_CASE_DILATE], OCA_REUSE_LINEBUF,
+			[](const cv::Mat &s, cv::Mat &d) { cv::dilate(s, d, cv::Mat()); }},
+		{"pyrDown", &oca_op_table[OCA_CASE_PYR_DOWN], OCA_REUSE_DISTINCT,
+			[](const cv::Mat &s, cv::Mat &d) { cv::pyrDown(s, d); }},
+		{"cvtColor(gray)", nullptr, OCA_REUSE_DISTINCT,
+			[](const cv::Mat &s, cv::Mat &d) { cv::cvtColor(s, d, cv::COLOR_BGR2GRAY); }},
+		/* The block mean goes to a separate buffer first, the threshold itself is pointwise */
+		{"adaptiveThreshold", &oca_op_table[OCA_CASE_A_THRESHOLD], OCA_REUSE_POINTWISE,
+			[](const cv::Mat &s, cv::Mat &d) {
+				cv::adaptiveThreshold(s, d, 0xFF, cv::ADAPTIVE_THRESH_MEAN_C, cv::THRESH_BINARY, 99, 0);
+			}},
+		{"bitwise_not", nullptr, OCA_REUSE_POINTWISE, [](const cv::Mat &s, cv::Mat &d) { cv::bitwise_not(s, d); }},
+	};
+	static const char *const layout_name[REUSE_LAYOUT_NUM] = {"per-op", "planned"};
+	static const char *const inplace_name[] = {"", " in place (pointwise)", " in place (line buffers)"};
+	const int samples = std::max(iterations, OCA_REUSE_MIN_SAMPLES);
+	oca_reuse_plan plan;
+
+	set_circuits(steps, OCA_f, OPENCVA_FUNC_DISABLE);
+	int buffers = oca_reuse_plan_chain(steps, image, plan);
+	printf("[REUSE] chain of %zu ops, %d planned buffers\n", steps.size(), buffers);
+	for (size_t i = 0; i < steps.size(); i++) {
+		int b = plan.out[i];
+		int in = i ? plan.out[i - 1] : -1;
+		std::string from = in < 0 ? "input" : "b" + std::to_string(in);
+		printf("[REUSE]   %-18s %5s -> b%d %dx%dx%d%s\n", steps[i].op, from.c_str(), b, plan.size[b].width,
+			   plan.size[b].height, CV_MAT_CN(plan.type[b]), b == in ? inplace_name[steps[i].inplace] : "");
+	}
+
+	printf("[REUSE] %d frames, per frame: median msec, heap allocations, allocated MB, minor page faults, "
+		   "intermediate footprint MB, MB read and written by the steps (written includes zero-filled pages), "
+		   "MB moved by LLC misses\n", samples);
+	printf("[REUSE] path layout   %9s %8s %9s %8s %10s %8s %8s %8s\n", "msec", "allocs", "alloc MB", "faults",
+		   "footprint", "read", "written", "LLC");
+	for (int p = OCA_REPORT_CPU; p <= OCA_REPORT_OCA; p++) {
+		reuse_result r[REUSE_LAYOUT_NUM];
+		set_circuits(steps, OCA_f, p == OCA_REPORT_OCA ? OPENCVA_FUNC_ENABLE : OPENCVA_FUNC_DISABLE);
+		for (int l = 0; l < REUSE_LAYOUT_NUM; l++) {
+			run_layout(steps, plan, l, image, samples, r[l]);
+			printf("[REUSE] %s  %-8s %9.3f %8.1f %9.2f %8.0f %10.2f %8.2f %8.2f %8.2f\n", oca_report_path_name(p),
+				   layout_name[l], r[l].msec, r[l].allocs, r[l].alloc_mb, r[l].faults, r[l].footprint_mb, r[l].read_mb,
+				   r[l].write_mb, r[l].llc_mb);
+		}
+		const reuse_result &a = r[REUSE_LAYOUT_PER_OP], &b = r[REUSE_LAYOUT_PLANNED];
+		printf("[REUSE] %s  latency -%.1f%%, footprint -%.1f%%, page faults -%.0f per frame, max diff %.0f\n",
+			   oca_report_path_name(p), a.msec > 0 ? (a.msec - b.msec) * 100.0 / a.msec : 0,
+			   a.footprint_mb > 0 ? (a.footprint_mb - b.footprint_mb) * 100.0 / a.footprint_mb : 0,
+			   a.faults - b.faults, cv::norm(a.out, b.out, cv::NORM_INF));
+	}
+	set_circuits(steps, OCA_f, OPENCVA_FUNC_DISABLE);
+	if (!oca_memory_counting()) {
+		printf("[REUSE] heap counting off (--mem), allocation columns are -1\n");
+	}
+	if (!oca_perf_active() || !oca_perf_valid(OCA_PERF_LLC_MISSES)) {
+		printf("[REUSE] LLC misses not counted (--perf), LLC column is -1\n");
+	}
+	printf("\n");
+	return 0;
+}
@@ -0,0 +1,55 @@
+/***********************************************************************************************************************
+* Copyright (C) 2024 Renesas Electronics Corporation. All rights reserved.
+***********************************************************************************************************************/
+/***********************************************************************************************************************
+* File Name    : oca_reuse.h
+* Version      : 1.00
+* Description  : Buffer planning for op chains: in-place execution and ping-pong reuse instead of one output per op
+***********************************************************************************************************************/
+
+#ifndef OCA_REUSE_H
+#define OCA_REUSE_H
+
+/*****************************************
+* Includes
+******************************************/
+#include <functional>
+#include <vector>
+#include <opencv2/opencv.hpp>
+
+/*****************************************
+* Macros
+******************************************/
+/* How a step may share its output with its input */
+#define OCA_REUSE_DISTINCT      (0)             /* needs its own output: geometric, resizing or type-changing ops */
+#define OCA_REUSE_POINTWISE     (1)             /* dst may alias src: each output pixel reads only its input pixel */
+#define OCA_REUSE_LINEBUF       (2)             /* dst may alias src: neighbourhood op reading through line buffers */
+
+#define OCA_REUSE_MIN_SAMPLES   (3)             /* timed frames per layout and path, median reported */
+
+/*****************************************
+* Typedefs
+******************************************/
+struct oca_op_desc;
+
+struct oca_reuse_step {
+	const char *op;
+	const oca_op_desc *desc;            /* case of the circuit, nullptr = CPU only */
+	int inplace;                        /* OCA_REUSE_* */
+	std::function<void(const cv::Mat &, cv::Mat &)> run;
+};
+
+/* Buffer assignment of a chain: step i writes buffer out[i], buffers are allocated once */
+struct oca_reuse_plan {
+	std::vector<int> out;
+	std::vector<cv::Size> size;         /* per buffer */
+	std::vector<int> type;
+};
+
+/*****************************************
+* Functions
+******************************************/
+int oca_reuse_plan_chain(const std::vector<oca_reuse_step> &steps, const cv::Mat &input, oca_reuse_plan &plan);
+int oca_reuse_benchmark(const cv::Mat &image, unsigned long *OCA_f, int iterations);
+
+#endif
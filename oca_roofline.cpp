@@ -0,0 +1,115 @@
+/***********************************************************************************************************************
+* Copyright (C) 2024 Renesas Electronics Corporation. All rights reserved.
+***********************************************************************************************************************/
+/***********************************************************************************************************************
+* File Name    : oca_roofline.cpp
+* Version      : 1.00
+* Description  : STREAM-like memory bandwidth probe, the reference for per-op bandwidth efficiency
+***********************************************************************************************************************/
+
+/*****************************************
+* Includes
+******************************************/
+#include "define.h"
+#include "oca_roofline.h"
+#include "oca_stable.h"
+#include <algorithm>
+#include <memory>
+#include <thread>
+
+/*****************************************
+* Macros
+******************************************/
+#define STREAM_SCALAR           (3.0)
+
+/*****************************************
+* Function Name : stream_kernel
+* Description   : one pass of a kernel over [begin, end)
+******************************************/
+static void stream_kernel(int kernel, double *a, const double *b, const double *c, size_t begin, size_t end) {
+	switch (kernel) {
+		case OCA_ROOFLINE_COPY:
+			for (size_t i = begin; i < end; i++) {
+				a[i] = b[i];
+			}
+			break;
+		case OCA_ROOFLINE_SCALE:
+			for (size_t i = begin; i < end; i++) {
+				a[i] = STREAM_SCALAR * b[i];
+			}
+			break;
+		default:
+			for (size_t i = begin; i < end; i++) {
+				a[i] = b[i] + STREAM_SCALAR * c[i];
+			}
+			break;
+	}
+}
+
+/*****************************************
+* Function Name : stream_run
+* Description   : best-of bandwidth of a kernel with a given number of threads, each on its own slice
+* Return value  : GB/s
+******************************************/
+static double stream_run(int kernel, int threads, double *a, const double *b, const double *c) {
+	const size_t n = OCA_ROOFLINE_ELEMS;
+	const double bytes = (double)n * sizeof(double) * (kernel == OCA_ROOFLINE_TRIAD ? 3 : 2);
+	double best = 0;
+	for (int r = 0; r < OCA_ROOFLINE_REPEAT; r++) {
+		std::vector<std::thread> pool;
+		uint64_t t0 = oca_stable_now_ns();
+		for (int t = 1; t < threads; t++) {
+			pool.emplace_back(stream_kernel, kernel, a, b, c, n * t / threads, n * (t + 1) / threads);
+		}
+		stream_kernel(kernel, a, b, c, 0, n / threads);
+		for (std::thread &th: pool) {
+			th.join();
+		}
+		uint64_t t1 = oca_stable_now_ns();
+		oca_s = (int)a[n / 2];      //for suppress optimization
+		best = std::max(best, bytes / (double)(t1 - t0));
+	}
+	return best;
+}
+
+/*****************************************
+* Function Name : oca_roofline_probe
+* Description   : copy / scale / triad bandwidth on one thread and on all online CPUs.
+*                 The multi-threaded runs start their threads inside the timed region, which
+*                 costs well under 1% at this array size.
+* Arguments     : result = output
+* Return value  : 0 on success, -ENOMEM
+******************************************/
+int oca_roofline_probe(oca_roofline &result) {
+	const size_t n = OCA_ROOFLINE_ELEMS;
+	std::unique_ptr<double[]> a(new (std::nothrow) double[n]);
+	std::unique_ptr<double[]> b(new (std::nothrow) double[n]);
+	std::unique_ptr<double[]> c(new (std::nothrow) double[n]);
+	result = oca_roofline();
+	if (!a || !b || !c) {
+		return -ENOMEM;
+	}
+	/* Touch every page before timing */
+	for (size_t i = 0; i < n; i++) {
+		a[i] = 0.0;
+		b[i] = 1.0;
+		c[i] = 2.0;
+	}
+	result.threads = std::max(1, (int)sysconf(_SC_NPROCESSORS_ONLN));
+	for (int k = 0; k < OCA_ROOFLINE_KERNEL_NUM; k++) {
+		result.single[k] = stream_run(k, 1, a.get(), b.get(), c.get());
+		result.multi[k] = stream_run(k, result.threads, a.get(), b.get(), c.get());
+		result.peak = std::max(result.peak, std::max(result.single[k], result.multi[k]));
+	}
+	result.valid = true;
+	return 0;
+}
+
+/*****************************************
+* Function Name : oca_roofline_kernel_name
+* Description   : report key of a kernel
+******************************************/
+const char *oca_roofline_kernel_name(int kernel) {
+	static const char *const name[OCA_ROOFLINE_KERNEL_NUM] = {"copy", "scale", "triad"};
+	return (kernel >= 0 && kernel < OCA_ROOFLINE_KERNEL_NUM) ? name[kernel] : "unknown";
+}
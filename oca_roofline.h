@@ -0,0 +1,49 @@
+/***********************************************************************************************************************
+* Copyright (C) 2024 Renesas Electronics Corporation. All rights reserved.
+***********************************************************************************************************************/
+/***********************************************************************************************************************
+* File Name    : oca_roofline.h
+* Version      : 1.00
+* Description  : STREAM-like memory bandwidth probe, the reference for per-op bandwidth efficiency
+***********************************************************************************************************************/
+
+#ifndef OCA_ROOFLINE_H
+#define OCA_ROOFLINE_H
+
+/*****************************************
+* Includes
+******************************************/
+#include <stddef.h>
+
+/*****************************************
+* Macros
+******************************************/
+/* Array length in doubles: 3 arrays of 32MB, far larger than the A55 caches */
+#define OCA_ROOFLINE_ELEMS      (4 * 1024 * 1024)
+#define OCA_ROOFLINE_REPEAT     (5)             /* best of */
+
+/* Kernels */
+#define OCA_ROOFLINE_COPY       (0)             /* a = b            16 B/elem */
+#define OCA_ROOFLINE_SCALE      (1)             /* a = s * b        16 B/elem */
+#define OCA_ROOFLINE_TRIAD      (2)             /* a = b + s * c    24 B/elem */
+#define OCA_ROOFLINE_KERNEL_NUM (3)
+
+/*****************************************
+* Typedefs
+******************************************/
+/* Probe result, GB/s (1E9 bytes/sec) */
+struct oca_roofline {
+	bool valid;
+	int threads;                                        /* thread count of the multi-threaded run */
+	double single[OCA_ROOFLINE_KERNEL_NUM];
+	double multi[OCA_ROOFLINE_KERNEL_NUM];
+	double peak;                                        /* attainable bandwidth: best multi-threaded kernel */
+};
+
+/*****************************************
+* Functions
+******************************************/
+int oca_roofline_probe(oca_roofline &result);
+const char *oca_roofline_kernel_name(int kernel);
+
+#endif
@@ -0,0 +1,423 @@
+/***********************************************************************************************************************
+* Copyright (C) 2024 Renesas Electronics Corporation. All rights reserved.
+***********************************************************************************************************************/
+/***********************************************************************************************************************
+* File Name    : oca_server.cpp
+* Version      : 1.00
+* Description  : Accelerator-arbitration server. Owns the OCA circuit state and executes resize / warpAffine
+*                requests from several processes, batched and reordered to minimize circuit reconfiguration.
+***********************************************************************************************************************/
+
+/*****************************************
+* Includes
+******************************************/
+#include "define.h"
+#include "oca_server.h"
+#include "oca_op_table.h"
+#include "oca_sim.h"
+#include <algorithm>
+#include <iostream>
+#include <signal.h>
+#include <poll.h>
+#include <sys/socket.h>
+#include <sys/un.h>
+
+/* Provided by the DRP-patched OpenCV. Weak so the server also links against stock OpenCV and runs on the CPU */
+int OCA_Activate(unsigned long *OCA_list) __attribute__((weak));
+
+/*****************************************
+* Macros
+******************************************/
+#define SRV_MAX_CLIENTS         (32)
+#define SRV_BATCH_WINDOW_US     (200)
+#define SRV_MAX_DIM             (16384)         /* largest accepted image width / height */
+
+/*****************************************
+* Typedefs
+******************************************/
+/* Received request waiting for execution */
+struct srv_pending {
+	int client;
+	int src_fd;
+	int dst_fd;
+	uint64_t recv_ns;
+	oca_srv_request req;
+};
+
+/*****************************************
+* Global Variables
+******************************************/
+static volatile sig_atomic_t srv_stop;
+/* Circuit per OCA_SRV_OP_* */
+static constexpr int srv_op_drp[OCA_SRV_OP_NUM] = {oca_case<OCA_CASE_RESIZE>.drp[0], oca_case<OCA_CASE_AFFINE>.drp[0]};
+
+/*****************************************
+* Function Name : srv_on_signal
+* Description   : SIGINT/SIGTERM handler
+******************************************/
+static void srv_on_signal(int) {
+	srv_stop = 1;
+}
+
+/*****************************************
+* Function Name : srv_now_ns
+* Description   : CLOCK_MONOTONIC in ns
+******************************************/
+static uint64_t srv_now_ns() {
+	struct timespec ts;
+	clock_gettime(CLOCK_MONOTONIC, &ts);
+	return (uint64_t)ts.tv_sec * 1000000000ull + ts.tv_nsec;
+}
+
+/*****************************************
+* Function Name : srv_recv
+* Description   : read every queued request of one client without blocking
+* Return value  : 0 on success, -1 if the client disconnected
+******************************************/
+static int srv_recv(int client, std::vector<srv_pending> &pending) {
+	for (;;) {
+		srv_pending p = {};
+		char ctrl[CMSG_SPACE(2 * sizeof(int))];
+		struct iovec iov = {&p.req, sizeof(p.req)};
+		struct msghdr msg = {};
+		msg.msg_iov = &iov;
+		msg.msg_iovlen = 1;
+		msg.msg_control = ctrl;
+		msg.msg_controllen = sizeof(ctrl);
+
+		ssize_t n = recvmsg(client, &msg, MSG_DONTWAIT | MSG_CMSG_CLOEXEC);
+		if (n < 0 && (errno == EAGAIN || errno == EWOULDBLOCK)) {
+			return 0;
+		}
+		if (n <= 0) {
+			return -1;
+		}
+
+		p.client = client;
+		p.src_fd = p.dst_fd = -1;
+		p.recv_ns = srv_now_ns();
+		/* Take exactly two fds with a complete request; anything else is closed and answered with -EINVAL */
+		std::vector<int> fds;
+		for (struct cmsghdr *cmsg = CMSG_FIRSTHDR(&msg); cmsg; cmsg = CMSG_NXTHDR(&msg, cmsg)) {
+			if (cmsg->cmsg_level == SOL_SOCKET && cmsg->cmsg_type == SCM_RIGHTS) {
+				size_t count = (cmsg->cmsg_len - CMSG_LEN(0)) / sizeof(int);
+				for (size_t k = 0; k < count; k++) {
+					int fd;
+					memcpy(&fd, CMSG_DATA(cmsg) + k * sizeof(int), sizeof(int));
+					fds.push_back(fd);
+				}
+			}
+		}
+		if (n == (ssize_t)sizeof(p.req) && !(msg.msg_flags & MSG_CTRUNC) && fds.size() == 2) {
+			p.src_fd = fds[0];
+			p.dst_fd = fds[1];
+		} else {
+			for (int fd: fds) {
+				close(fd);
+			}
+		}
+		pending.push_back(p);
+	}
+}
+
+/*****************************************
+* Function Name : srv_valid_image
+* Description   : check a client image description before it reaches OpenCV
+******************************************/
+static bool srv_valid_image(const oca_srv_image &img) {
+	int depth = CV_MAT_DEPTH(img.type);
+	int cn = CV_MAT_CN(img.type);
+	if (img.type != (uint32_t)CV_MAKETYPE(depth, cn) || (depth != CV_8U && depth != CV_16U && depth != CV_32F) ||
+		cn > 4) {
+		return false;
+	}
+	size_t esz1 = CV_ELEM_SIZE1(img.type);
+	return img.rows > 0 && img.rows <= SRV_MAX_DIM && img.cols > 0 && img.cols <= SRV_MAX_DIM &&
+		img.step >= img.cols * CV_ELEM_SIZE(img.type) && img.step % esz1 == 0 && img.offset % esz1 == 0 &&
+		img.offset <= UINT32_MAX;
+}
+
+/*****************************************
+* Function Name : srv_valid_request
+* Description   : check op, images, interpolation and matrix of a request
+******************************************/
+static bool srv_valid_request(const oca_srv_request &req) {
+	if (req.magic != OCA_SRV_MAGIC || req.op >= OCA_SRV_OP_NUM || req.src.type != req.dst.type ||
+		!srv_valid_image(req.src) || !srv_valid_image(req.dst)) {
+		return false;
+	}
+	if (req.op == OCA_SRV_OP_RESIZE) {
+		return req.interpolation <= cv::INTER_LANCZOS4;
+	}
+	for (double v: req.m) {
+		if (!std::isfinite(v)) {
+			return false;
+		}
+	}
+	return (req.interpolation & ~(uint32_t)cv::WARP_INVERSE_MAP) <= cv::INTER_LANCZOS4 &&
+		(req.interpolation & ~(uint32_t)cv::WARP_INVERSE_MAP) != cv::INTER_AREA;
+}
+
+/*****************************************
+* Function Name : srv_map
+* Description   : map the image described by img inside fd, checking it fits
+* Return value  : mapping base or nullptr
+******************************************/
+static uint8_t *srv_map(int fd, const oca_srv_image &img, int prot, size_t &len) {
+	struct stat st;
+	len = (size_t)(img.offset + (uint64_t)img.rows * img.step);
+	if (fd < 0 || fstat(fd, &st) < 0 || st.st_size < 0 || (uint64_t)st.st_size < len) {
+		return nullptr;
+	}
+	void *p = mmap(nullptr, len, prot, MAP_SHARED, fd, 0);
+	return p == MAP_FAILED ? nullptr : static_cast<uint8_t *>(p);
+}
+
+/*****************************************
+* Function Name : srv_execute
+* Description   : run one request straight from the client's src buffer into its dst buffer.
+*                 Malformed requests are rejected before OpenCV sees them, and an OpenCV exception fails
+*                 only this request, so one client cannot take the server down.
+* Return value  : 0 or negative errno
+******************************************/
+static int srv_execute(const srv_pending &p) {
+	const oca_srv_request &req = p.req;
+	size_t src_len, dst_len;
+	int ret = 0;
+	if (!srv_valid_request(req)) {
+		return -EINVAL;
+	}
+	uint8_t *src = srv_map(p.src_fd, req.src, PROT_READ, src_len);
+	uint8_t *dst = srv_map(p.dst_fd, req.dst, PROT_READ | PROT_WRITE, dst_len);
+	if (!src || !dst) {
+		ret = -EINVAL;
+	} else {
+		try {
+			cv::Mat src_image((int)req.src.rows, (int)req.src.cols, (int)req.src.type, src + req.src.offset,
+							  req.src.step);
+			cv::Mat dst_image((int)req.dst.rows, (int)req.dst.cols, (int)req.dst.type, dst + req.dst.offset,
+							  req.dst.step);
+			OCA_SIM_BEGIN();
+			if (req.op == OCA_SRV_OP_RESIZE) {
+				cv::resize(src_image, dst_image, dst_image.size(), 0, 0, (int)req.interpolation);
+			} else {
+				cv::Mat m(2, 3, CV_64FC1, const_cast<double *>(req.m));
+				cv::warpAffine(src_image, dst_image, m, dst_image.size(), (int)req.interpolation);
+			}
+			OCA_SIM_CHARGE(srv_op_drp[req.op], src_image.total() * src_image.elemSize(),
+						   dst_image.total() * dst_image.elemSize(), 1);
+			OCA_SIM_END();
+		} catch (const cv::Exception &e) {
+			fprintf(stderr, "[SERVER] request %u rejected: %s\n", req.id, e.what());
+			ret = -EINVAL;
+		}
+	}
+	if (src) {
+		munmap(src, src_len);
+	}
+	if (dst) {
+		munmap(dst, dst_len);
+	}
+	return ret;
+}
+
+/*****************************************
+* Function Name : srv_activate
+* Description   : switch the enabled circuit, touching only the two circuits involved
+******************************************/
+static void srv_activate(unsigned long *OCA_f, int active, int next) {
+	if (active >= 0) {
+		OCA_f[active] = OPENCVA_FUNC_DISABLE;
+	}
+	OCA_f[next] = OPENCVA_FUNC_ENABLE;
+	oca_activate(OCA_f);
+}
+
+/*****************************************
+* Function Name : srv_usage
+* Description   : print command line help
+******************************************/
+static void srv_usage(const char *prog) {
+	printf("usage: %s [--socket PATH] [--window-us N] [--cpu]\n", prog);
+	printf("  --socket PATH   listen path (default %s)\n", OCA_SRV_SOCKET);
+	printf("  --window-us N   wait up to N usec for more requests before a batch (default %d)\n", SRV_BATCH_WINDOW_US);
+	printf("  --cpu           never enable circuits\n");
+}
+
+/* main */
+int32_t main(int32_t argc, char *argv[]) {
+	const char *path = OCA_SRV_SOCKET;
+	int window_us = SRV_BATCH_WINDOW_US;
+#if OCA_SIM
+	bool accel = true;
+#else
+	bool accel = OCA_Activate != nullptr && access(OCA_DRP_DEVICE, R_OK | W_OK) == 0;
+#endif
+	unsigned long OCA_f[DRP_FUNC_NUM];
+	int active = -1;
+	uint64_t requests = 0, batches = 0, reconfig = 0, naive_reconfig = 0;
+	int last_naive = -1;
+
+	for (int i = 1; i < argc; i++) {
+		if (strcmp(argv[i], "--socket") == 0 && i + 1 < argc) {
+			path = argv[++i];
+		} else if (strcmp(argv[i], "--window-us") == 0 && i + 1 < argc) {
+			window_us = atoi(argv[++i]);
+		} else if (strcmp(argv[i], "--cpu") == 0) {
+			accel = false;
+		} else {
+			srv_usage(argv[0]);
+			return -1;
+		}
+	}
+	for (unsigned long &f: OCA_f) {
+		f = OPENCVA_FUNC_NOCHANGE;
+	}
+	if (accel) {
+		/* Start from a known state: every circuit this server arbitrates is off */
+		for (int drp: srv_op_drp) {
+			OCA_f[drp] = OPENCVA_FUNC_DISABLE;
+		}
+		oca_activate(OCA_f);
+	}
+
+	int lsock = socket(AF_UNIX, SOCK_SEQPACKET | SOCK_CLOEXEC, 0);
+	struct sockaddr_un addr = {};
+	addr.sun_family = AF_UNIX;
+	strncpy(addr.sun_path, path, sizeof(addr.sun_path) - 1);
+	unlink(path);
+	if (lsock < 0 || bind(lsock, reinterpret_cast<struct sockaddr *>(&addr), sizeof(addr)) < 0 ||
+		listen(lsock, SRV_MAX_CLIENTS) < 0) {
+		std::cerr << "Error: Cannot listen on " << path << ": " << strerror(errno) << std::endl;
+		return -1;
+	}
+	signal(SIGINT, srv_on_signal);
+	signal(SIGTERM, srv_on_signal);
+	signal(SIGPIPE, SIG_IGN);
+	printf("[SERVER] listening on %s, %s path\n", path, accel ? "OCA" : "CPU");
+
+	std::vector<struct pollfd> fds(1, {lsock, POLLIN, 0});
+	std::vector<srv_pending> pending;
+	while (!srv_stop) {
+		/* Sleep until the next request, or until the oldest pending one leaves the batch window */
+		uint64_t wait_ns = 1000000000ull;
+		if (!pending.empty()) {
+			uint64_t age = srv_now_ns() - pending.front().recv_ns;
+			wait_ns = age < (uint64_t)window_us * 1000ull ? (uint64_t)window_us * 1000ull - age : 0;
+		}
+		struct timespec ts = {(time_t)(wait_ns / 1000000000ull), (long)(wait_ns % 1000000000ull)};
+		if (ppoll(fds.data(), fds.size(), &ts, nullptr) < 0 && errno != EINTR) {
+			break;
+		}
+		if (fds[0].revents & POLLIN) {
+			int c = accept4(lsock, nullptr, nullptr, SOCK_CLOEXEC);
+			if (c >= 0 && fds.size() <= SRV_MAX_CLIENTS) {
+				fds.push_back({c, POLLIN, 0});
+			} else if (c >= 0) {
+				close(c);
+			}
+		}
+		for (size_t i = 1; i < fds.size(); i++) {
+			if ((fds[i].revents & (POLLIN | POLLHUP | POLLERR)) && srv_recv(fds[i].fd, pending) < 0) {
+				/* Drop the requests of a disconnected client before its fd number can be reused */
+				int c = fds[i].fd;
+				pending.erase(std::remove_if(pending.begin(), pending.end(), [c](const srv_pending &p) {
+					if (p.client != c) {
+						return false;
+					}
+					if (p.src_fd >= 0) {
+						close(p.src_fd);
+					}
+					if (p.dst_fd >= 0) {
+						close(p.dst_fd);
+					}
+					return true;
+				}), pending.end());
+				close(c);
+				fds[i].fd = -1;
+			}
+		}
+		fds.erase(std::remove_if(fds.begin() + 1, fds.end(), [](const struct pollfd &p) { return p.fd < 0; }), fds.end());
+
+		/* Batch window: keep collecting while the oldest request is younger than the window */
+		if (pending.empty() || srv_now_ns() - pending.front().recv_ns < (uint64_t)window_us * 1000ull) {
+			continue;
+		}
+
+		/* Reorder: the currently enabled circuit first, then grouped by circuit, FIFO inside a group */
+		for (const srv_pending &p: pending) {
+			int drp = p.req.op < OCA_SRV_OP_NUM ? srv_op_drp[p.req.op] : -1;
+			if (drp != last_naive) {
+				naive_reconfig++;
+				last_naive = drp;
+			}
+		}
+		std::stable_sort(pending.begin(), pending.end(), [&](const srv_pending &a, const srv_pending &b) {
+			int da = a.req.op < OCA_SRV_OP_NUM ? srv_op_drp[a.req.op] : -1;
+			int db = b.req.op < OCA_SRV_OP_NUM ? srv_op_drp[b.req.op] : -1;
+			return (da != active) != (db != active) ? da == active : da < db;
+		});
+
+		std::vector<int> dropped;
+		for (const srv_pending &p: pending) {
+			if (std::find(dropped.begin(), dropped.end(), p.client) != dropped.end()) {
+				if (p.src_fd >= 0) {
+					close(p.src_fd);
+				}
+				if (p.dst_fd >= 0) {
+					close(p.dst_fd);
+				}
+				continue;
+			}
+			oca_srv_reply reply = {};
+			int drp = p.req.op < OCA_SRV_OP_NUM ? srv_op_drp[p.req.op] : -1;
+			if (accel && drp >= 0 && drp != active) {
+				srv_activate(OCA_f, active, drp);
+				active = drp;
+				reconfig++;
+			}
+			uint64_t start = srv_now_ns();
+			reply.status = srv_execute(p);
+			uint64_t end = srv_now_ns();
+			reply.magic = OCA_SRV_MAGIC;
+			reply.id = p.req.id;
+			reply.accelerated = accel && drp >= 0 ? 1 : 0;
+			reply.queue_ms = (double)(start - p.recv_ns) / 1E6;
+			reply.exec_ms = (double)(end - start) / 1E6;
+			/* Never block the loop on one client: drop a client whose socket buffer is full */
+			ssize_t sent = send(p.client, &reply, sizeof(reply), MSG_NOSIGNAL | MSG_DONTWAIT);
+			if (sent != (ssize_t)sizeof(reply)) {
+				printf("[SERVER] dropping client %d: %s\n", p.client, sent < 0 ? strerror(errno) : "short write");
+				dropped.push_back(p.client);
+			}
+			if (p.src_fd >= 0) {
+				close(p.src_fd);
+			}
+			if (p.dst_fd >= 0) {
+				close(p.dst_fd);
+			}
+			requests++;
+		}
+		batches++;
+		pending.clear();
+		for (int c: dropped) {
+			close(c);
+			for (size_t i = 1; i < fds.size(); i++) {
+				if (fds[i].fd == c) {
+					fds[i].fd = -1;
+				}
+			}
+		}
+		fds.erase(std::remove_if(fds.begin() + 1, fds.end(), [](const struct pollfd &p) { return p.fd < 0; }), fds.end());
+	}
+
+	printf("[SERVER] requests %llu, batches %llu, circuit switches %llu (%llu in arrival order)\n",
+		   (unsigned long long)requests, (unsigned long long)batches, (unsigned long long)reconfig,
+		   (unsigned long long)(accel ? naive_reconfig : 0));
+	for (size_t i = 1; i < fds.size(); i++) {
+		close(fds[i].fd);
+	}
+	close(lsock);
+	unlink(path);
+	return 0;
+}
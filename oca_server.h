@@ -0,0 +1,91 @@
+/***********************************************************************************************************************
+* Copyright (C) 2024 Renesas Electronics Corporation. All rights reserved.
+***********************************************************************************************************************/
+/***********************************************************************************************************************
+* File Name    : oca_server.h
+* Version      : 1.00
+* Description  : Accelerator-arbitration server protocol and client API (Unix domain socket + memfd payloads)
+***********************************************************************************************************************/
+
+#ifndef OCA_SERVER_H
+#define OCA_SERVER_H
+
+/*****************************************
+* Includes
+******************************************/
+#include <stdint.h>
+#include <stddef.h>
+#include <opencv2/opencv.hpp>
+
+/*****************************************
+* Macros
+******************************************/
+#define OCA_SRV_SOCKET          "/tmp/oca_server.sock"
+#define OCA_SRV_MAGIC           (0x4f434153)    /* "OCAS" */
+
+/* Operations */
+#define OCA_SRV_OP_RESIZE       (0)
+#define OCA_SRV_OP_WARP_AFFINE  (1)
+#define OCA_SRV_OP_NUM          (2)
+
+/*****************************************
+* Typedefs
+******************************************/
+/* Image inside a shared buffer */
+struct oca_srv_image {
+	uint32_t rows;
+	uint32_t cols;
+	uint32_t type;                      /* CV_8UC3 etc. */
+	uint32_t step;                      /* bytes per row */
+	uint64_t offset;                    /* byte offset inside the buffer */
+};
+
+/* Request, sent with two SCM_RIGHTS fds: src buffer, dst buffer */
+struct oca_srv_request {
+	uint32_t magic;
+	uint32_t id;
+	uint32_t op;                        /* OCA_SRV_OP_* */
+	uint32_t interpolation;
+	oca_srv_image src;
+	oca_srv_image dst;
+	double m[6];                        /* warpAffine 2x3 matrix */
+};
+
+/* Reply, the result is already in the dst buffer */
+struct oca_srv_reply {
+	uint32_t magic;
+	uint32_t id;
+	int32_t status;                     /* 0 or negative errno */
+	uint32_t accelerated;               /* 1 if executed with the circuit enabled */
+	double queue_ms;                    /* receive -> start of execution */
+	double exec_ms;
+};
+
+/* memfd-backed buffer shared with the server */
+struct oca_shm_buffer {
+	int fd = -1;
+	uint8_t *ptr = nullptr;
+	size_t size = 0;
+};
+
+/* Client connection */
+struct oca_client {
+	int sock = -1;
+	uint32_t next_id = 1;
+};
+
+/*****************************************
+* Functions
+******************************************/
+int oca_shm_alloc(oca_shm_buffer &buf, size_t size);
+void oca_shm_free(oca_shm_buffer &buf);
+cv::Mat oca_shm_mat(const oca_shm_buffer &buf, const oca_srv_image &img);
+oca_srv_image oca_srv_image_desc(int rows, int cols, int type, uint64_t offset);
+
+int oca_client_connect(oca_client &client, const char *path);
+void oca_client_close(oca_client &client);
+int oca_client_submit(oca_client &client, oca_srv_request &req, const oca_shm_buffer &src, const oca_shm_buffer &dst);
+int oca_client_wait(oca_client &client, oca_srv_reply &reply);
+int oca_client_benchmark(const cv::Mat &image);
+
+#endif
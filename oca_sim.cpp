@@ -0,0 +1,153 @@
+/***********************************************************************************************************************
+* Copyright (C) 2024 Renesas Electronics Corporation. All rights reserved.
+***********************************************************************************************************************/
+/***********************************************************************************************************************
+* File Name    : oca_sim.cpp
+* Version      : 1.00
+* Description  : Simulated OCA backend (built with -DOCA_SIM=ON). Tracks circuit state like OCA_Activate and pads
+*                each timed OCA region to the latency model of the loaded profile.
+***********************************************************************************************************************/
+
+/*****************************************
+* Includes
+******************************************/
+#include "define.h"
+#include "oca_sim.h"
+#include <atomic>
+#include <mutex>
+
+/*****************************************
+* Macros
+******************************************/
+#define SIM_SPIN_NS             (200000)    /* spin the last 200usec instead of sleeping */
+
+/*****************************************
+* Global Variables
+******************************************/
+static std::once_flag sim_once;
+static oca_sim_profile sim_profile;
+static std::atomic<int> sim_enabled[DRP_FUNC_NUM];
+static std::atomic<unsigned long> sim_overruns;
+static thread_local uint64_t sim_begin_ns;
+static thread_local double sim_charge_us;
+
+/*****************************************
+* Function Name : sim_now_ns
+* Description   : CLOCK_MONOTONIC in ns
+******************************************/
+static uint64_t sim_now_ns() {
+	struct timespec ts;
+	clock_gettime(CLOCK_MONOTONIC, &ts);
+	return (uint64_t)ts.tv_sec * 1000000000ull + ts.tv_nsec;
+}
+
+/*****************************************
+* Function Name : sim_wait_until
+* Description   : sleep until target, spinning the tail for sub-scheduler-tick accuracy
+******************************************/
+static void sim_wait_until(uint64_t target_ns) {
+	uint64_t now = sim_now_ns();
+	if (target_ns > now + SIM_SPIN_NS) {
+		uint64_t wake = target_ns - SIM_SPIN_NS;
+		struct timespec ts = {(time_t)(wake / 1000000000ull), (long)(wake % 1000000000ull)};
+		clock_nanosleep(CLOCK_MONOTONIC, TIMER_ABSTIME, &ts, nullptr);
+	}
+	while (sim_now_ns() < target_ns) {
+	}
+}
+
+/*****************************************
+* Function Name : sim_report
+* Description   : atexit summary of regions where the CPU op was slower than the model
+******************************************/
+static void sim_report() {
+	if (sim_overruns.load() > 0) {
+		fprintf(stderr, "[SIM] %lu OCA regions ran longer on the CPU than the model; their timings are not simulated\n",
+				sim_overruns.load());
+	}
+}
+
+/*****************************************
+* Function Name : sim_init
+* Description   : load $OCA_SIM_PROFILE (or OCA_SIM_PROFILE_FILE) once
+******************************************/
+static void sim_init() {
+	const char *path = getenv("OCA_SIM_PROFILE");
+	if (!path) {
+		path = OCA_SIM_PROFILE_FILE;
+	}
+	if (oca_sim_load_profile(path, sim_profile) < 0) {
+		fprintf(stderr, "[SIM] no profile %s, OCA path runs at CPU speed\n", path);
+	} else {
+		fprintf(stderr, "[SIM] profile %s\n", path);
+	}
+	atexit(sim_report);
+}
+
+/*****************************************
+* Function Name : OCA_Activate
+* Description   : simulated circuit switch. Same list semantics as the DRP-patched OpenCV:
+*                 OPENCVA_FUNC_DISABLE / ENABLE / NOCHANGE per circuit.
+* Arguments     : OCA_list = DRP_FUNC_NUM entries
+* Return value  : 0
+******************************************/
+int OCA_Activate(unsigned long *OCA_list) {
+	bool loaded = false;
+	std::call_once(sim_once, sim_init);
+	uint64_t start = sim_now_ns();
+	for (int i = 0; i < DRP_FUNC_NUM; i++) {
+		if (OCA_list[i] == OPENCVA_FUNC_ENABLE) {
+			loaded |= sim_enabled[i].exchange(1) == 0;
+		} else if (OCA_list[i] == OPENCVA_FUNC_DISABLE) {
+			sim_enabled[i] = 0;
+		}
+	}
+	if (loaded) {
+		sim_wait_until(start + (uint64_t)(sim_profile.activate_us * 1E3));
+	}
+	return 0;
+}
+
+/*****************************************
+* Function Name : oca_sim_begin
+* Description   : start of a timed region
+******************************************/
+void oca_sim_begin() {
+	sim_begin_ns = sim_now_ns();
+	sim_charge_us = 0;
+}
+
+/*****************************************
+* Function Name : oca_sim_charge
+* Description   : add the modeled latency of one circuit, if it is enabled
+* Arguments     : drp = circuit number
+*                 in_bytes, out_bytes = data moved per iteration
+*                 iterations = passes over the data
+******************************************/
+void oca_sim_charge(int drp, size_t in_bytes, size_t out_bytes, int iterations) {
+	std::call_once(sim_once, sim_init);
+	if (drp < 0 || drp >= DRP_FUNC_NUM || !sim_enabled[drp]) {
+		return;
+	}
+	const oca_sim_model &m = sim_profile.op[drp];
+	sim_charge_us += m.fixed_us;
+	if (m.mb_per_s > 0) {
+		sim_charge_us += (double)iterations * (double)(in_bytes + out_bytes) / m.mb_per_s;
+	}
+}
+
+/*****************************************
+* Function Name : oca_sim_end
+* Description   : pad the region to the charged latency. CPU regions charge nothing and pass through.
+******************************************/
+void oca_sim_end() {
+	if (sim_charge_us <= 0) {
+		return;
+	}
+	uint64_t target = sim_begin_ns + (uint64_t)(sim_charge_us * 1E3);
+	if (sim_now_ns() > target) {
+		sim_overruns++;
+		return;
+	}
+	sim_wait_until(target);
+}
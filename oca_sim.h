@@ -0,0 +1,65 @@
+/***********************************************************************************************************************
+* Copyright (C) 2024 Renesas Electronics Corporation. All rights reserved.
+***********************************************************************************************************************/
+/***********************************************************************************************************************
+* File Name    : oca_sim.h
+* Version      : 1.00
+* Description  : Simulated OCA backend for off-target builds. OCA_Activate is implemented in oca_sim.cpp, ops run on
+*                the CPU and the timed region is padded to a latency model recorded on the board.
+***********************************************************************************************************************/
+
+#ifndef OCA_SIM_H
+#define OCA_SIM_H
+
+/*****************************************
+* Includes
+******************************************/
+#include <stddef.h>
+#include "define.h"
+#include <opencv2/opencv.hpp>
+
+/*****************************************
+* Macros
+******************************************/
+#define OCA_SIM_PROFILE_FILE    "oca_sim_profile.txt"   /* default profile, overridden by $OCA_SIM_PROFILE */
+
+/*****************************************
+* Typedefs
+******************************************/
+/* Per-circuit latency model: fixed_us + iterations * (in_bytes + out_bytes) / (mb_per_s [bytes/usec]) */
+struct oca_sim_model {
+	double fixed_us;
+	double mb_per_s;                    /* 0 = no bandwidth term */
+};
+
+/* Board profile */
+struct oca_sim_profile {
+	double activate_us;                 /* cost of an OCA_Activate call that enables a circuit */
+	oca_sim_model op[DRP_FUNC_NUM];
+};
+
+/*****************************************
+* Functions
+******************************************/
+int oca_sim_load_profile(const char *path, oca_sim_profile &profile);
+int oca_sim_save_profile(const char *path, const oca_sim_profile &profile);
+int oca_sim_record(const cv::Mat &image, unsigned long *OCA_f, const char *path);
+
+#if OCA_SIM
+/* Stock OpenCV does not declare it; the simulator defines it */
+int OCA_Activate(unsigned long *OCA_list);
+void oca_sim_begin();
+void oca_sim_charge(int drp, size_t in_bytes, size_t out_bytes, int iterations);
+void oca_sim_end();
+
+/* Mark the timed OCA region: BEGIN after the start timestamp, CHARGE per circuit used, END before the stop timestamp */
+#define OCA_SIM_BEGIN()                                 oca_sim_begin()
+#define OCA_SIM_CHARGE(drp, in_bytes, out_bytes, iter)  oca_sim_charge((drp), (in_bytes), (out_bytes), (iter))
+#define OCA_SIM_END()                                   oca_sim_end()
+#else
+#define OCA_SIM_BEGIN()
+#define OCA_SIM_CHARGE(drp, in_bytes, out_bytes, iter)
+#define OCA_SIM_END()
+#endif
+
+#endif
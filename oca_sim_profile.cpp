@@ -0,0 +1,167 @@
+/***********************************************************************************************************************
+* Copyright (C) 2024 Renesas Electronics Corporation. All rights reserved.
+***********************************************************************************************************************/
+/***********************************************************************************************************************
+* File Name    : oca_sim_profile.cpp
+* Version      : 1.00
+* Description  : Latency profile for the simulated OCA backend: load/save and recording on the board
+***********************************************************************************************************************/
+
+/*****************************************
+* Includes
+******************************************/
+#include "define.h"
+#include "oca_op_table.h"
+#include "oca_sim.h"
+#include <algorithm>
+#include <functional>
+#include <sstream>
+
+/*****************************************
+* Macros
+******************************************/
+#define RECORD_REPEAT           (5)
+
+/*****************************************
+* Function Name : oca_sim_load_profile
+* Description   : read a profile. Format, one entry per line, '#' starts a comment:
+*                   activate <usec>
+*                   <drp id> <fixed usec> <MB/s>
+* Arguments     : path = profile file
+*                 profile = output, circuits without a line keep a zero model
+* Return value  : 0 on success, -1 if the file cannot be read
+******************************************/
+int oca_sim_load_profile(const char *path, oca_sim_profile &profile) {
+	std::ifstream file(path);
+	std::string line;
+	profile = oca_sim_profile();
+	if (!file.is_open()) {
+		return -1;
+	}
+	while (std::getline(file, line)) {
+		std::istringstream in(line.substr(0, line.find('#')));
+		std::string key;
+		if (!(in >> key)) {
+			continue;
+		}
+		if (key == "activate") {
+			in >> profile.activate_us;
+			continue;
+		}
+		int drp = atoi(key.c_str());
+		if (drp >= 0 && drp < DRP_FUNC_NUM) {
+			in >> profile.op[drp].fixed_us >> profile.op[drp].mb_per_s;
+		}
+	}
+	return 0;
+}
+
+/*****************************************
+* Function Name : oca_sim_save_profile
+* Description   : write a profile in the format read by oca_sim_load_profile
+* Return value  : 0 on success, -1 on error
+******************************************/
+int oca_sim_save_profile(const char *path, const oca_sim_profile &profile) {
+	std::ofstream file(path);
+	if (!file.is_open()) {
+		return -1;
+	}
+	file << "# OCA simulator profile\n";
+	file << "# <drp id> <fixed usec> <MB/s>, latency = fixed + iterations * (in + out bytes) / MB/s\n";
+	file << std::fixed << std::setprecision(3);
+	file << "activate " << profile.activate_us << "\n";
+	for (int i = 0; i < DRP_FUNC_NUM; i++) {
+		if (profile.op[i].fixed_us > 0 || profile.op[i].mb_per_s > 0) {
+			file << i << " " << profile.op[i].fixed_us << " " << profile.op[i].mb_per_s << "\n";
+		}
+	}
+	return file.good() ? 0 : -1;
+}
+
+/*****************************************
+* Function Name : record_median_us
+* Description   : median latency of fn over RECORD_REPEAT runs
+******************************************/
+static double record_median_us(const std::function<void()> &fn) {
+	double t[RECORD_REPEAT];
+	struct timespec t0, t1;
+	for (double &v: t) {
+		timespec_get(&t0, TIME_UTC);
+		fn();
+		timespec_get(&t1, TIME_UTC);
+		v = timedifference_msec(t0, t1) * 1E3;
+	}
+	std::sort(t, t + RECORD_REPEAT);
+	return t[RECORD_REPEAT / 2];
+}
+
+/*****************************************
+* Function Name : oca_sim_record
+* Description   : measure every circuit with OCA enabled at two frame sizes and fit
+*                 fixed overhead + bandwidth. Run on the board, copy the file to the build server.
+* Arguments     : image = FHD BGR frame
+*                 OCA_f = OCA_Activate function list
+*                 path = output profile
+* Return value  : 0 on success, -1 on error
+******************************************/
+int oca_sim_record(const cv::Mat &image, unsigned long *OCA_f, const char *path) {
+	const cv::Size sizes[2] = {image.size(), cv::Size(image.cols / 2, image.rows / 2)};
+	oca_sim_profile profile;
+	struct timespec t0, t1;
+
+	printf("[SIM] recording OCA profile\n");
+	for (int c = 0; c < OCA_CASE_NUM; c++) {
+		const oca_op_desc &op = oca_op_table[c];
+		double t_us[2];
+		size_t bytes[2];
+		if (!oca_case_single_circuit(c)) {
+			continue;
+		}
+		for (int s = 0; s < 2; s++) {
+			cv::Mat bgr;
+			oca_case_data d;
+			cv::resize(image, bgr, sizes[s]);
+			std::function<void()> run = oca_case_setups[c](bgr, d, 1);
+
+			/* Circuit load is measured separately below; warm up once so it is not in the samples */
+			oca_op_activate(OCA_f, op, OPENCVA_FUNC_ENABLE);
+			run();
+			t_us[s] = record_median_us(run);
+			bytes[s] = d.in + d.out;
+			oca_op_activate(OCA_f, op, OPENCVA_FUNC_DISABLE);
+		}
+
+		/* Two-point fit: t = fixed + bytes / bandwidth */
+		oca_sim_model &m = profile.op[op.drp[0]];
+		double slope = (t_us[0] - t_us[1]) / ((double)bytes[0] - (double)bytes[1]);
+		if (slope > 0) {
+			m.mb_per_s = 1.0 / slope;
+			m.fixed_us = std::max(0.0, t_us[1] - slope * (double)bytes[1]);
+		} else {
+			m.mb_per_s = 0;
+			m.fixed_us = std::min(t_us[0], t_us[1]);
+		}
+		printf("[SIM] circuit %2d  %10.1fusec @%zuB  %10.1fusec @%zuB  fixed %8.1fusec  %8.1fMB/s\n", op.drp[0],
+			   t_us[0], bytes[0], t_us[1], bytes[1], m.fixed_us, m.mb_per_s);
+	}
+
+	/* Circuit load cost: enable from a disabled state */
+	double activate_ms = 0;
+	for (int i = 0; i < RECORD_REPEAT; i++) {
+		oca_case_set<OCA_CASE_RESIZE>(OCA_f, OPENCVA_FUNC_ENABLE);
+		timespec_get(&t0, TIME_UTC);
+		oca_activate(OCA_f);
+		timespec_get(&t1, TIME_UTC);
+		activate_ms += timedifference_msec(t0, t1);
+		oca_case_activate<OCA_CASE_RESIZE>(OCA_f, OPENCVA_FUNC_DISABLE);
+	}
+	profile.activate_us = activate_ms * 1E3 / RECORD_REPEAT;
+	printf("[SIM] activate %.1fusec\n", profile.activate_us);
+
+	if (oca_sim_save_profile(path, profile) < 0) {
+		std::cerr << "Error: Cannot write " << path << std::endl;
+		return -1;
+	}
+	printf("[SIM] wrote %s\n\n", path);
+	return 0;
+}
@@ -0,0 +1,142 @@
+/***********************************************************************************************************************
+* Copyright (C) 2024 Renesas Electronics Corporation. All rights reserved.
+***********************************************************************************************************************/
+/***********************************************************************************************************************
+* File Name    : oca_stable.cpp
+* Version      : 1.00
+* Description  : Measurement conditions: monotonic raw clock, CPU pinning, SCHED_FIFO and cpufreq / thermal state
+***********************************************************************************************************************/
+
+/*****************************************
+* Includes
+******************************************/
+#include "define.h"
+#include "oca_stable.h"
+#include <sched.h>
+
+/*****************************************
+* Global Variables
+******************************************/
+static int stable_cpu = -1;             /* pinned CPU, -1 = not pinned (cpufreq of cpu0 is sampled) */
+static char stable_freq_dir[96] = "/sys/devices/system/cpu/cpu0/cpufreq";
+
+/*****************************************
+* Function Name : oca_stable_now_ns
+* Description   : CLOCK_MONOTONIC_RAW in ns: not slewed by NTP, unlike TIME_UTC
+******************************************/
+uint64_t oca_stable_now_ns() {
+	struct timespec ts;
+	clock_gettime(CLOCK_MONOTONIC_RAW, &ts);
+	return (uint64_t)ts.tv_sec * 1000000000ull + (uint64_t)ts.tv_nsec;
+}
+
+/*****************************************
+* Function Name : oca_stable_pin
+* Description   : pin the calling thread to one CPU and sample that CPU's cpufreq policy.
+*                 Call after the OpenCV thread pool exists, threads created later inherit the mask.
+* Return value  : 0 on success, negative errno on failure
+******************************************/
+int oca_stable_pin(int cpu) {
+	cpu_set_t set;
+	CPU_ZERO(&set);
+	CPU_SET(cpu, &set);
+	if (sched_setaffinity(0, sizeof(set), &set) < 0) {
+		return -errno;
+	}
+	stable_cpu = cpu;
+	snprintf(stable_freq_dir, sizeof(stable_freq_dir), "/sys/devices/system/cpu/cpu%d/cpufreq", cpu);
+	return 0;
+}
+
+/*****************************************
+* Function Name : oca_stable_fifo
+* Description   : run the calling thread as SCHED_FIFO (needs root or CAP_SYS_NICE)
+* Return value  : 0 on success, negative errno on failure
+******************************************/
+int oca_stable_fifo(int priority) {
+	struct sched_param param = {};
+	param.sched_priority = priority;
+	if (sched_setscheduler(0, SCHED_FIFO, &param) < 0) {
+		return -errno;
+	}
+	return 0;
+}
+
+/*****************************************
+* Function Name : oca_stable_cpu
+* Description   : pinned CPU, -1 if not pinned
+******************************************/
+int oca_stable_cpu() {
+	return stable_cpu;
+}
+
+/*****************************************
+* Function Name : oca_stable_sched
+* Description   : scheduling policy of the calling thread, for the report
+******************************************/
+std::string oca_stable_sched() {
+	int policy = sched_getscheduler(0);
+	struct sched_param param = {};
+	sched_getparam(0, &param);
+	if (policy == SCHED_FIFO) {
+		return "SCHED_FIFO " + std::to_string(param.sched_priority);
+	}
+	if (policy == SCHED_RR) {
+		return "SCHED_RR " + std::to_string(param.sched_priority);
+	}
+	return "SCHED_OTHER";
+}
+
+/*****************************************
+* Function Name : read_long
+* Description   : integer sysfs attribute, -1 if unreadable
+******************************************/
+static long read_long(const char *path) {
+	FILE *f = fopen(path, "r");
+	long v = -1;
+	if (f) {
+		if (fscanf(f, "%ld", &v) != 1) {
+			v = -1;
+		}
+		fclose(f);
+	}
+	return v;
+}
+
+/*****************************************
+* Function Name : oca_stable_snapshot
+* Description   : read the cpufreq and thermal state of the measured CPU
+******************************************/
+void oca_stable_snapshot(oca_stable_state &state) {
+	char path[160];
+	snprintf(path, sizeof(path), "%s/scaling_cur_freq", stable_freq_dir);
+	state.cur_khz = read_long(path);
+	snprintf(path, sizeof(path), "%s/scaling_max_freq", stable_freq_dir);
+	state.max_khz = read_long(path);
+	snprintf(path, sizeof(path), "%s/stats/total_trans", stable_freq_dir);
+	state.transitions = read_long(path);
+
+	state.cooling = -1;
+	for (int i = 0; i < OCA_STABLE_MAX_ZONES; i++) {
+		snprintf(path, sizeof(path), "/sys/class/thermal/cooling_device%d/cur_state", i);
+		long v = read_long(path);
+		if (v >= 0) {
+			state.cooling = (state.cooling < 0 ? 0 : state.cooling) + v;
+		}
+	}
+	state.temp_mc = -1;
+	for (int i = 0; i < OCA_STABLE_MAX_ZONES; i++) {
+		snprintf(path, sizeof(path), "/sys/class/thermal/thermal_zone%d/temp", i);
+		state.temp_mc = std::max(state.temp_mc, read_long(path));
+	}
+}
+
+/*****************************************
+* Function Name : oca_stable_changed
+* Description   : true if a sample taken between the two snapshots may be distorted: the frequency
+*                 changed, the governor made a transition, or thermal throttling started / ended
+******************************************/
+bool oca_stable_changed(const oca_stable_state &before, const oca_stable_state &after) {
+	return before.cur_khz != after.cur_khz || before.max_khz != after.max_khz ||
+		   before.transitions != after.transitions || before.cooling != after.cooling;
+}
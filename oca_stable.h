@@ -0,0 +1,48 @@
+/***********************************************************************************************************************
+* Copyright (C) 2024 Renesas Electronics Corporation. All rights reserved.
+***********************************************************************************************************************/
+/***********************************************************************************************************************
+* File Name    : oca_stable.h
+* Version      : 1.00
+* Description  : Measurement conditions: monotonic raw clock, CPU pinning, SCHED_FIFO and cpufreq / thermal state
+***********************************************************************************************************************/
+
+#ifndef OCA_STABLE_H
+#define OCA_STABLE_H
+
+/*****************************************
+* Includes
+******************************************/
+#include <stdint.h>
+#include <string>
+
+/*****************************************
+* Macros
+******************************************/
+#define OCA_STABLE_FIFO_PRIORITY    (80)
+#define OCA_STABLE_MAX_ZONES        (8)
+
+/*****************************************
+* Typedefs
+******************************************/
+/* cpufreq / thermal state of the measured CPU, -1 = not available */
+struct oca_stable_state {
+	long cur_khz;                       /* scaling_cur_freq */
+	long max_khz;                       /* scaling_max_freq, lowered by thermal capping */
+	long transitions;                   /* cpufreq stats total_trans */
+	long cooling;                       /* sum of the cooling device states, raised while throttling */
+	long temp_mc;                       /* hottest thermal zone, millidegree C */
+};
+
+/*****************************************
+* Functions
+******************************************/
+uint64_t oca_stable_now_ns();
+int oca_stable_pin(int cpu);
+int oca_stable_fifo(int priority);
+int oca_stable_cpu();
+std::string oca_stable_sched();
+void oca_stable_snapshot(oca_stable_state &state);
+bool oca_stable_changed(const oca_stable_state &before, const oca_stable_state &after);
+
+#endif
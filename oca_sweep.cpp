@@ -0,0 +1,437 @@
+/***********************************************************************************************************************
+* Copyright (C) 2024 Renesas Electronics Corporation. All rights reserved.
+***********************************************************************************************************************/
+/***********************************************************************************************************************
+* File Name    : oca_sweep.cpp
+* Version      : 1.00
+* Description  : Operator parameter sweep: CPU and OCA latency over the Cartesian product of per-op parameter grids
+***********************************************************************************************************************/
+
+/*****************************************
+* Includes
+******************************************/
+#include "define.h"
+#include "oca_sweep.h"
+#include "oca_op_table.h"
+#include "oca_sim.h"
+#include "oca_stable.h"
+#include <algorithm>
+#include <functional>
+#include <iostream>
+#include <sstream>
+
+/*****************************************
+* Typedefs
+******************************************/
+/* One parameter point; parameters an op does not use keep their default */
+struct sweep_point {
+	double v[OCA_SWEEP_PARAM_NUM];
+};
+
+/* Op (case: name and circuit) and its default grid. Grids list the values per parameter, empty = not swept */
+struct sweep_op {
+	int id;                             /* OCA_CASE_* */
+	std::vector<double> grid[OCA_SWEEP_PARAM_NUM];
+};
+
+/*****************************************
+* Global Variables
+******************************************/
+static const char *const sweep_param_name[OCA_SWEEP_PARAM_NUM] = {
+	"ksize", "iterations", "tsize", "interpolation", "border", "scale"
+};
+/* Used when an op does not sweep the parameter: the benchmark case values */
+static const double sweep_param_default[OCA_SWEEP_PARAM_NUM] = {
+	3, 1, 16, cv::INTER_LINEAR, cv::BORDER_DEFAULT, 0.5
+};
+
+/* Value names accepted in the spec file */
+static const std::pair<const char *, int> sweep_interp_name[] = {
+	{"nearest", cv::INTER_NEAREST}, {"linear", cv::INTER_LINEAR}, {"cubic", cv::INTER_CUBIC},
+	{"area", cv::INTER_AREA}, {"lanczos4", cv::INTER_LANCZOS4},
+};
+static const std::pair<const char *, int> sweep_border_name[] = {
+	{"constant", cv::BORDER_CONSTANT}, {"replicate", cv::BORDER_REPLICATE}, {"reflect", cv::BORDER_REFLECT},
+	{"reflect101", cv::BORDER_REFLECT_101}, {"default", cv::BORDER_DEFAULT},
+};
+
+/*****************************************
+* Function Name : sweep_defaults
+* Description   : default grids around the benchmark case parameters
+******************************************/
+static std::vector<sweep_op> sweep_defaults() {
+	std::vector<sweep_op> ops = {
+		{OCA_CASE_RESIZE, {}},
+		{OCA_CASE_GAUSSIAN, {}},
+		{OCA_CASE_DILATE, {}},
+		{OCA_CASE_ERODE, {}},
+		{OCA_CASE_FILTER2D, {}},
+		{OCA_CASE_SOBEL, {}},
+		{OCA_CASE_A_THRESHOLD, {}},
+		{OCA_CASE_TMPLEATMATCH, {}},
+		{OCA_CASE_AFFINE, {}},
+		{OCA_CASE_PERSPECTIVE, {}},
+		{OCA_CASE_PYR_DOWN, {}},
+	};
+	const std::vector<double> interp = {cv::INTER_NEAREST, cv::INTER_LINEAR, cv::INTER_CUBIC};
+	const std::vector<double> border = {cv::BORDER_CONSTANT, cv::BORDER_REPLICATE, cv::BORDER_REFLECT_101};
+	ops[0].grid[OCA_SWEEP_SCALE] = {0.25, 0.5, 0.75, 1.5};
+	ops[0].grid[OCA_SWEEP_INTERP] = {cv::INTER_NEAREST, cv::INTER_LINEAR, cv::INTER_CUBIC, cv::INTER_AREA};
+	ops[1].grid[OCA_SWEEP_KSIZE] = {3, 5, 7, 9, 11};
+	ops[1].grid[OCA_SWEEP_BORDER] = border;
+	ops[2].grid[OCA_SWEEP_ITERATIONS] = {1, 10, 50, 100, 200};
+	ops[2].grid[OCA_SWEEP_KSIZE] = {3, 5};
+	ops[3].grid[OCA_SWEEP_ITERATIONS] = {1, 10, 50, 100, 200};
+	ops[3].grid[OCA_SWEEP_KSIZE] = {3, 5};
+	ops[4].grid[OCA_SWEEP_KSIZE] = {3, 5, 7};
+	ops[4].grid[OCA_SWEEP_BORDER] = border;
+	ops[5].grid[OCA_SWEEP_KSIZE] = {1, 3, 5, 7};
+	ops[5].grid[OCA_SWEEP_BORDER] = border;
+	ops[6].grid[OCA_SWEEP_KSIZE] = {3, 11, 31, 99, 151};
+	ops[7].grid[OCA_SWEEP_TSIZE] = {8, 16, 32, 64};
+	ops[8].grid[OCA_SWEEP_INTERP] = interp;
+	ops[8].grid[OCA_SWEEP_BORDER] = border;
+	ops[9].grid[OCA_SWEEP_INTERP] = interp;
+	ops[9].grid[OCA_SWEEP_BORDER] = border;
+	ops[10].grid[OCA_SWEEP_BORDER] = border;
+	return ops;
+}
+
+/*****************************************
+* Function Name : parse_value
+* Description   : number or interpolation / border name
+* Return value  : 0 on success, -1 if unknown
+******************************************/
+static int parse_value(int param, const std::string &text, double &value) {
+	char *end = nullptr;
+	value = strtod(text.c_str(), &end);
+	if (end && *end == '\0' && !text.empty()) {
+		return 0;
+	}
+	if (param == OCA_SWEEP_INTERP) {
+		for (const auto &n: sweep_interp_name) {
+			if (text == n.first) {
+				value = n.second;
+				return 0;
+			}
+		}
+	}
+	if (param == OCA_SWEEP_BORDER) {
+		for (const auto &n: sweep_border_name) {
+			if (text == n.first) {
+				value = n.second;
+				return 0;
+			}
+		}
+	}
+	return -1;
+}
+
+/*****************************************
+* Function Name : load_spec
+* Description   : replace default grids from a spec file. One op per line, '#' starts a comment:
+*                   <op> <param>=<v1>,<v2>,... [<param>=...]
+*                 Listed ops replace their whole grid and are the only ones swept.
+* Return value  : 0 on success, -1 on error
+******************************************/
+static int load_spec(const char *path, std::vector<sweep_op> &ops) {
+	std::ifstream file(path);
+	std::string line;
+	std::vector<sweep_op> selected;
+	if (!file.is_open()) {
+		std::cerr << "Error: Cannot open " << path << std::endl;
+		return -1;
+	}
+	while (std::getline(file, line)) {
+		std::istringstream in(line.substr(0, line.find('#')));
+		std::string name, item;
+		if (!(in >> name)) {
+			continue;
+		}
+		auto it = std::find_if(ops.begin(), ops.end(), [&](const sweep_op &o) {
+			return name == oca_op_table[o.id].name;
+		});
+		if (it == ops.end()) {
+			std::cerr << "Error: " << path << ": unknown op " << name << std::endl;
+			return -1;
+		}
+		sweep_op op = {it->id, {}};
+		while (in >> item) {
+			size_t eq = item.find('=');
+			const char *const *p = std::find(sweep_param_name, sweep_param_name + OCA_SWEEP_PARAM_NUM,
+											 item.substr(0, eq == std::string::npos ? item.size() : eq));
+			if (eq == std::string::npos || p == sweep_param_name + OCA_SWEEP_PARAM_NUM) {
+				std::cerr << "Error: " << path << ": bad parameter " << item << std::endl;
+				return -1;
+			}
+			int param = (int)(p - sweep_param_name);
+			std::istringstream values(item.substr(eq + 1));
+			std::string v;
+			while (std::getline(values, v, ',')) {
+				double value;
+				if (parse_value(param, v, value) < 0) {
+					std::cerr << "Error: " << path << ": bad value " << v << " for " << *p << std::endl;
+					return -1;
+				}
+				op.grid[param].push_back(value);
+			}
+		}
+		selected.push_back(op);
+	}
+	ops = selected;
+	return 0;
+}
+
+/*****************************************
+* Function Name : oca_supported
+* Description   : parameter limits of the DRP circuits, from the OpenCV Accelerator function specification.
+*                 Outside them OpenCV runs the CPU implementation even with the circuit enabled, so the
+*                 point is timed on the CPU path only. Update with the BSP release.
+******************************************/
+static bool oca_supported(int id, const sweep_point &pt) {
+	int ksize = (int)pt.v[OCA_SWEEP_KSIZE];
+	int interp = (int)pt.v[OCA_SWEEP_INTERP];
+	int border = (int)pt.v[OCA_SWEEP_BORDER];
+	switch (id) {
+		case OCA_CASE_RESIZE:
+			return interp == cv::INTER_LINEAR || interp == cv::INTER_NEAREST;
+		case OCA_CASE_GAUSSIAN:
+			return ksize >= 3 && ksize <= 7 && border == cv::BORDER_REFLECT_101;
+		case OCA_CASE_DILATE:
+		case OCA_CASE_ERODE:
+			return ksize == 3;
+		case OCA_CASE_FILTER2D:
+			return ksize == 3 && border == cv::BORDER_REFLECT_101;
+		case OCA_CASE_SOBEL:
+			return ksize == 3 && border == cv::BORDER_REFLECT_101;
+		case OCA_CASE_A_THRESHOLD:
+			return ksize >= 3 && ksize <= 255;
+		case OCA_CASE_TMPLEATMATCH:
+			return pt.v[OCA_SWEEP_TSIZE] <= 16;
+		case OCA_CASE_AFFINE:
+		case OCA_CASE_PERSPECTIVE:
+			return interp == cv::INTER_LINEAR && border == cv::BORDER_CONSTANT;
+		case OCA_CASE_PYR_DOWN:
+		case OCA_CASE_PYR_UP:
+			return border == cv::BORDER_REFLECT_101;
+		default:
+			return false;
+	}
+}
+
+/*****************************************
+* Function Name : sweep_runner
+* Description   : build the inputs of one point and return the call to time
+* Arguments     : in, out = image bytes of one pass, passes = passes per call (simulator charge)
+******************************************/
+static std::function<void()> sweep_runner(int id, const sweep_point &pt, const cv::Mat &bgr, cv::Mat &src,
+										  cv::Mat &aux, cv::Mat &dst, size_t &in, size_t &out, int &passes) {
+	static float k_affine[6] = {0.7071, -0.7071, 649, 0.7071, 0.7071, 510};
+	static float k_persp[9] = {0.5, 0.2, 20, -0.1, 0.8, 50, -0.001, 0.001, 1.0};
+	const int ksize = (int)pt.v[OCA_SWEEP_KSIZE];
+	const int iterations = (int)pt.v[OCA_SWEEP_ITERATIONS];
+	const int tsize = (int)pt.v[OCA_SWEEP_TSIZE];
+	const int interp = (int)pt.v[OCA_SWEEP_INTERP];
+	const int border = (int)pt.v[OCA_SWEEP_BORDER];
+	const double scale = pt.v[OCA_SWEEP_SCALE];
+
+	src = bgr;
+	in = out = src.total() * src.elemSize();
+	passes = 1;
+	switch (id) {
+		case OCA_CASE_RESIZE:
+			dst.create(cvRound(bgr.rows * scale), cvRound(bgr.cols * scale), CV_8UC3);
+			out = dst.total() * dst.elemSize();
+			return [&src, &dst, interp] { cv::resize(src, dst, dst.size(), 0, 0, interp); };
+		case OCA_CASE_GAUSSIAN:
+			return [&src, &dst, ksize, border] { cv::GaussianBlur(src, dst, {ksize, ksize}, 0, 0, border); };
+		case OCA_CASE_DILATE:
+		case OCA_CASE_ERODE:
+			aux = cv::getStructuringElement(cv::MORPH_RECT, {ksize, ksize});
+			passes = iterations;
+			if (id == OCA_CASE_DILATE) {
+				return [&src, &dst, &aux, iterations] { cv::dilate(src, dst, aux, cv::Point(-1, -1), iterations); };
+			}
+			return [&src, &dst, &aux, iterations] { cv::erode(src, dst, aux, cv::Point(-1, -1), iterations); };
+		case OCA_CASE_FILTER2D:
+			/* Laplacian-like kernel: -1 around, sum 1 */
+			aux = cv::Mat(ksize, ksize, CV_32FC1, cv::Scalar(-1.0));
+			aux.at<float>(ksize / 2, ksize / 2) = (float)(ksize * ksize);
+			return [&src, &dst, &aux, border] { cv::filter2D(src, dst, -1, aux, cv::Point(-1, -1), 0, border); };
+		case OCA_CASE_SOBEL:
+			return [&src, &dst, ksize, border] { cv::Sobel(src, dst, -1, 1, 0, ksize, 1, 0, border); };
+		case OCA_CASE_A_THRESHOLD:
+			cv::cvtColor(bgr, src, cv::COLOR_BGR2GRAY);
+			in = out = src.total();
+			return [&src, &dst, ksize] {
+				cv::adaptiveThreshold(src, dst, 0xFF, cv::ADAPTIVE_THRESH_MEAN_C, cv::THRESH_BINARY, ksize, 0);
+			};
+		case OCA_CASE_TMPLEATMATCH:
+			src = bgr(cv::Rect(800, 400, 640, 360)).clone();
+			aux = bgr(cv::Rect(1200, 560, tsize, tsize)).clone();
+			in = src.total() * src.elemSize();
+			out = (size_t)(src.rows - tsize + 1) * (size_t)(src.cols - tsize + 1) * sizeof(float);
+			return [&src, &dst, &aux] { cv::matchTemplate(src, aux, dst, cv::TM_SQDIFF); };
+		case OCA_CASE_AFFINE:
+			aux = cv::Mat(2, 3, CV_32FC1, k_affine);
+			return [&src, &dst, &aux, interp, border] { cv::warpAffine(src, dst, aux, src.size(), interp, border); };
+		case OCA_CASE_PERSPECTIVE:
+			aux = cv::Mat(3, 3, CV_32FC1, k_persp);
+			return [&src, &dst, &aux, interp, border] {
+				cv::warpPerspective(src, dst, aux, src.size(), interp, border);
+			};
+		default:
+			out = in / 4;
+			return [&src, &dst, border] { cv::pyrDown(src, dst, cv::Size(), border); };
+	}
+}
+
+/*****************************************
+* Function Name : time_point
+* Description   : median latency of samples calls, msec
+******************************************/
+static double time_point(const std::function<void()> &run, int drp, size_t in, size_t out, int passes, bool oca,
+						 int samples) {
+	std::vector<double> t(samples);
+	(void)drp;
+	(void)in;
+	(void)out;
+	(void)passes;
+	run();                                      /* untimed: output allocation and first-call effects */
+	for (double &v: t) {
+		uint64_t t0 = oca_stable_now_ns();
+		OCA_SIM_BEGIN();
+		run();
+		if (oca) {
+			OCA_SIM_CHARGE(drp, in, out, passes);
+		}
+		OCA_SIM_END();
+		v = (double)(oca_stable_now_ns() - t0) / 1E6;
+	}
+	std::sort(t.begin(), t.end());
+	return t[t.size() / 2];
+}
+
+/*****************************************
+* Function Name : oca_sweep_benchmark
+* Description   : time every op over the Cartesian product of its parameter grid on the CPU path and, where
+*                 the circuit supports the point, on the OCA path. Writes the latency surfaces to
+*                 OCA_SWEEP_CSV and prints per op where the speedup is largest and where it inverts.
+* Arguments     : image = FHD BGR frame
+*                 OCA_f = OCA_Activate function list
+*                 spec = grid file, nullptr for the defaults
+*                 iterations = timed calls per point and path (at least OCA_SWEEP_MIN_SAMPLES)
+*                 dir = results directory
+* Return value  : 0 on success, -1 on error
+******************************************/
+int oca_sweep_benchmark(const cv::Mat &image, unsigned long *OCA_f, const char *spec, int iterations,
+						const std::filesystem::path &dir) {
+	std::vector<sweep_op> ops = sweep_defaults();
+	const int samples = std::max(iterations, OCA_SWEEP_MIN_SAMPLES);
+	if (spec && load_spec(spec, ops) < 0) {
+		return -1;
+	}
+	std::ofstream file(dir / OCA_SWEEP_CSV);
+	if (!file.is_open()) {
+		std::cerr << "Error: Cannot write " << dir / OCA_SWEEP_CSV << std::endl;
+		return -1;
+	}
+	file << "op,drp";
+	for (const char *name: sweep_param_name) {
+		file << "," << name;
+	}
+	file << ",in_bytes,out_bytes,passes,cpu_ms,oca_ms,speedup,oca_supported\n";
+	file << std::fixed << std::setprecision(6);
+
+	printf("[SWEEP] %d samples per point and path, median\n", samples);
+	for (const sweep_op &op: ops) {
+		/* Swept parameters and the size of the product */
+		std::vector<int> axes;
+		size_t points = 1;
+		for (int p = 0; p < OCA_SWEEP_PARAM_NUM; p++) {
+			if (!op.grid[p].empty()) {
+				axes.push_back(p);
+				points *= op.grid[p].size();
+			}
+		}
+		double best = 0, worst = 1E30;
+		std::string best_at, worst_at;
+		size_t inverted = 0, unsupported = 0;
+		const oca_op_desc &desc = oca_op_table[op.id];
+		printf("[SWEEP] %s: %zu points\n", desc.name, points);
+
+		for (size_t n = 0; n < points; n++) {
+			sweep_point pt;
+			std::string label;
+			size_t rest = n;
+			std::copy(sweep_param_default, sweep_param_default + OCA_SWEEP_PARAM_NUM, pt.v);
+			for (int p: axes) {
+				pt.v[p] = op.grid[p][rest % op.grid[p].size()];
+				rest /= op.grid[p].size();
+				char buf[48];
+				snprintf(buf, sizeof(buf), "%s%s=%g", label.empty() ? "" : " ", sweep_param_name[p], pt.v[p]);
+				label += buf;
+			}
+			if (!op.grid[OCA_SWEEP_KSIZE].empty() && (int)pt.v[OCA_SWEEP_KSIZE] % 2 == 0) {
+				printf("[SWEEP]   %-40s skipped: even kernel size\n", label.c_str());
+				continue;
+			}
+
+			cv::Mat src, aux, dst;
+			size_t in = 0, out = 0;
+			int passes = 1;
+			std::function<void()> run;
+			double cpu_ms = -1, oca_ms = -1;
+			bool supported = oca_supported(op.id, pt);
+			try {
+				run = sweep_runner(op.id, pt, image, src, aux, dst, in, out, passes);
+				oca_op_activate(OCA_f, desc, OPENCVA_FUNC_DISABLE);
+				cpu_ms = time_point(run, desc.drp[0], in, out, passes, false, samples);
+				if (supported) {
+					oca_op_activate(OCA_f, desc, OPENCVA_FUNC_ENABLE);
+					oca_ms = time_point(run, desc.drp[0], in, out, passes, true, samples);
+				}
+			} catch (const cv::Exception &e) {
+				printf("[SWEEP]   %-40s rejected by OpenCV: %s\n", label.c_str(), e.what());
+				continue;
+			}
+			oca_s = dst.data ? dst.data[0] : 0;        //for suppress optimization
+
+			double speedup = oca_ms > 0 ? cpu_ms / oca_ms : 0;
+			file << desc.name << "," << desc.drp[0];
+			for (int p = 0; p < OCA_SWEEP_PARAM_NUM; p++) {
+				file << "," << pt.v[p];
+			}
+			file << "," << in << "," << out << "," << passes << "," << cpu_ms << ",";
+			if (supported) {
+				file << oca_ms << "," << speedup;
+			} else {
+				file << ",";
+			}
+			file << "," << (supported ? 1 : 0) << "\n";
+
+			if (!supported) {
+				unsupported++;
+				printf("[SWEEP]   %-40s cpu %10.3fmsec  oca not supported\n", label.c_str(), cpu_ms);
+				continue;
+			}
+			printf("[SWEEP]   %-40s cpu %10.3fmsec  oca %10.3fmsec  x%.2f%s\n", label.c_str(), cpu_ms, oca_ms,
+				   speedup, speedup < 1 ? "  (inverted)" : "");
+			inverted += (speedup < 1);
+			if (speedup > best) {
+				best = speedup;
+				best_at = label;
+			}
+			if (speedup < worst) {
+				worst = speedup;
+				worst_at = label;
+			}
+		}
+		if (!best_at.empty()) {
+			printf("[SWEEP] %s: best x%.2f at %s, worst x%.2f at %s, %zu inverted, %zu not supported\n", desc.name,
+				   best, best_at.c_str(), worst, worst_at.c_str(), inverted, unsupported);
+		}
+	}
+	printf("[SWEEP] surfaces: %s\n\n", (dir / OCA_SWEEP_CSV).c_str());
+	return file.good() ? 0 : -1;
+}
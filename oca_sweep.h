@@ -0,0 +1,41 @@
+/***********************************************************************************************************************
+* Copyright (C) 2024 Renesas Electronics Corporation. All rights reserved.
+***********************************************************************************************************************/
+/***********************************************************************************************************************
+* File Name    : oca_sweep.h
+* Version      : 1.00
+* Description  : Operator parameter sweep: CPU and OCA latency over the Cartesian product of per-op parameter grids
+***********************************************************************************************************************/
+
+#ifndef OCA_SWEEP_H
+#define OCA_SWEEP_H
+
+/*****************************************
+* Includes
+******************************************/
+#include <filesystem>
+#include <string>
+#include <opencv2/opencv.hpp>
+
+/*****************************************
+* Macros
+******************************************/
+#define OCA_SWEEP_CSV           "oca_sweep.csv"     /* written to the results directory */
+#define OCA_SWEEP_MIN_SAMPLES   (3)                 /* timed calls per point and path, median reported */
+
+/* Swept parameters */
+#define OCA_SWEEP_KSIZE         (0)                 /* kernel / block size */
+#define OCA_SWEEP_ITERATIONS    (1)                 /* morphology iterations */
+#define OCA_SWEEP_TSIZE         (2)                 /* matchTemplate template size */
+#define OCA_SWEEP_INTERP        (3)                 /* cv::InterpolationFlags */
+#define OCA_SWEEP_BORDER        (4)                 /* cv::BorderTypes */
+#define OCA_SWEEP_SCALE         (5)                 /* resize factor */
+#define OCA_SWEEP_PARAM_NUM     (6)
+
+/*****************************************
+* Functions
+******************************************/
+int oca_sweep_benchmark(const cv::Mat &image, unsigned long *OCA_f, const char *spec, int iterations,
+						const std::filesystem::path &dir);
+
+#endif
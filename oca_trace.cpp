@@ -0,0 +1,126 @@
+/***********************************************************************************************************************
+* Copyright (C) 2024 Renesas Electronics Corporation. All rights reserved.
+***********************************************************************************************************************/
+/***********************************************************************************************************************
+* File Name    : oca_trace.cpp
+* Version      : 1.00
+* Description  : Timeline tracing (built with -DOCA_TRACE=ON). Begin/end events go to per-thread lock-free rings and
+*                are dumped as Chrome trace-event JSON, loadable in Perfetto or chrome://tracing.
+***********************************************************************************************************************/
+
+/*****************************************
+* Includes
+******************************************/
+#include "define.h"
+#include "oca_trace.h"
+#include <atomic>
+#include <memory>
+#include <mutex>
+#include <sys/syscall.h>
+
+/*****************************************
+* Typedefs
+******************************************/
+/* One begin or end event */
+struct trace_event {
+	const char *name;
+	const char *cat;
+	uint64_t ts_ns;
+	char phase;
+};
+
+/* Ring of one thread. Only the owning thread writes; head is published with release
+   so the dump, which runs after the traced work, sees complete events. */
+struct trace_ring {
+	pid_t tid;
+	char thread_name[16];
+	std::atomic<uint64_t> head;
+	trace_event event[OCA_TRACE_RING_SIZE];
+};
+
+/*****************************************
+* Global Variables
+******************************************/
+static std::mutex trace_lock;                           /* only taken when a thread records its first event */
+static std::vector<std::unique_ptr<trace_ring>> trace_rings;
+static thread_local trace_ring *trace_self;
+
+/*****************************************
+* Function Name : trace_register
+* Description   : allocate and publish the ring of the calling thread
+******************************************/
+static trace_ring *trace_register() {
+	std::unique_ptr<trace_ring> ring(new trace_ring());
+	char path[64];
+	ring->tid = (pid_t)syscall(SYS_gettid);
+	snprintf(path, sizeof(path), "/proc/self/task/%d/comm", (int)ring->tid);
+	FILE *f = fopen(path, "r");
+	if (f) {
+		if (fgets(ring->thread_name, sizeof(ring->thread_name), f)) {
+			ring->thread_name[strcspn(ring->thread_name, "\n")] = '\0';
+		}
+		fclose(f);
+	}
+	std::lock_guard<std::mutex> lock(trace_lock);
+	trace_rings.push_back(std::move(ring));
+	return trace_rings.back().get();
+}
+
+/*****************************************
+* Function Name : oca_trace_event
+* Description   : record a begin ('B') or end ('E') event on the calling thread
+* Arguments     : name, cat = string literals
+*                 phase = 'B' / 'E'
+******************************************/
+void oca_trace_event(const char *name, const char *cat, char phase) {
+	struct timespec ts;
+	trace_ring *ring = trace_self;
+	if (!ring) {
+		ring = trace_self = trace_register();
+	}
+	clock_gettime(CLOCK_MONOTONIC, &ts);
+	uint64_t head = ring->head.load(std::memory_order_relaxed);
+	trace_event &e = ring->event[head & (OCA_TRACE_RING_SIZE - 1)];
+	e.name = name;
+	e.cat = cat;
+	e.ts_ns = (uint64_t)ts.tv_sec * 1000000000ull + (uint64_t)ts.tv_nsec;
+	e.phase = phase;
+	ring->head.store(head + 1, std::memory_order_release);
+}
+
+/*****************************************
+* Function Name : oca_trace_dump
+* Description   : write all rings as Chrome trace-event JSON. Call when the traced threads are idle.
+*                 Events of a wrapped ring start at the oldest retained event; an end without its begin
+*                 is dropped by the viewers.
+* Arguments     : path = output file
+* Return value  : 0 on success, -1 on error
+******************************************/
+int oca_trace_dump(const char *path) {
+	std::lock_guard<std::mutex> lock(trace_lock);
+	FILE *f = fopen(path, "w");
+	bool first = true;
+	if (!f) {
+		fprintf(stderr, "Error: Cannot write %s\n", path);
+		return -1;
+	}
+	fprintf(f, "{\"displayTimeUnit\": \"ms\", \"traceEvents\": [\n");
+	for (const std::unique_ptr<trace_ring> &ring: trace_rings) {
+		uint64_t head = ring->head.load(std::memory_order_acquire);
+		uint64_t start = head > OCA_TRACE_RING_SIZE ? head - OCA_TRACE_RING_SIZE : 0;
+		fprintf(f, "%s{\"ph\": \"M\", \"name\": \"thread_name\", \"pid\": %d, \"tid\": %d, \"args\": {\"name\": \"%s\"}}",
+				first ? "" : ",\n", (int)getpid(), (int)ring->tid, ring->thread_name);
+		first = false;
+		for (uint64_t i = start; i < head; i++) {
+			const trace_event &e = ring->event[i & (OCA_TRACE_RING_SIZE - 1)];
+			fprintf(f, ",\n{\"ph\": \"%c\", \"name\": \"%s\", \"cat\": \"%s\", \"ts\": %.3f, \"pid\": %d, \"tid\": %d}",
+					e.phase, e.name, e.cat, (double)e.ts_ns / 1E3, (int)getpid(), (int)ring->tid);
+		}
+	}
+	fprintf(f, "\n]}\n");
+	if (fclose(f) != 0) {
+		return -1;
+	}
+	printf("[TRACE] %s\n", path);
+	return 0;
+}
@@ -0,0 +1,50 @@
+/***********************************************************************************************************************
+* Copyright (C) 2024 Renesas Electronics Corporation. All rights reserved.
+***********************************************************************************************************************/
+/***********************************************************************************************************************
+* File Name    : oca_trace.h
+* Version      : 1.00
+* Description  : Timeline tracing (built with -DOCA_TRACE=ON). Begin/end events go to per-thread lock-free rings and
+*                are dumped as Chrome trace-event JSON, loadable in Perfetto or chrome://tracing.
+***********************************************************************************************************************/
+
+#ifndef OCA_TRACE_H
+#define OCA_TRACE_H
+
+/*****************************************
+* Includes
+******************************************/
+#include <stdint.h>
+
+/*****************************************
+* Macros
+******************************************/
+#define OCA_TRACE_FILE          "oca_trace.json"    /* written to the results directory */
+/* The frame ring roles run as separate processes at the same time, one file each */
+#define OCA_TRACE_PRODUCE_FILE  "oca_trace_produce.json"
+#define OCA_TRACE_CONSUME_FILE  "oca_trace_consume.json"
+#define OCA_TRACE_RING_SIZE     (16384)             /* events per thread, oldest are overwritten (power of 2) */
+
+/* Categories. Timed op calls use the path name ("cpu" / "oca" / "fix") */
+#define OCA_TRACE_CAT_ACTIVATE  "activate"
+#define OCA_TRACE_CAT_IO        "io"
+#define OCA_TRACE_CAT_INPUT     "input"
+
+/*****************************************
+* Functions
+******************************************/
+#if OCA_TRACE
+void oca_trace_event(const char *name, const char *cat, char phase);
+int oca_trace_dump(const char *path);
+
+/* name and cat must be string literals (only the pointer is recorded) */
+#define OCA_TRACE_BEGIN(name, cat)  oca_trace_event((name), (cat), 'B')
+#define OCA_TRACE_END(name, cat)    oca_trace_event((name), (cat), 'E')
+#define OCA_TRACE_DUMP(path)        oca_trace_dump(path)
+#else
+#define OCA_TRACE_BEGIN(name, cat)  do {} while (0)
+#define OCA_TRACE_END(name, cat)    do {} while (0)
+#define OCA_TRACE_DUMP(path)        do {} while (0)
+#endif
+
+#endif